@@ -1,11 +1,9 @@
 # SPDX-License-Identifier: Apache-2.0
 # SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
 
-from OCC.Core.BRep import BRep_Tool
 from OCC.Display.SimpleGui import init_display
 
-from occ_gordon import interpolate_curve_network
-from occ_gordon.occ_helpers.topology import read_brep, iter_edges
+from occ_gordon import interpolate_curve_network, read_curve_network
 
 import os
 
@@ -13,12 +11,8 @@ base_dir = os.path.dirname(os.path.abspath(__file__))
 
 # load curves from files
 print("Reading in curve network from disk")
-guides_shape = read_brep(os.path.join(base_dir, "data", "wing_guides.brep"))
-profiles_shape = read_brep(os.path.join(base_dir, "data", "wing_profiles.brep"))
-
-# Extract curves from the topods_shapes
-guide_curves = [BRep_Tool.Curve(edge)[0] for edge in iter_edges(guides_shape)]
-profile_curves = [BRep_Tool.Curve(edge)[0] for edge in iter_edges(profiles_shape)]
+profile_curves, guide_curves = read_curve_network(os.path.join(base_dir, "data", "wing_profiles.brep"),
+                                                 os.path.join(base_dir, "data", "wing_guides.brep"))
 
 # create the gordon surface
 print("Compute curve network interpolation")
@@ -4,6 +4,9 @@
 #
 
 from .interpolate_curve_network import *
+from .arrays import CurveArrays, SurfaceArrays, bspline_curve_list, surface_to_arrays, interpolate_curve_network_arrays, \
+    evaluate_surface_grid, evaluate_surface_points
+from .io import read_curve_network
 
 # Import all functions into the interpolate_curve_network package namespace
 __all__ = [
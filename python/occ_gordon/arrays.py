@@ -0,0 +1,171 @@
+# SPDX-License-Identifier: Apache-2.0
+# SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+
+"""
+NumPy interface of the curve network interpolation
+
+The curves are passed as flat arrays, which are read by the native library
+via the buffer protocol. The resulting surface is copied into NumPy arrays
+in a single native call. No pythonocc objects are created per curve or pole.
+"""
+
+from collections import namedtuple
+
+import numpy as np
+
+import occ_gordon.occ_gordon_native as occg_native
+from .interpolate_curve_network import interpolate_curve_network_options
+
+CurveArrays = namedtuple("CurveArrays", [
+    "degrees", "n_knots", "knots", "multiplicities", "n_poles", "poles", "weights", "periodic"
+], defaults=[None, None])
+CurveArrays.__doc__ = """
+Several B-spline curves stored back to back in flat arrays
+
+:param degrees: Degree of each curve (n_curves)
+:param n_knots: Number of distinct knots of each curve (n_curves)
+:param knots: Knots of all curves without repetition (sum(n_knots))
+:param multiplicities: Multiplicities of the knots (sum(n_knots))
+:param n_poles: Number of poles of each curve (n_curves)
+:param poles: Poles of all curves (sum(n_poles) x 3)
+:param weights: Optional weights of the poles (sum(n_poles))
+:param periodic: Optional periodicity flag of each curve (n_curves)
+"""
+
+SurfaceArrays = namedtuple("SurfaceArrays", [
+    "u_degree", "v_degree", "u_knots", "u_multiplicities", "v_knots", "v_multiplicities", "poles", "weights",
+    "u_periodic", "v_periodic"
+])
+SurfaceArrays.__doc__ = """
+A B-spline surface as NumPy arrays
+
+poles has the shape (n_u_poles, n_v_poles, 3), weights the shape (n_u_poles, n_v_poles).
+The weights are None for non-rational surfaces.
+"""
+
+
+def _contiguous(values, dtype):
+    return np.ascontiguousarray(values, dtype=dtype)
+
+
+def _optional(values, dtype):
+    return np.empty(0, dtype=dtype) if values is None else _contiguous(values, dtype)
+
+
+def bspline_curve_list(curves):
+    """
+    Creates a native list of B-spline curves from flat arrays
+
+    :param curves: CurveArrays
+    :return: BSplineCurveList
+    """
+
+    result = occg_native.BSplineCurveList()
+    occg_native.bspline_curves_from_buffers(result,
+                                            _contiguous(curves.degrees, np.int32),
+                                            _contiguous(curves.n_knots, np.int32),
+                                            _contiguous(curves.n_poles, np.int32),
+                                            _contiguous(curves.knots, np.float64),
+                                            _contiguous(curves.multiplicities, np.int32),
+                                            _contiguous(curves.poles, np.float64),
+                                            _optional(curves.weights, np.float64),
+                                            _optional(curves.periodic, np.uint8))
+    return result
+
+
+def surface_to_arrays(surface):
+    """
+    Copies knots, multiplicities, poles and weights of a Geom_BSplineSurface into NumPy arrays
+
+    :param surface: Geom_BSplineSurface
+    :return: SurfaceArrays
+    """
+
+    sizes = occg_native.surface_array_sizes(surface)
+
+    u_knots = np.empty(sizes.n_u_knots, dtype=np.float64)
+    u_mults = np.empty(sizes.n_u_knots, dtype=np.int32)
+    v_knots = np.empty(sizes.n_v_knots, dtype=np.float64)
+    v_mults = np.empty(sizes.n_v_knots, dtype=np.int32)
+    poles = np.empty((sizes.n_u_poles, sizes.n_v_poles, 3), dtype=np.float64)
+    weights = np.empty((sizes.n_u_poles, sizes.n_v_poles), dtype=np.float64)
+
+    occg_native.surface_to_buffers(surface, u_knots, u_mults, v_knots, v_mults, poles, weights)
+
+    return SurfaceArrays(sizes.u_degree, sizes.v_degree, u_knots, u_mults, v_knots, v_mults, poles,
+                         weights if sizes.rational else None, sizes.u_periodic, sizes.v_periodic)
+
+
+def interpolate_curve_network_arrays(profiles, guides, tolerance=1e-4, **kwargs):
+    """
+    Interpolates a network of curves given as flat arrays with a B-spline surface
+
+    This is the NumPy variant of interpolate_curve_network. The GIL is released
+    during the computation.
+
+    :param profiles: Profiles as CurveArrays
+    :param guides: Guides as CurveArrays
+    :param tolerance: Maximum allowed distance between each guide and profile
+    :param kwargs: Optional settings, see interpolate_curve_network_options
+
+    :return: The surface as SurfaceArrays
+    """
+
+    surface = occg_native.interpolate_bspline_curve_network(bspline_curve_list(profiles),
+                                                            bspline_curve_list(guides),
+                                                            tolerance,
+                                                            interpolate_curve_network_options(**kwargs))
+    return surface_to_arrays(surface)
+
+
+def _evaluate(function, surface, u, v, shape, derivatives, threads):
+    u = _contiguous(u, np.float64)
+    v = _contiguous(v, np.float64)
+
+    points = np.empty(shape + (3,), dtype=np.float64)
+    du = np.empty(shape + (3,), dtype=np.float64) if derivatives else np.empty(0, dtype=np.float64)
+    dv = np.empty(shape + (3,), dtype=np.float64) if derivatives else np.empty(0, dtype=np.float64)
+
+    function(surface, u, v, points, du, dv, threads)
+    return (points, du, dv) if derivatives else points
+
+
+def evaluate_surface_grid(surface, u, v, derivatives=False, threads=0):
+    """
+    Evaluates a Geom_BSplineSurface on the tensor grid u x v
+
+    The basis functions are computed once per grid line and the rows are
+    evaluated in parallel. The GIL is released during the evaluation.
+
+    :param surface: Geom_BSplineSurface
+    :param u: Parameters in u direction (n_u), ideally ascending
+    :param v: Parameters in v direction (n_v), ideally ascending
+    :param derivatives: If True, the first derivatives are returned as well
+    :param threads: Maximum number of threads, 0 uses all threads
+
+    :return: The points with the shape (n_u, n_v, 3) or, if derivatives is True,
+             a tuple (points, du, dv) of such arrays
+    """
+
+    return _evaluate(occg_native.evaluate_surface_grid_buffers, surface, u, v,
+                     (len(u), len(v)), derivatives, threads)
+
+
+def evaluate_surface_points(surface, u, v, derivatives=False, threads=0):
+    """
+    Evaluates a Geom_BSplineSurface at the scattered parameters (u[i], v[i])
+
+    The points are evaluated in parallel. The GIL is released during the evaluation.
+
+    :param surface: Geom_BSplineSurface
+    :param u: Parameters in u direction (n)
+    :param v: Parameters in v direction (n)
+    :param derivatives: If True, the first derivatives are returned as well
+    :param threads: Maximum number of threads, 0 uses all threads
+
+    :return: The points with the shape (n, 3) or, if derivatives is True,
+             a tuple (points, du, dv) of such arrays
+    """
+
+    return _evaluate(occg_native.evaluate_surface_points_buffers, surface, u, v,
+                     (len(u),), derivatives, threads)
@@ -18,7 +18,41 @@ def geomcurve_vector(geomcurve_list):
 
     return vec
 
-def interpolate_curve_network(profiles, guides, tolerance=1e-4):
+def interpolate_curve_network_options(**kwargs):
+    """
+    Creates the settings of the curve network interpolation
+
+    Each keyword argument sets the attribute of the same name of
+    InterpolateCurveNetworkOptions. All other attributes keep their
+    default values, which reproduce the interpolation without options.
+
+    :param min_control_points: Minimum number of control points of the reparametrized curves
+    :param max_control_points: Maximum number of control points of the reparametrized curves
+    :param min_reparametrization_samples: Minimum number of points sampled from each curve
+    :param parameter_optimization_iterations: Iterations of the parameter optimization
+    :param reparametrization_tolerance: If positive, chooses the number of control points adaptively
+                                        between min_control_points and max_control_points
+    :param exact_reparametrization: Reparametrize the curves exactly by composition
+    :param knot_removal_tolerance: If positive, removes knots from the final surface
+    :param intersection_flatness: Flatness ratio, at which the curve subdivision stops
+    :param intersection_optimizer_tolerance: Tolerance of the intersection refinement
+    :param intersection_optimizer_iterations: Maximum iterations of the intersection refinement
+    :param threads: Maximum number of threads, a value <= 0 uses all threads
+    :param block_size: If positive, splits large networks into blocks of at most this number of curves
+    :param block_overlap: Number of curves, by which the blocks overlap on each side
+
+    :return: InterpolateCurveNetworkOptions
+    """
+
+    options = occg_native.InterpolateCurveNetworkOptions()
+    for name, value in kwargs.items():
+        if name.startswith('_') or not hasattr(options, name):
+            raise TypeError("Unknown option '{}' of interpolate_curve_network".format(name))
+        setattr(options, name, value)
+
+    return options
+
+def interpolate_curve_network(profiles, guides, tolerance=1e-4, **kwargs):
     """
     Interpolates a network of curves with a B-spline surface.
     Internally, this is done with a Gordon surface.
@@ -28,13 +62,124 @@ def interpolate_curve_network(profiles, guides, tolerance=1e-4):
     Here, we overcome this limitation by re-parametrization of the
     input curves.
 
-    :param profiles: List of profiles (List of Geom_Curves)
-    :param guides: List of guides (List of Geom_Curves)
+    The GIL is released during the computation. Hence, several surfaces
+    can be computed in parallel from python threads, e.g. with a
+    concurrent.futures.ThreadPoolExecutor.
+
+    :param profiles: List of profiles (List of Geom_Curves or a BSplineCurveList, see read_curve_network)
+    :param guides: List of guides (List of Geom_Curves or a BSplineCurveList)
     :param tolerance: Maximum allowed distance between each guide and profile
                      (in theory they must intersect and the distance is zero)
+    :param kwargs: Optional settings to trade computation time against accuracy,
+                   e.g. max_control_points=40 or threads=4.
+                   See interpolate_curve_network_options for all settings.
 
     :return: The final surface (Geom_BSplineSurface)
     """
+    if isinstance(profiles, occg_native.BSplineCurveList) and isinstance(guides, occg_native.BSplineCurveList):
+        return occg_native.interpolate_bspline_curve_network(profiles, guides, tolerance,
+                                                             interpolate_curve_network_options(**kwargs))
+
+    if not kwargs:
+        return occg_native.interpolate_curve_network(geomcurve_vector(profiles),
+                                                geomcurve_vector(guides),
+                                                tolerance)
+
     return occg_native.interpolate_curve_network(geomcurve_vector(profiles),
                                             geomcurve_vector(guides),
-                                            tolerance)
+                                            tolerance,
+                                            interpolate_curve_network_options(**kwargs))
+
+
+def interpolate_curve_network_deviations(profiles, guides, tolerance=1e-4, **kwargs):
+    """
+    Interpolates a network of curves and computes the deviations of the curves from the surface
+
+    Each profile lies on an iso-curve v = const and each guide on an iso-curve u = const
+    of the surface. The curves and the surface are evaluated at corresponding parameters,
+    which are known from the reparametrization. No point projection is required.
+
+    :param profiles: List of profiles (List of Geom_Curves or a BSplineCurveList)
+    :param guides: List of guides (List of Geom_Curves or a BSplineCurveList)
+    :param tolerance: Maximum allowed distance between each guide and profile
+    :param kwargs: Optional settings, see interpolate_curve_network_options.
+                   deviation_samples sets the number of points per curve (default: 101).
+
+    :return: Tuple (surface, deviations). deviations.profiles and deviations.guides hold the
+             index of the input curve, the iso-curve parameter, max_deviation and rms_deviation
+             of each curve.
+    """
+
+    deviations = occg_native.CurveNetworkDeviations()
+    options = interpolate_curve_network_options(**kwargs)
+    if isinstance(profiles, occg_native.BSplineCurveList) and isinstance(guides, occg_native.BSplineCurveList):
+        surface = occg_native.interpolate_bspline_curve_network_deviations(profiles, guides, tolerance, options,
+                                                                           deviations)
+    else:
+        surface = occg_native.interpolate_curve_network(geomcurve_vector(profiles), geomcurve_vector(guides),
+                                                        tolerance, options, deviations)
+    return surface, deviations
+
+
+def interpolate_curve_network_patches(profiles, guides, tolerance=1e-4, block_size=32, **kwargs):
+    """
+    Interpolates a large network of curves by a grid of patches
+
+    The network is split into overlapping blocks of at most block_size curves per
+    direction. The blocks are interpolated in parallel and the patches join with
+    C1 continuity, or C0 where C1 would exceed the tolerance. interpolate_curve_network(..., block_size=...) merges the same
+    patches into a single surface. Closed networks are not supported.
+
+    :param profiles: List of profiles (List of Geom_Curves or a BSplineCurveList)
+    :param guides: List of guides (List of Geom_Curves or a BSplineCurveList)
+    :param tolerance: Maximum allowed distance between each guide and profile
+    :param block_size: Maximum number of profiles and guides per block
+    :param kwargs: Optional settings, see interpolate_curve_network_options
+
+    :return: The patches (Geom_BSplineSurface) as nested lists, patch (i, j) is patches[i][j],
+             where i counts the patches in u and j in v direction
+    """
+
+    options = interpolate_curve_network_options(block_size=block_size, **kwargs)
+    if isinstance(profiles, occg_native.BSplineCurveList) and isinstance(guides, occg_native.BSplineCurveList):
+        result = occg_native.interpolate_bspline_curve_network_patches(profiles, guides, tolerance, options)
+    else:
+        result = occg_native.interpolate_curve_network_patches(geomcurve_vector(profiles), geomcurve_vector(guides),
+                                                               tolerance, options)
+
+    return [[result.patches[i * result.n_v + j] for j in range(result.n_v)] for i in range(result.n_u)]
+
+
+def classify_curve_network(curves, tolerance=1e-4):
+    """
+    Splits a list of curves into the profiles and guides of a curve network
+
+    Curves of the same family must not intersect. The family of the first
+    curve is returned as the profiles.
+
+    :param curves: Profiles and guides in arbitrary order (List of Geom_Curves)
+    :param tolerance: Maximum allowed distance between each guide and profile
+    :return: Tuple (profiles, guides) of BSplineCurveLists
+    """
+
+    profiles = occg_native.BSplineCurveList()
+    guides = occg_native.BSplineCurveList()
+    occg_native.classify_curve_network_into(geomcurve_vector(curves), tolerance, profiles, guides)
+    return profiles, guides
+
+
+def interpolate_mixed_curve_network(curves, tolerance=1e-4, **kwargs):
+    """
+    Interpolates a curve network, whose profiles and guides are given in a single list
+
+    The curves are split into profiles and guides by classify_curve_network.
+
+    :param curves: Profiles and guides in arbitrary order (List of Geom_Curves)
+    :param tolerance: Maximum allowed distance between each guide and profile
+    :param kwargs: Optional settings, see interpolate_curve_network_options
+
+    :return: The final surface (Geom_BSplineSurface)
+    """
+
+    return occg_native.interpolate_mixed_curve_network(geomcurve_vector(curves), tolerance,
+                                                       interpolate_curve_network_options(**kwargs))
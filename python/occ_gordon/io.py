@@ -0,0 +1,30 @@
+# SPDX-License-Identifier: Apache-2.0
+# SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+
+"""
+Reading of curve networks
+
+The BRep files are read and the edge curves are extracted by the native
+library in a single call, instead of one python round trip per edge.
+"""
+
+import occ_gordon.occ_gordon_native as occg_native
+
+
+def read_curve_network(profiles_path, guides_path):
+    """
+    Reads the profiles and guides of a curve network from two BRep files
+
+    Both files are read in parallel. The edge curves are trimmed to the edges
+    and converted into B-splines. The GIL is released while reading.
+
+    :param profiles_path: BRep file with the profiles
+    :param guides_path: BRep file with the guides
+    :return: Tuple (profiles, guides) of BSplineCurveLists, which can be passed
+             directly to interpolate_curve_network
+    """
+
+    profiles = occg_native.BSplineCurveList()
+    guides = occg_native.BSplineCurveList()
+    occg_native.read_curve_network_into(profiles_path, guides_path, profiles, guides)
+    return profiles, guides
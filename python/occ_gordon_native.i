@@ -5,7 +5,27 @@
 * Created: 2015-11-23 Martin Siggel <Martin.Siggel@dlr.de>
 */
 
-%module (package="occ_gordon") occ_gordon_native
+// The interpolation and IO wrappers release the GIL around the native calls, such that
+// python threads can compute several surfaces in parallel. This is safe, as the library
+// only reads the input curves and copies them before the computation. The reference
+// counters of the OCCT handles are atomic.
+// The surface evaluators release the GIL as well. They are only called from arrays.py,
+// which allocates the result arrays itself and keeps all arrays referenced during the call.
+// All other wrappers are short and keep the GIL, which avoids the overhead of releasing
+// and acquiring it for each call and keeps the python buffers locked while in use.
+%module (package="occ_gordon", threads="1") occ_gordon_native
+
+%nothread;
+%thread occ_gordon::interpolate_curve_network;
+%thread occ_gordon::interpolate_curve_network_patches;
+%thread occ_gordon::interpolate_mixed_curve_network;
+%thread occ_gordon::interpolate_bspline_curve_network;
+%thread occ_gordon::interpolate_bspline_curve_network_deviations;
+%thread occ_gordon::interpolate_bspline_curve_network_patches;
+%thread occ_gordon::read_curve_network_into;
+%thread occ_gordon::classify_curve_network_into;
+%thread occ_gordon::evaluate_surface_grid_buffers;
+%thread occ_gordon::evaluate_surface_points_buffers;
 
 %include common.i
 
@@ -21,6 +41,9 @@
 
 %{
 #include <occ_gordon/occ_gordon.h>
+#include <occ_gordon/arrays.h>
+#include <occ_gordon/io.h>
+#include <occ_gordon/evaluator.h>
 %}
 
 %feature("autodoc", "3");
@@ -29,7 +52,227 @@
 
 %template(CurveList) std::vector<Handle(Geom_Curve)>;
 
+// std::future cannot be wrapped. Use a python thread pool instead.
+%ignore occ_gordon::interpolate_curve_network_async;
+%ignore occ_gordon::interpolate_curve_network(const std::vector<Handle(Geom_BSplineCurve)>&,
+                                              const std::vector<Handle(Geom_BSplineCurve)>&,
+                                              double,
+                                              const occ_gordon::InterpolateCurveNetworkOptions&,
+                                              occ_gordon::ProgressCallback,
+                                              occ_gordon::CancellationToken);
+%ignore occ_gordon::cancelled_error;
+
+// the curve lists of a network are filled by the *_into functions below
+%ignore occ_gordon::CurveNetwork;
+%ignore occ_gordon::classify_curve_network;
+
+namespace occ_gordon { struct CurveDeviation; }
+%template(CurveDeviationList) std::vector<occ_gordon::CurveDeviation>;
+%template(BSplineSurfaceList) std::vector<Handle(Geom_BSplineSurface)>;
+%template(IntList) std::vector<int>;
+
 %include "occ_gordon/occ_gordon.h"
 
+// Flat array interface, used by the numpy functions in arrays.py.
+// The buffers are passed via the python buffer protocol without copying.
+%include <stdint.i>
+%include <pybuffer.i>
+
+%template(BSplineCurveList) std::vector<Handle(Geom_BSplineCurve)>;
+
+// the raw pointer functions are replaced by the buffer based functions below
+%ignore occ_gordon::BSplineCurveArrays;
+%ignore occ_gordon::to_bspline_curves;
+%ignore occ_gordon::copy_surface_arrays;
+
+%include "occ_gordon/arrays.h"
+
+%pybuffer_binary(const std::int32_t* degrees, size_t n_degrees);
+%pybuffer_binary(const std::int32_t* n_knots, size_t n_n_knots);
+%pybuffer_binary(const std::int32_t* n_poles, size_t n_n_poles);
+%pybuffer_binary(const double* knots, size_t n_knot_values);
+%pybuffer_binary(const std::int32_t* multiplicities, size_t n_multiplicities);
+%pybuffer_binary(const double* poles, size_t n_pole_values);
+%pybuffer_binary(const double* weights, size_t n_weights);
+%pybuffer_binary(const std::uint8_t* periodic, size_t n_periodic);
+
+%pybuffer_mutable_binary(double* u_knots, size_t n_u_knots);
+%pybuffer_mutable_binary(std::int32_t* u_multiplicities, size_t n_u_multiplicities);
+%pybuffer_mutable_binary(double* v_knots, size_t n_v_knots);
+%pybuffer_mutable_binary(std::int32_t* v_multiplicities, size_t n_v_multiplicities);
+%pybuffer_mutable_binary(double* surface_poles, size_t n_surface_pole_values);
+%pybuffer_mutable_binary(double* surface_weights, size_t n_surface_weights);
+
+%pybuffer_binary(const double* u_params, size_t n_u_params);
+%pybuffer_binary(const double* v_params, size_t n_v_params);
+%pybuffer_mutable_binary(double* eval_points, size_t n_eval_points);
+%pybuffer_mutable_binary(double* eval_du, size_t n_eval_du);
+%pybuffer_mutable_binary(double* eval_dv, size_t n_eval_dv);
+
+%inline %{
+namespace occ_gordon
+{
+
+/// Fills curves with the B-splines stored in the buffers. weights and periodic may be empty
+void bspline_curves_from_buffers(std::vector<Handle(Geom_BSplineCurve)>& curves,
+                                 const std::int32_t* degrees, size_t n_degrees,
+                                 const std::int32_t* n_knots, size_t n_n_knots,
+                                 const std::int32_t* n_poles, size_t n_n_poles,
+                                 const double* knots, size_t n_knot_values,
+                                 const std::int32_t* multiplicities, size_t n_multiplicities,
+                                 const double* poles, size_t n_pole_values,
+                                 const double* weights, size_t n_weights,
+                                 const std::uint8_t* periodic, size_t n_periodic)
+{
+    if (n_n_knots != n_degrees || n_n_poles != n_degrees || (n_periodic != 0 && n_periodic != n_degrees)) {
+        throw std::invalid_argument("degrees, n_knots, n_poles and periodic must have one value per curve");
+    }
+
+    size_t total_knots = 0, total_poles = 0;
+    for (size_t i = 0; i < n_degrees; ++i) {
+        if (n_knots[i] < 0 || n_poles[i] < 0) {
+            throw std::invalid_argument("negative number of knots or poles");
+        }
+        total_knots += static_cast<size_t>(n_knots[i]);
+        total_poles += static_cast<size_t>(n_poles[i]);
+    }
+
+    if (n_knot_values != total_knots || n_multiplicities != total_knots) {
+        throw std::invalid_argument("knots and multiplicities must have sum(n_knots) values");
+    }
+    if (n_pole_values != 3 * total_poles) {
+        throw std::invalid_argument("poles must have 3 * sum(n_poles) values");
+    }
+    if (n_weights != 0 && n_weights != total_poles) {
+        throw std::invalid_argument("weights must be empty or have sum(n_poles) values");
+    }
+
+    occ_gordon::BSplineCurveArrays arrays;
+    arrays.n_curves = n_degrees;
+    arrays.degrees = degrees;
+    arrays.n_knots = n_knots;
+    arrays.n_poles = n_poles;
+    arrays.knots = knots;
+    arrays.multiplicities = multiplicities;
+    arrays.poles = poles;
+    arrays.weights = n_weights > 0 ? weights : nullptr;
+    arrays.periodic = n_periodic > 0 ? periodic : nullptr;
+
+    curves = occ_gordon::to_bspline_curves(arrays);
+}
+
+/// Copies the surface into the buffers, which must have the sizes given by surface_array_sizes
+void surface_to_buffers(const Handle(Geom_BSplineSurface)& surface,
+                        double* u_knots, size_t n_u_knots,
+                        std::int32_t* u_multiplicities, size_t n_u_multiplicities,
+                        double* v_knots, size_t n_v_knots,
+                        std::int32_t* v_multiplicities, size_t n_v_multiplicities,
+                        double* surface_poles, size_t n_surface_pole_values,
+                        double* surface_weights, size_t n_surface_weights)
+{
+    const occ_gordon::BSplineSurfaceArraySizes sizes = occ_gordon::surface_array_sizes(surface);
+    const size_t n_poles = sizes.n_u_poles * sizes.n_v_poles;
+    if (n_u_knots != sizes.n_u_knots || n_u_multiplicities != sizes.n_u_knots ||
+        n_v_knots != sizes.n_v_knots || n_v_multiplicities != sizes.n_v_knots ||
+        n_surface_pole_values != 3 * n_poles || n_surface_weights != n_poles) {
+        throw std::invalid_argument("The buffer sizes don't match the surface");
+    }
+
+    occ_gordon::copy_surface_arrays(surface, u_knots, u_multiplicities, v_knots, v_multiplicities,
+                                    surface_poles, surface_weights);
+}
+
+/// Reads the curve network of two BRep files into profiles and guides
+void read_curve_network_into(const std::string& profiles_path, const std::string& guides_path,
+                             std::vector<Handle(Geom_BSplineCurve)>& profiles,
+                             std::vector<Handle(Geom_BSplineCurve)>& guides)
+{
+    occ_gordon::CurveNetwork network = occ_gordon::read_curve_network(profiles_path, guides_path);
+    profiles = std::move(network.profiles);
+    guides = std::move(network.guides);
+}
+
+/// Splits the curves into profiles and guides
+void classify_curve_network_into(const std::vector<Handle(Geom_Curve)>& curves, double tolerance,
+                                 std::vector<Handle(Geom_BSplineCurve)>& profiles,
+                                 std::vector<Handle(Geom_BSplineCurve)>& guides)
+{
+    occ_gordon::CurveNetwork network = occ_gordon::classify_curve_network(curves, tolerance);
+    profiles = std::move(network.profiles);
+    guides = std::move(network.guides);
+}
+
+/// Evaluates the surface on the grid u x v. du and dv may be empty
+void evaluate_surface_grid_buffers(const Handle(Geom_BSplineSurface)& surface,
+                                   const double* u_params, size_t n_u_params,
+                                   const double* v_params, size_t n_v_params,
+                                   double* eval_points, size_t n_eval_points,
+                                   double* eval_du, size_t n_eval_du,
+                                   double* eval_dv, size_t n_eval_dv,
+                                   int threads)
+{
+    const size_t n = 3 * n_u_params * n_v_params;
+    if (n_eval_points != n || (n_eval_du != 0 && n_eval_du != n) || (n_eval_dv != 0 && n_eval_dv != n)) {
+        throw std::invalid_argument("The result buffers must have 3 * len(u) * len(v) values");
+    }
+
+    occ_gordon::SurfaceEvaluator evaluator(surface);
+    evaluator.evaluate_grid(u_params, n_u_params, v_params, n_v_params, eval_points,
+                            n_eval_du > 0 ? eval_du : nullptr, n_eval_dv > 0 ? eval_dv : nullptr, threads);
+}
+
+/// Evaluates the surface at the parameters (u[i], v[i]). du and dv may be empty
+void evaluate_surface_points_buffers(const Handle(Geom_BSplineSurface)& surface,
+                                     const double* u_params, size_t n_u_params,
+                                     const double* v_params, size_t n_v_params,
+                                     double* eval_points, size_t n_eval_points,
+                                     double* eval_du, size_t n_eval_du,
+                                     double* eval_dv, size_t n_eval_dv,
+                                     int threads)
+{
+    const size_t n = 3 * n_u_params;
+    if (n_v_params != n_u_params) {
+        throw std::invalid_argument("u and v must have the same length");
+    }
+    if (n_eval_points != n || (n_eval_du != 0 && n_eval_du != n) || (n_eval_dv != 0 && n_eval_dv != n)) {
+        throw std::invalid_argument("The result buffers must have 3 * len(u) values");
+    }
+
+    occ_gordon::SurfaceEvaluator evaluator(surface);
+    evaluator.evaluate_points(u_params, v_params, n_u_params, eval_points,
+                              n_eval_du > 0 ? eval_du : nullptr, n_eval_dv > 0 ? eval_dv : nullptr, threads);
+}
+
+/// Interpolates B-spline curves without the overload resolution of interpolate_curve_network
+Handle(Geom_BSplineSurface) interpolate_bspline_curve_network(const std::vector<Handle(Geom_BSplineCurve)>& profiles,
+                                                              const std::vector<Handle(Geom_BSplineCurve)>& guides,
+                                                              double tolerance,
+                                                              const occ_gordon::InterpolateCurveNetworkOptions& options)
+{
+    return occ_gordon::interpolate_curve_network(profiles, guides, tolerance, options);
+}
+
+/// Interpolates B-spline curves and computes the deviations of the curves from the surface
+Handle(Geom_BSplineSurface) interpolate_bspline_curve_network_deviations(const std::vector<Handle(Geom_BSplineCurve)>& profiles,
+                                                                         const std::vector<Handle(Geom_BSplineCurve)>& guides,
+                                                                         double tolerance,
+                                                                         const occ_gordon::InterpolateCurveNetworkOptions& options,
+                                                                         occ_gordon::CurveNetworkDeviations& deviations)
+{
+    return occ_gordon::interpolate_curve_network(profiles, guides, tolerance, options, deviations);
+}
+
+/// Interpolates B-spline curves by a grid of patches
+occ_gordon::SurfacePatches interpolate_bspline_curve_network_patches(const std::vector<Handle(Geom_BSplineCurve)>& profiles,
+                                                                     const std::vector<Handle(Geom_BSplineCurve)>& guides,
+                                                                     double tolerance,
+                                                                     const occ_gordon::InterpolateCurveNetworkOptions& options)
+{
+    return occ_gordon::interpolate_curve_network_patches(profiles, guides, tolerance, options);
+}
+
+} // namespace occ_gordon
+%}
+
 
 
@@ -0,0 +1,113 @@
+#
+# SPDX-License-Identifier: Apache-2.0
+# SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+#
+
+"""
+Checks the NumPy interface against the pythonocc based interpolation.
+
+Run with: python -m unittest discover -s python/tests
+"""
+
+import os
+import unittest
+
+import numpy as np
+from OCC.Core.BRep import BRep_Tool
+from OCC.Core.GeomConvert import geomconvert
+from OCC.Core.gp import gp_Pnt, gp_Vec
+
+from occ_gordon import CurveArrays, interpolate_curve_network, interpolate_curve_network_arrays, surface_to_arrays, \
+    evaluate_surface_grid, evaluate_surface_points
+from occ_gordon.occ_helpers.topology import read_brep, iter_edges
+
+DATA_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "examples", "data")
+
+
+def read_curves(filename):
+    shape = read_brep(os.path.join(DATA_DIR, filename))
+    return [BRep_Tool.Curve(edge)[0] for edge in iter_edges(shape)]
+
+
+def to_arrays(curves):
+    """Packs the curves into flat arrays, as an array based application would store them"""
+    bsplines = [geomconvert.CurveToBSplineCurve(curve) for curve in curves]
+    knots = [[c.Knot(i) for i in range(1, c.NbKnots() + 1)] for c in bsplines]
+    mults = [[c.Multiplicity(i) for i in range(1, c.NbKnots() + 1)] for c in bsplines]
+    poles = [[c.Pole(i).Coord() for i in range(1, c.NbPoles() + 1)] for c in bsplines]
+    weights = [[c.Weight(i) for i in range(1, c.NbPoles() + 1)] for c in bsplines]
+    rational = any(c.IsRational() for c in bsplines)
+
+    return CurveArrays(degrees=np.array([c.Degree() for c in bsplines]),
+                       n_knots=np.array([len(k) for k in knots]),
+                       knots=np.concatenate(knots),
+                       multiplicities=np.concatenate(mults),
+                       n_poles=np.array([len(p) for p in poles]),
+                       poles=np.concatenate(poles),
+                       weights=np.concatenate(weights) if rational else None,
+                       periodic=np.array([c.IsPeriodic() for c in bsplines]))
+
+
+class TestArrays(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        cls.profiles = read_curves("wing_profiles.brep")
+        cls.guides = read_curves("wing_guides.brep")
+
+    def test_interpolate_arrays(self):
+        reference = interpolate_curve_network(self.profiles, self.guides, 1.e-5)
+        result = interpolate_curve_network_arrays(to_arrays(self.profiles), to_arrays(self.guides), 1.e-5)
+
+        self.assertEqual(reference.UDegree(), result.u_degree)
+        self.assertEqual(reference.VDegree(), result.v_degree)
+        self.assertEqual((reference.NbUPoles(), reference.NbVPoles(), 3), result.poles.shape)
+        self.assertEqual(reference.NbUKnots(), len(result.u_knots))
+        self.assertEqual(reference.NbVKnots(), len(result.v_knots))
+        self.assertEqual(sum(result.u_multiplicities), reference.NbUPoles() + reference.UDegree() + 1)
+
+        for i in range(reference.NbUPoles()):
+            for j in range(reference.NbVPoles()):
+                np.testing.assert_allclose(reference.Pole(i + 1, j + 1).Coord(), result.poles[i, j], atol=1e-10)
+
+    def test_surface_to_arrays(self):
+        surface = interpolate_curve_network(self.profiles, self.guides, 1.e-5)
+        arrays = surface_to_arrays(surface)
+
+        self.assertEqual(surface.UKnot(2), arrays.u_knots[1])
+        self.assertEqual(surface.VMultiplicity(1), arrays.v_multiplicities[0])
+        np.testing.assert_array_equal(surface.Pole(2, 3).Coord(), arrays.poles[1, 2])
+
+    def test_invalid_sizes(self):
+        profiles = to_arrays(self.profiles)
+        broken = profiles._replace(knots=profiles.knots[:-1])
+        with self.assertRaises(RuntimeError):
+            interpolate_curve_network_arrays(broken, to_arrays(self.guides), 1.e-5)
+
+    def test_evaluate_grid(self):
+        surface = interpolate_curve_network(self.profiles, self.guides, 1.e-5)
+        u0, u1, v0, v1 = surface.Bounds()
+        u = np.linspace(u0, u1, 23)
+        v = np.linspace(v0, v1, 17)
+
+        points, du, dv = evaluate_surface_grid(surface, u, v, derivatives=True)
+        self.assertEqual((23, 17, 3), points.shape)
+
+        for i in (0, 5, 22):
+            for j in (0, 8, 16):
+                p, pu, pv = gp_Pnt(), gp_Vec(), gp_Vec()
+                surface.D1(u[i], v[j], p, pu, pv)
+                np.testing.assert_allclose(p.Coord(), points[i, j], atol=1e-10)
+                np.testing.assert_allclose(pu.Coord(), du[i, j], atol=1e-8 * (1. + pu.Magnitude()))
+                np.testing.assert_allclose(pv.Coord(), dv[i, j], atol=1e-8 * (1. + pv.Magnitude()))
+
+        scattered = evaluate_surface_points(surface, u[[3, 7]], v[[2, 9]])
+        np.testing.assert_allclose(points[3, 2], scattered[0], atol=1e-12)
+        np.testing.assert_allclose(points[7, 9], scattered[1], atol=1e-12)
+
+        with self.assertRaises(RuntimeError):
+            evaluate_surface_points(surface, u, v)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,65 @@
+#
+# SPDX-License-Identifier: Apache-2.0
+# SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+#
+
+"""
+Checks the native reading of curve networks against pythonocc.
+
+Run with: python -m unittest discover -s python/tests
+"""
+
+import os
+import unittest
+
+from OCC.Core.BRep import BRep_Tool
+
+from occ_gordon import interpolate_curve_network, interpolate_curve_network_deviations, read_curve_network
+from occ_gordon.occ_helpers.topology import read_brep, iter_edges
+
+DATA_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "examples", "data")
+
+
+def read_curves(filename):
+    shape = read_brep(os.path.join(DATA_DIR, filename))
+    return [BRep_Tool.Curve(edge)[0] for edge in iter_edges(shape)]
+
+
+class TestReadCurveNetwork(unittest.TestCase):
+
+    def test_same_surface(self):
+        profiles, guides = read_curve_network(os.path.join(DATA_DIR, "wing_profiles.brep"),
+                                              os.path.join(DATA_DIR, "wing_guides.brep"))
+
+        reference_profiles = read_curves("wing_profiles.brep")
+        reference_guides = read_curves("wing_guides.brep")
+        self.assertEqual(len(reference_profiles), len(profiles))
+        self.assertEqual(len(reference_guides), len(guides))
+
+        reference = interpolate_curve_network(reference_profiles, reference_guides, 1.e-5)
+        surface = interpolate_curve_network(profiles, guides, 1.e-5)
+        self.assertEqual(reference.NbUPoles(), surface.NbUPoles())
+        self.assertEqual(reference.NbVPoles(), surface.NbVPoles())
+        self.assertAlmostEqual(0., reference.Value(0.5, 0.5).Distance(surface.Value(0.5, 0.5)), places=8)
+
+    def test_deviations(self):
+        profiles, guides = read_curve_network(os.path.join(DATA_DIR, "wing_profiles.brep"),
+                                              os.path.join(DATA_DIR, "wing_guides.brep"))
+        _, native = interpolate_curve_network_deviations(profiles, guides, 1.e-5)
+        _, pythonocc = interpolate_curve_network_deviations(read_curves("wing_profiles.brep"),
+                                                            read_curves("wing_guides.brep"), 1.e-5)
+
+        self.assertGreaterEqual(len(native.profiles), len(profiles))
+        self.assertGreaterEqual(len(native.guides), len(guides))
+        for deviation in native.profiles:
+            self.assertLess(deviation.index, len(profiles))
+            self.assertLessEqual(deviation.rms_deviation, deviation.max_deviation)
+        self.assertAlmostEqual(native.max_deviation(), pythonocc.max_deviation(), places=6)
+
+    def test_missing_file(self):
+        with self.assertRaises(RuntimeError):
+            read_curve_network(os.path.join(DATA_DIR, "wing_profiles.brep"), os.path.join(DATA_DIR, "missing.brep"))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,80 @@
+#
+# SPDX-License-Identifier: Apache-2.0
+# SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+#
+
+"""
+Checks, that the native interpolation releases the GIL, such that
+python threads make progress while a surface is computed.
+
+Run with: python -m unittest discover -s python/tests
+"""
+
+import os
+import threading
+import time
+import unittest
+from concurrent.futures import ThreadPoolExecutor
+
+from OCC.Core.BRep import BRep_Tool
+
+from occ_gordon import interpolate_curve_network
+from occ_gordon.occ_helpers.topology import read_brep, iter_edges
+
+DATA_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "examples", "data")
+
+
+def read_curves(filename):
+    shape = read_brep(os.path.join(DATA_DIR, filename))
+    return [BRep_Tool.Curve(edge)[0] for edge in iter_edges(shape)]
+
+
+class TestThreading(unittest.TestCase):
+
+    @classmethod
+    def setUpClass(cls):
+        cls.profiles = read_curves("wing_profiles.brep")
+        cls.guides = read_curves("wing_guides.brep")
+
+    def build(self):
+        # one thread per network, so that only the python threads run in parallel
+        return interpolate_curve_network(self.profiles, self.guides, 1.e-5, threads=1)
+
+    def test_shared_curves_from_threads(self):
+        reference = self.build()
+
+        with ThreadPoolExecutor(max_workers=4) as executor:
+            surfaces = list(executor.map(lambda _: self.build(), range(8)))
+
+        for surface in surfaces:
+            self.assertEqual(reference.NbUPoles(), surface.NbUPoles())
+            self.assertEqual(reference.NbVPoles(), surface.NbVPoles())
+            self.assertAlmostEqual(0., reference.Value(0.5, 0.5).Distance(surface.Value(0.5, 0.5)), places=10)
+
+    def test_releases_gil(self):
+        started = threading.Event()
+        done = threading.Event()
+
+        def worker():
+            started.set()
+            self.build()
+            done.set()
+
+        thread = threading.Thread(target=worker)
+        thread.start()
+        started.wait()
+
+        # Count, how often this thread runs while the other thread is inside the native call.
+        # Each tick sleeps, such that the worker gets the GIL back immediately after the call.
+        # With the GIL held during the computation, this thread would not run at all.
+        ticks = 0
+        while not done.is_set():
+            ticks += 1
+            time.sleep(1.e-4)
+        thread.join()
+
+        self.assertGreater(ticks, 10)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,141 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+#include "ApproxSystemCache.h"
+
+#include <functional>
+
+namespace
+{
+
+inline void hashCombine(size_t& seed, size_t value)
+{
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+inline size_t hashDouble(double value)
+{
+    // normalize -0.0, such that equal values have equal hashes
+    if (value == 0.) {
+        value = 0.;
+    }
+    return std::hash<double>()(value);
+}
+
+} // namespace
+
+namespace occ_gordon_internal
+{
+
+bool ApproxSystemKey::operator==(const ApproxSystemKey& other) const
+{
+    return degree == other.degree &&
+           nContinuityConditions == other.nContinuityConditions &&
+           flatKnots == other.flatKnots &&
+           params == other.params &&
+           interpolatedIndices == other.interpolatedIndices;
+}
+
+size_t ApproxSystemKey::Hash() const
+{
+    size_t seed = 0;
+    hashCombine(seed, std::hash<int>()(degree));
+    hashCombine(seed, std::hash<int>()(nContinuityConditions));
+    for (double knot : flatKnots) {
+        hashCombine(seed, hashDouble(knot));
+    }
+    for (double param : params) {
+        hashCombine(seed, hashDouble(param));
+    }
+    for (size_t idx : interpolatedIndices) {
+        hashCombine(seed, std::hash<size_t>()(idx));
+    }
+    return seed;
+}
+
+ApproxSystem::ApproxSystem(const math_Matrix& lhs, std::unique_ptr<math_Matrix> transposedBasis)
+    : solver(lhs)
+    , At(std::move(transposedBasis))
+{
+}
+
+ApproxSystemCache::ApproxSystemCache(size_t maxEntries)
+    : m_maxEntries(maxEntries > 0 ? maxEntries : 1)
+    , m_hits(0)
+    , m_misses(0)
+{
+}
+
+std::shared_ptr<const ApproxSystem> ApproxSystemCache::findUnlocked(size_t hash, const ApproxSystemKey& key) const
+{
+    for (const Entry& entry : m_entries) {
+        if (entry.hash == hash && entry.key == key) {
+            return entry.system;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<const ApproxSystem> ApproxSystemCache::Find(const ApproxSystemKey& key) const
+{
+    size_t hash = key.Hash();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_ptr<const ApproxSystem> system = findUnlocked(hash, key);
+    if (system) {
+        m_hits++;
+    }
+    else {
+        m_misses++;
+    }
+    return system;
+}
+
+void ApproxSystemCache::Insert(const ApproxSystemKey& key, std::shared_ptr<const ApproxSystem> system)
+{
+    if (!system) {
+        return;
+    }
+
+    size_t hash = key.Hash();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (findUnlocked(hash, key)) {
+        return;
+    }
+
+    if (m_entries.size() >= m_maxEntries) {
+        m_entries.pop_front();
+    }
+    m_entries.push_back(Entry{hash, key, std::move(system)});
+}
+
+void ApproxSystemCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_hits = 0;
+    m_misses = 0;
+}
+
+size_t ApproxSystemCache::Size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+size_t ApproxSystemCache::Hits() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+size_t ApproxSystemCache::Misses() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
+
+} // namespace occ_gordon_internal
@@ -0,0 +1,110 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+#ifndef APPROXSYSTEMCACHE_H
+#define APPROXSYSTEMCACHE_H
+
+#include "LinearAlgebra.h"
+
+#include <math_Matrix.hxx>
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace occ_gordon_internal
+{
+
+/**
+ * @brief Identifies the linear system of BSplineApproxInterp
+ *
+ * The system matrix of the constrained least squares problem only depends on
+ * the structure of the fit (degree, knots, parameters, interpolated points,
+ * closing conditions), but not on the coordinates of the points to be fitted.
+ */
+struct ApproxSystemKey
+{
+    int degree = 0;
+    int nContinuityConditions = 0;
+    std::vector<double> flatKnots;
+    std::vector<double> params;
+    std::vector<size_t> interpolatedIndices;
+
+    bool operator==(const ApproxSystemKey& other) const;
+
+    /// Hash value, that is used to speed up the lookup
+    size_t Hash() const;
+};
+
+/**
+ * @brief Factorized system matrix of BSplineApproxInterp
+ *
+ * Solving for new point coordinates only requires the computation
+ * of the right hand side and a back-substitution.
+ */
+struct ApproxSystem
+{
+    ApproxSystem(const math_Matrix& lhs, std::unique_ptr<math_Matrix> transposedBasis);
+
+    /// LU decomposition of the left hand side
+    DenseLUSolver solver;
+
+    /// A^T of the approximated points. Null, if all points are interpolated
+    std::unique_ptr<math_Matrix> At;
+};
+
+/**
+ * @brief Thread safe cache of factorized approximation systems
+ *
+ * Curves that are reparametrized onto the same parameters with the same number
+ * of control points share the same system and can reuse its factorization.
+ * The cache is bounded, the oldest entries are dropped first. Hence, only systems,
+ * that are likely shared, should be inserted. BSplineApproxInterp::FitCurveOptimal
+ * only caches the system of the initial parameters.
+ */
+class ApproxSystemCache
+{
+public:
+    explicit ApproxSystemCache(size_t maxEntries = 8);
+
+    /// Returns the cached system or a null pointer, if the key is unknown
+    std::shared_ptr<const ApproxSystem> Find(const ApproxSystemKey& key) const;
+
+    /// Stores a system. Does nothing, if the key is already known
+    void Insert(const ApproxSystemKey& key, std::shared_ptr<const ApproxSystem> system);
+
+    void Clear();
+
+    size_t Size() const;
+
+    /// Number of successful lookups
+    size_t Hits() const;
+
+    /// Number of lookups that did not find a system
+    size_t Misses() const;
+
+private:
+    struct Entry
+    {
+        size_t hash;
+        ApproxSystemKey key;
+        std::shared_ptr<const ApproxSystem> system;
+    };
+
+    std::shared_ptr<const ApproxSystem> findUnlocked(size_t hash, const ApproxSystemKey& key) const;
+
+    size_t m_maxEntries;
+    std::deque<Entry> m_entries;
+    mutable size_t m_hits;
+    mutable size_t m_misses;
+    mutable std::mutex m_mutex;
+};
+
+} // namespace occ_gordon_internal
+
+#endif // APPROXSYSTEMCACHE_H
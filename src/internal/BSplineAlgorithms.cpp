@@ -10,25 +10,25 @@
 #include "CurvesToSurface.h"
 #include "Error.h"
 #include "BSplineApproxInterp.h"
+#include "BSplineCurveEvaluator.h"
+#include "MonotoneCubicInterpolation.h"
+#include "Parallel.h"
 #include "PointsToBSplineInterpolation.h"
+#include "TaskMonitor.h"
 
 #include "occ_gordon_internal.h"
 #include "occ_std_adapters.h"
 
 #include <Standard_Version.hxx>
-#include <Geom2d_BSplineCurve.hxx>
 #include <Geom_BSplineCurve.hxx>
 #include <Geom_BSplineSurface.hxx>
 #include <Geom_TrimmedCurve.hxx>
 #include <GeomConvert.hxx>
-#include <Geom2dAPI_Interpolate.hxx>
 #include <GeomAPI_ExtremaCurveCurve.hxx>
 #include <TColStd_Array2OfReal.hxx>
 #include <TColStd_HArray1OfReal.hxx>
 #include <TColStd_HArray1OfInteger.hxx>
 #include <TColgp_HArray1OfPnt.hxx>
-#include <TColgp_HArray1OfPnt2d.hxx>
-#include <TColgp_Array1OfPnt2d.hxx>
 #include <TColgp_HArray2OfPnt.hxx>
 #include <BSplCLib.hxx>
 #include <GeomAPI_PointsToBSpline.hxx>
@@ -36,12 +36,12 @@
 #include <BRepBuilderAPI_MakeFace.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <Precision.hxx>
-#include <Geom2dAPI_ProjectPointOnCurve.hxx>
 #include <GCPnts_AbscissaPoint.hxx>
 
 #include <cmath>
 #include <algorithm>
 #include <cassert>
+#include <limits>
 
 namespace
 {
@@ -127,13 +127,13 @@ namespace
         {
         }
 
-        void insertKnot(double knot, int mult, double tolerance=1e-15)
+        void insertKnots(const TColStd_Array1OfReal& knots, const TColStd_Array1OfInteger& mults, double tolerance=1e-15)
         {
             if (_dir == udir) {
-                _surf->InsertUKnot(knot, mult, tolerance, false);
+                _surf->InsertUKnots(knots, mults, tolerance, true);
             }
             else {
-                _surf->InsertVKnot(knot, mult, tolerance, false);
+                _surf->InsertVKnots(knots, mults, tolerance, true);
             }
         }
 
@@ -199,9 +199,9 @@ namespace
         {
         }
 
-        void insertKnot(double knot, int mult, double tolerance=1e-15)
+        void insertKnots(const TColStd_Array1OfReal& knots, const TColStd_Array1OfInteger& mults, double tolerance=1e-15)
         {
-            _curve->InsertKnot(knot, mult, tolerance, false);
+            _curve->InsertKnots(knots, mults, tolerance, true);
         }
 
         double getKnot(int idx) const
@@ -290,32 +290,62 @@ namespace
             }
         }
 
-        // insert all knots in first spline
-        SplineAdapter& firstSpline = splines_vector[0];
-        for (typename std::vector<SplineAdapter>::const_iterator splineIt = splines_vector.begin()+1; splineIt != splines_vector.end(); ++splineIt) {
+        // merge the interior knots of all splines, using the highest multiplicity.
+        // Knots closer than the tolerance are considered equal.
+        std::vector<std::pair<double, int>> mergedKnots;
+        for (typename std::vector<SplineAdapter>::const_iterator splineIt = splines_vector.begin(); splineIt != splines_vector.end(); ++splineIt) {
             const SplineAdapter& spline = *splineIt;
             for (int knot_idx = 2; knot_idx < spline.getNKnots(); ++knot_idx) {
                 double knot = spline.getKnot(knot_idx);
                 int mult = spline.getMult(knot_idx);
-                firstSpline.insertKnot(knot, mult, par_tolerance);
+                auto it = std::find_if(mergedKnots.begin(), mergedKnots.end(), [&](const std::pair<double, int>& merged) {
+                    return std::abs(merged.first - knot) <= par_tolerance;
+                });
+                if (it != mergedKnots.end()) {
+                    it->second = std::max(it->second, mult);
+                }
+                else {
+                    mergedKnots.push_back(std::make_pair(knot, mult));
+                }
             }
         }
+        std::sort(mergedKnots.begin(), mergedKnots.end());
+
+        // Refine each spline with all missing knots in a single insertion,
+        // which avoids reallocating the poles for every single knot
+        occ_gordon_internal::ParallelFor(0, static_cast<int>(splines_vector.size()), [&](int splineIdx) {
+            SplineAdapter& spline = splines_vector[static_cast<size_t>(splineIdx)];
+
+            std::vector<double> knots;
+            std::vector<int> mults;
+            for (const std::pair<double, int>& merged : mergedKnots) {
+                double knot = merged.first;
+                int mult = merged.second;
+                // reuse the value of an existing knot within the tolerance
+                for (int knot_idx = 2; knot_idx < spline.getNKnots(); ++knot_idx) {
+                    if (std::abs(spline.getKnot(knot_idx) - merged.first) <= par_tolerance) {
+                        knot = spline.getKnot(knot_idx);
+                        mult = merged.second - spline.getMult(knot_idx);
+                        break;
+                    }
+                }
+                if (mult > 0) {
+                    knots.push_back(knot);
+                    mults.push_back(mult);
+                }
+            }
 
-
-        // now insert knots from first into all others
-        for (typename std::vector<SplineAdapter>::iterator splineIt = splines_vector.begin()+1; splineIt != splines_vector.end(); ++splineIt) {
-            SplineAdapter& spline = *splineIt;
-            for (int knot_idx = 2; knot_idx < firstSpline.getNKnots(); ++knot_idx) {
-                double knot = firstSpline.getKnot(knot_idx);
-                int mult = firstSpline.getMult(knot_idx);
-                spline.insertKnot(knot, mult, par_tolerance);
+            if (!knots.empty()) {
+                spline.insertKnots(OccFArray(knots)->Array1(), OccIArray(mults)->Array1(), par_tolerance);
             }
-            if (spline.getNKnots() != firstSpline.getNKnots()) {
+        });
+
+        for (typename std::vector<SplineAdapter>::const_iterator splineIt = splines_vector.begin(); splineIt != splines_vector.end(); ++splineIt) {
+            if (splineIt->getNKnots() != static_cast<int>(mergedKnots.size()) + 2) {
                 throw occ_gordon_internal::error("Unexpected error in Algorithm makeGeometryCompatibleImpl.\nPlease contact the developers.");
             }
         }
 
-
     } // makeGeometryCompatibleImpl
     
     template <class OccMatrix, class OccVector, class OccHandleVector>
@@ -351,6 +381,222 @@ namespace
     {
         return array2GetRow<TColgp_Array2OfPnt, TColgp_HArray1OfPnt, Handle(TColgp_HArray1OfPnt)>(matrix, rowIndex);
     }
+
+    // Parameters at the knots and equally spaced inside each knot span
+    std::vector<double> sampleKnotSpans(const std::vector<double>& knots, int samplesPerSpan)
+    {
+        std::vector<double> params;
+        for (size_t i = 0; i + 1 < knots.size(); ++i) {
+            for (int k = 0; k < samplesPerSpan; ++k) {
+                params.push_back(knots[i] + (knots[i + 1] - knots[i]) * k / samplesPerSpan);
+            }
+        }
+        params.push_back(knots.back());
+        return params;
+    }
+
+    /// Dense samples of a surface to measure the deviation introduced by knot removal
+    class SurfaceSamples
+    {
+    public:
+        explicit SurfaceSamples(const Handle(Geom_BSplineSurface)& surface)
+        {
+            std::vector<double> uKnots, vKnots;
+            for (int i = 1; i <= surface->NbUKnots(); ++i) {
+                uKnots.push_back(surface->UKnot(i));
+            }
+            for (int i = 1; i <= surface->NbVKnots(); ++i) {
+                vKnots.push_back(surface->VKnot(i));
+            }
+            m_u = sampleKnotSpans(uKnots, surface->UDegree() + 1);
+            m_v = sampleKnotSpans(vKnots, surface->VDegree() + 1);
+
+            m_points.resize(m_u.size() * m_v.size());
+            occ_gordon_internal::ParallelFor(0, static_cast<int>(m_u.size()), [&](int i) {
+                for (size_t j = 0; j < m_v.size(); ++j) {
+                    m_points[i * m_v.size() + j] = surface->Value(m_u[i], m_v[j]);
+                }
+            });
+        }
+
+        /// Maximum distance of the surface to the samples inside [uMin, uMax] x [vMin, vMax]
+        double MaxDeviation(const Handle(Geom_BSplineSurface)& surface, double uMin, double uMax, double vMin, double vMax) const
+        {
+            size_t iBegin = std::lower_bound(m_u.begin(), m_u.end(), uMin) - m_u.begin();
+            size_t iEnd = std::upper_bound(m_u.begin(), m_u.end(), uMax) - m_u.begin();
+            size_t jBegin = std::lower_bound(m_v.begin(), m_v.end(), vMin) - m_v.begin();
+            size_t jEnd = std::upper_bound(m_v.begin(), m_v.end(), vMax) - m_v.begin();
+
+            double maxDist = 0.;
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                for (size_t j = jBegin; j < jEnd; ++j) {
+                    maxDist = std::max(maxDist, surface->Value(m_u[i], m_v[j]).Distance(m_points[i * m_v.size() + j]));
+                }
+            }
+            return maxDist;
+        }
+
+        /// Maximum distance of the surface to all samples, computed in parallel
+        double MaxDeviation(const Handle(Geom_BSplineSurface)& surface) const
+        {
+            std::vector<double> rowDeviation(m_u.size(), 0.);
+            occ_gordon_internal::ParallelFor(0, static_cast<int>(m_u.size()), [&](int i) {
+                rowDeviation[i] = MaxDeviation(surface, m_u[i], m_u[i], m_v.front(), m_v.back());
+            });
+            return *std::max_element(rowDeviation.begin(), rowDeviation.end());
+        }
+
+    private:
+        std::vector<double> m_u, m_v;
+        std::vector<gp_Pnt> m_points;
+    };
+
+    struct KnotRemovalCandidate
+    {
+        bool uDirection;
+        double knot;
+        int multiplicity;
+        double deviation;
+    };
+
+    std::vector<KnotRemovalCandidate> knotRemovalCandidates(const Handle(Geom_BSplineSurface)& surface)
+    {
+        std::vector<KnotRemovalCandidate> candidates;
+        for (int i = 2; i < surface->NbUKnots(); ++i) {
+            candidates.push_back({true, surface->UKnot(i), surface->UMultiplicity(i), 0.});
+        }
+        for (int i = 2; i < surface->NbVKnots(); ++i) {
+            candidates.push_back({false, surface->VKnot(i), surface->VMultiplicity(i), 0.});
+        }
+        return candidates;
+    }
+
+    /**
+     * Removes the candidate knot once from a copy of the surface. Returns a null handle,
+     * if the knot does not exist anymore with this multiplicity or cannot be removed.
+     * The parameter range, where the surface has changed, is returned in rangeMin, rangeMax.
+     */
+    Handle(Geom_BSplineSurface) tryRemoveKnot(const Handle(Geom_BSplineSurface)& surface, const KnotRemovalCandidate& candidate,
+                                              double tolerance, double& rangeMin, double& rangeMax)
+    {
+        const bool u = candidate.uDirection;
+        const int nKnots = u ? surface->NbUKnots() : surface->NbVKnots();
+        const int degree = u ? surface->UDegree() : surface->VDegree();
+        const bool periodic = u ? surface->IsUPeriodic() : surface->IsVPeriodic();
+        auto knot = [&](int i) {
+            return u ? surface->UKnot(i) : surface->VKnot(i);
+        };
+
+        int index = 0;
+        for (int i = 2; i < nKnots; ++i) {
+            if (knot(i) == candidate.knot) {
+                index = i;
+                break;
+            }
+        }
+        int mult = index > 0 ? (u ? surface->UMultiplicity(index) : surface->VMultiplicity(index)) : 0;
+        if (mult != candidate.multiplicity) {
+            return Handle(Geom_BSplineSurface)();
+        }
+
+        Handle(Geom_BSplineSurface) result = Handle(Geom_BSplineSurface)::DownCast(surface->Copy());
+        bool removed = u ? result->RemoveUKnot(index, mult - 1, tolerance) : result->RemoveVKnot(index, mult - 1, tolerance);
+        if (!removed) {
+            return Handle(Geom_BSplineSurface)();
+        }
+
+        // Only the poles, whose basis functions contain the knot, are changed
+        if (periodic) {
+            rangeMin = knot(1);
+            rangeMax = knot(nKnots);
+        }
+        else {
+            rangeMin = knot(std::max(1, index - degree - 1));
+            rangeMax = knot(std::min(nKnots, index + degree + 1));
+        }
+        return result;
+    }
+
+    double candidateDeviation(const SurfaceSamples& samples, const Handle(Geom_BSplineSurface)& surface,
+                              const KnotRemovalCandidate& candidate, double rangeMin, double rangeMax)
+    {
+        const double inf = std::numeric_limits<double>::max();
+        return candidate.uDirection ? samples.MaxDeviation(surface, rangeMin, rangeMax, -inf, inf)
+                                    : samples.MaxDeviation(surface, -inf, inf, rangeMin, rangeMax);
+    }
+
+    // Joins the patches (i, j) and (i, j + 1) of the grid in v direction.
+    // The poles of the seam are averaged and the neighboring poles are moved
+    // symmetrically, such that both patches get the mean derivative at the seam.
+    // The neighboring poles are only moved, if no pole of the whole seam line j moves further
+    // than tolerance from the original patches. Otherwise, the patches join with C0 continuity
+    // at this seam line. As the patches are non-rational, the surface then deviates at most
+    // by the tolerance from the original patches.
+    // The patches of a column must have common u knots, the patches of a row common v knots.
+    // Returns the continuity (0 or 1) of each seam line
+    std::vector<int> joinVSeams(const std::vector<Handle(Geom_BSplineSurface)>& patches,
+                                const std::vector<Handle(Geom_BSplineSurface)>& originals,
+                                size_t nPatchesU, size_t nPatchesV, double tolerance)
+    {
+        std::vector<int> continuity;
+        for (size_t j = 0; j + 1 < nPatchesV; ++j) {
+            // seam poles and the moved neighboring poles of each patch column
+            std::vector<std::vector<gp_XYZ>> seams(nPatchesU), lowerPoles(nPatchesU), upperPoles(nPatchesU);
+            double maxDisplacement = 0.;
+
+            for (size_t i = 0; i < nPatchesU; ++i) {
+                const Handle(Geom_BSplineSurface)& lower = patches[i * nPatchesV + j];
+                const Handle(Geom_BSplineSurface)& upper = patches[i * nPatchesV + j + 1];
+                const Handle(Geom_BSplineSurface)& lowerOriginal = originals[i * nPatchesV + j];
+                const Handle(Geom_BSplineSurface)& upperOriginal = originals[i * nPatchesV + j + 1];
+
+                // the derivative at the end of a clamped spline only depends on the last knot span
+                const double degree = static_cast<double>(lower->VDegree());
+                const double lowerSpan = lower->VKnot(lower->NbVKnots()) - lower->VKnot(lower->NbVKnots() - 1);
+                const double upperSpan = upper->VKnot(2) - upper->VKnot(1);
+                const int nLower = lower->NbVPoles();
+
+                for (int iu = 1; iu <= lower->NbUPoles(); ++iu) {
+                    const gp_XYZ seam = (lower->Pole(iu, nLower).XYZ() + upper->Pole(iu, 1).XYZ()) * 0.5;
+                    const gp_XYZ derivative = ((seam - lower->Pole(iu, nLower - 1).XYZ()) / lowerSpan
+                                               + (upper->Pole(iu, 2).XYZ() - seam) / upperSpan) * (0.5 * degree);
+                    const gp_XYZ lowerPole = seam - derivative * (lowerSpan / degree);
+                    const gp_XYZ upperPole = seam + derivative * (upperSpan / degree);
+
+                    maxDisplacement = std::max({maxDisplacement,
+                                                (seam - lowerOriginal->Pole(iu, nLower).XYZ()).Modulus(),
+                                                (seam - upperOriginal->Pole(iu, 1).XYZ()).Modulus(),
+                                                (lowerPole - lowerOriginal->Pole(iu, nLower - 1).XYZ()).Modulus(),
+                                                (upperPole - upperOriginal->Pole(iu, 2).XYZ()).Modulus()});
+
+                    seams[i].push_back(seam);
+                    lowerPoles[i].push_back(lowerPole);
+                    upperPoles[i].push_back(upperPole);
+                }
+            }
+
+            // The decision is made for the whole seam line, such that the join of the
+            // transposed grid changes all affected rows by the same linear combination
+            const bool joinC1 = maxDisplacement <= tolerance;
+            continuity.push_back(joinC1 ? 1 : 0);
+            for (size_t i = 0; i < nPatchesU; ++i) {
+                const Handle(Geom_BSplineSurface)& lower = patches[i * nPatchesV + j];
+                const Handle(Geom_BSplineSurface)& upper = patches[i * nPatchesV + j + 1];
+                const int nLower = lower->NbVPoles();
+
+                for (int iu = 1; iu <= lower->NbUPoles(); ++iu) {
+                    const size_t k = static_cast<size_t>(iu - 1);
+                    lower->SetPole(iu, nLower, gp_Pnt(seams[i][k]));
+                    upper->SetPole(iu, 1, gp_Pnt(seams[i][k]));
+                    if (joinC1) {
+                        lower->SetPole(iu, nLower - 1, gp_Pnt(lowerPoles[i][k]));
+                        upper->SetPole(iu, 2, gp_Pnt(upperPoles[i][k]));
+                    }
+                }
+            }
+        }
+        return continuity;
+    }
     		
 } // namespace
 
@@ -584,15 +830,17 @@ BSplineAlgorithms::computeParamsBSplineSurf(const TColgp_Array2OfPnt& points, do
 
 std::vector<Handle(Geom_BSplineCurve)> BSplineAlgorithms::createCommonKnotsVectorCurve(const std::vector<Handle(Geom_BSplineCurve)>& splines_vector, double tol)
 {
-    // Match parameter range
-    matchParameterRange(splines_vector, tol);
-
     // Create a copy that we can modify
-    std::vector<CurveAdapterView> splines_adapter;
+    std::vector<Handle(Geom_BSplineCurve)> splines_copy;
     for (size_t i = 0; i < splines_vector.size(); ++i) {
-        splines_adapter.push_back(Handle(Geom_BSplineCurve)::DownCast(splines_vector[i]->Copy()));
+        splines_copy.push_back(Handle(Geom_BSplineCurve)::DownCast(splines_vector[i]->Copy()));
     }
 
+    // Match parameter range
+    matchParameterRange(splines_copy, tol);
+
+    std::vector<CurveAdapterView> splines_adapter(splines_copy.begin(), splines_copy.end());
+
     makeGeometryCompatibleImpl(splines_adapter, tol);
 
     return std::vector<Handle(Geom_BSplineCurve)>(splines_adapter.begin(), splines_adapter.end());
@@ -654,28 +902,16 @@ void BSplineAlgorithms::matchDegree(const std::vector<Handle(Geom_BSplineCurve)
 ApproxResult BSplineAlgorithms::reparametrizeBSplineContinuouslyApprox(const Handle(Geom_BSplineCurve) spline,
                                                                                  const std::vector<double>& old_parameters,
                                                                                  const std::vector<double>& new_parameters,
-                                                                                 size_t n_control_pnts)
+                                                                                 size_t n_control_pnts,
+                                                                                 ApproxSystemCache* cache,
+                                                                                 size_t min_samples, int optimization_iterations)
 {
     if (old_parameters.size() != new_parameters.size()) {
         throw error("parameter sizes dont match");
     }
 
-    // create a B-spline as a function for reparametrization
-    Handle(TColgp_HArray1OfPnt2d) old_parameters_pnts = new TColgp_HArray1OfPnt2d(1, static_cast<Standard_Integer>(old_parameters.size()));
-    for (size_t parameter_idx = 0; parameter_idx < old_parameters.size(); ++parameter_idx) {
-        int occIdx = static_cast<int>(parameter_idx + 1);
-        old_parameters_pnts->SetValue(occIdx, gp_Pnt2d(old_parameters[parameter_idx], 0));
-    }
-
-    Geom2dAPI_Interpolate interpolationObject(old_parameters_pnts, OccFArray(new_parameters), false, 1e-15);
-    interpolationObject.Perform();
-
-    // check that interpolation was successful
-    if (!interpolationObject.IsDone()) {
-        throw error("Cannot reparametrize", MATH_ERROR);
-    }
-
-    Handle(Geom2d_BSplineCurve) reparametrizing_spline = interpolationObject.Curve();
+    // create a monotone function for reparametrization, that maps the new onto the old parameters
+    MonotoneCubicInterpolation reparametrizing_function(new_parameters, old_parameters);
 
     // Create a vector of parameters including the intersection parameters
     std::vector<double> breaks;
@@ -692,8 +928,7 @@ ApproxResult BSplineAlgorithms::reparametrizeBSplineContinuouslyApprox(const Han
     // convert kink parameters into reparametrized parameter using the
     // inverse reparametrization function
     for (size_t ikink = 0; ikink < kinks.size(); ++ikink) {
-        kinks[ikink] = Geom2dAPI_ProjectPointOnCurve(gp_Pnt2d(kinks[ikink], 0.), reparametrizing_spline)
-                           .LowerDistanceParameter();
+        kinks[ikink] = reparametrizing_function.Inverse(kinks[ikink]);
     }
 
     for (size_t ikink = 0; ikink < kinks.size(); ++ikink) {
@@ -708,7 +943,7 @@ ApproxResult BSplineAlgorithms::reparametrizeBSplineContinuouslyApprox(const Han
     // create equidistance array of parameters, including the breaks
     std::vector<double> parameters = LinspaceWithBreaks(new_parameters.front(),
                                                         new_parameters.back(),
-                                                        std::max(static_cast<size_t>(101), n_control_pnts*2),
+                                                        std::max(min_samples, n_control_pnts*2),
                                                         breaks);
 #ifdef MODEL_KINKS
     // insert kinks into parameters array at the correct position
@@ -722,10 +957,15 @@ ApproxResult BSplineAlgorithms::reparametrizeBSplineContinuouslyApprox(const Han
 
     // Compute points on spline at the new parameters
     // Those will be approximated later on
+    std::vector<double> oldParameters(parameters.size());
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        oldParameters[i] = reparametrizing_function.Value(parameters[i]);
+    }
+
+    std::vector<gp_XYZ> samples = evaluateCurveSorted(spline, oldParameters);
     TColgp_Array1OfPnt points(1, static_cast<Standard_Integer>(parameters.size()));
     for (size_t i = 1; i <= parameters.size(); ++i) {
-        double oldParameter = reparametrizing_spline->Value(parameters[i-1]).X();
-        points(static_cast<Standard_Integer>(i)) = spline->Value(oldParameter);
+        points(static_cast<Standard_Integer>(i)) = gp_Pnt(samples[i - 1]);
     }
 
     bool makeContinuous = spline->IsClosed() &&
@@ -733,6 +973,7 @@ ApproxResult BSplineAlgorithms::reparametrizeBSplineContinuouslyApprox(const Han
 
     // Create the new spline as a interpolation of the old one
     BSplineApproxInterp approximationObj(points, static_cast<int>(n_control_pnts), 3, makeContinuous);
+    approximationObj.SetSystemCache(cache);
 
     breaks.insert(breaks.begin(), new_parameters.front());
     breaks.push_back(new_parameters.back());
@@ -755,7 +996,7 @@ ApproxResult BSplineAlgorithms::reparametrizeBSplineContinuouslyApprox(const Han
     }
 #endif
 
-    ApproxResult result = approximationObj.FitCurveOptimal(parameters, 1);
+    ApproxResult result = approximationObj.FitCurveOptimal(parameters, optimization_iterations);
 
     assert(!result.curve.IsNull());
 
@@ -772,7 +1013,8 @@ Handle(Geom_BSplineSurface) BSplineAlgorithms::flipSurface(const Handle(Geom_BSp
 Handle(Geom_BSplineSurface) BSplineAlgorithms::pointsToSurface(const TColgp_Array2OfPnt& points,
                                                                     const std::vector<double>& uParams,
                                                                     const std::vector<double>& vParams,
-                                                                    bool uContinuousIfClosed, bool vContinuousIfClosed)
+                                                                    bool uContinuousIfClosed, bool vContinuousIfClosed,
+                                                                    int uDegree, int vDegree)
 {
 
     double tolerance = REL_TOL_CLOSED * scale(points);
@@ -783,7 +1025,7 @@ Handle(Geom_BSplineSurface) BSplineAlgorithms::pointsToSurface(const TColgp_Arra
     std::vector<Handle(Geom_Curve)> uSplines;
     for (int cpVIdx = points.LowerCol(); cpVIdx <= points.UpperCol(); ++cpVIdx) {
         Handle(TColgp_HArray1OfPnt) points_u = pntArray2GetColumn(points, cpVIdx);
-        PointsToBSplineInterpolation interpolationObject(points_u, uParams, 3, makeUDirClosed);
+        PointsToBSplineInterpolation interpolationObject(points_u, uParams, static_cast<unsigned int>(uDegree), makeUDirClosed);
 
         Handle(Geom_Curve) curve = interpolationObject.Curve();
         uSplines.push_back(curve);
@@ -791,20 +1033,22 @@ Handle(Geom_BSplineSurface) BSplineAlgorithms::pointsToSurface(const TColgp_Arra
 
     // now create a skinned surface with these B-splines which represents the interpolating surface
     CurvesToSurface skinner(uSplines, vParams, makeVDirClosed );
+    skinner.SetMaxDegree(vDegree);
     Handle(Geom_BSplineSurface) interpolatingSurf = skinner.Surface();
 
     return interpolatingSurf;
 }
 
 
-std::vector<std::pair<double, double> > BSplineAlgorithms::intersections(const Handle(Geom_BSplineCurve) spline1, const Handle(Geom_BSplineCurve) spline2, double tolerance) {
+std::vector<std::pair<double, double> > BSplineAlgorithms::intersections(const Handle(Geom_BSplineCurve) spline1, const Handle(Geom_BSplineCurve) spline2, double tolerance,
+                                                                         const IntersectBSplinesOptions& options) {
 
     // find out the average scale of the two B-splines in order to being able to handle a more approximate curves and find its intersections
     double splines_scale = (BSplineAlgorithms::scale(spline1) + BSplineAlgorithms::scale(spline2)) / 2.;
 
     std::vector<std::pair<double, double> > intersection_params_vector;
 
-    auto results = IntersectBSplines(spline1, spline2, tolerance*splines_scale);
+    auto results = IntersectBSplines(spline1, spline2, tolerance*splines_scale, options);
     for (const auto& r : results) {
         intersection_params_vector.push_back({r.parmOnCurve1, r.parmOnCurve2});
     }
@@ -872,6 +1116,178 @@ math_Matrix BSplineAlgorithms::bsplineBasisMat(int degree, const TColStd_Array1O
     return mx;
 }
 
+ApproxResult BSplineAlgorithms::reparametrizeBSplineExact(const Handle(Geom_BSplineCurve) spline,
+                                                         const std::vector<double>& old_parameters,
+                                                         const std::vector<double>& new_parameters,
+                                                         double knot_removal_tol)
+{
+    if (spline.IsNull()) {
+        throw error("Null Pointer curve", NULL_POINTER);
+    }
+
+    if (old_parameters.size() != new_parameters.size()) {
+        throw error("parameter sizes dont match");
+    }
+
+    if (old_parameters.size() < 2) {
+        throw error("At least two parameters are required for the reparametrization");
+    }
+
+    for (size_t ipar = 1; ipar < old_parameters.size(); ++ipar) {
+        if (old_parameters[ipar] <= old_parameters[ipar - 1] || new_parameters[ipar] <= new_parameters[ipar - 1]) {
+            throw error("Parameters of the exact reparametrization must be strictly ascending", MATH_ERROR);
+        }
+    }
+
+    Handle(Geom_BSplineCurve) curve = spline;
+    if (curve->IsPeriodic()) {
+        curve = Handle(Geom_BSplineCurve)::DownCast(spline->Copy());
+        curve->SetNotPeriodic();
+    }
+
+    const int degree = curve->Degree();
+    const bool rational = curve->IsRational();
+
+    // On each interval [old_i, old_i+1], the reparametrization function is linear.
+    // Hence, the composition is the segment of the curve with affinely mapped knots.
+    // The segments are joined with a C0 knot at the new parameters.
+    std::vector<gp_Pnt> poles;
+    std::vector<double> weights, knots;
+    std::vector<int> mults;
+    for (size_t iseg = 0; iseg + 1 < old_parameters.size(); ++iseg) {
+        Handle(Geom_BSplineCurve) segment = trimCurve(curve, old_parameters[iseg], old_parameters[iseg + 1]);
+
+        const double segStart = segment->Knot(1);
+        const double segEnd = segment->Knot(segment->NbKnots());
+        const double newStart = new_parameters[iseg];
+        const double newEnd = new_parameters[iseg + 1];
+        const double scale = (newEnd - newStart) / (segEnd - segStart);
+
+        // The first pole of a segment is the last pole of the previous one.
+        // For rational curves, the weights must be scaled to match at the joint.
+        const int firstPole = iseg == 0 ? 1 : 2;
+        const double weightScale = (rational && iseg > 0) ? weights.back() / segment->Weight(1) : 1.;
+        for (int ipole = firstPole; ipole <= segment->NbPoles(); ++ipole) {
+            poles.push_back(segment->Pole(ipole));
+            if (rational) {
+                weights.push_back(segment->Weight(ipole) * weightScale);
+            }
+        }
+
+        if (iseg == 0) {
+            knots.push_back(newStart);
+            mults.push_back(degree + 1);
+        }
+        else {
+            mults.back() = degree;
+        }
+
+        for (int iknot = 2; iknot < segment->NbKnots(); ++iknot) {
+            knots.push_back(newStart + (segment->Knot(iknot) - segStart) * scale);
+            mults.push_back(segment->Multiplicity(iknot));
+        }
+        knots.push_back(newEnd);
+        mults.push_back(degree + 1);
+    }
+
+    Handle(Geom_BSplineCurve) result;
+    if (rational) {
+        result = new Geom_BSplineCurve(OccArray(poles)->Array1(), OccFArray(weights)->Array1(),
+                                       OccFArray(knots)->Array1(), OccIArray(mults)->Array1(), degree, false);
+    }
+    else {
+        result = new Geom_BSplineCurve(OccArray(poles)->Array1(), OccFArray(knots)->Array1(),
+                                       OccIArray(mults)->Array1(), degree, false);
+    }
+
+    double removalError = 0.;
+    if (knot_removal_tol > 0.) {
+        const Handle(Geom_BSplineCurve) composition = Handle(Geom_BSplineCurve)::DownCast(result->Copy());
+        bool removed = false;
+
+        // try to restore the parametric continuity at the joints
+        for (size_t ipar = 1; ipar + 1 < new_parameters.size(); ++ipar) {
+            int knotIndex = 0;
+            for (int iknot = 2; iknot < result->NbKnots(); ++iknot) {
+                if (std::abs(result->Knot(iknot) - new_parameters[ipar]) < 1e-14) {
+                    knotIndex = iknot;
+                    break;
+                }
+            }
+            if (knotIndex == 0) {
+                continue;
+            }
+
+            for (int mult = 0; mult < result->Multiplicity(knotIndex); ++mult) {
+                if (result->RemoveKnot(knotIndex, mult, knot_removal_tol)) {
+                    removed = true;
+                    break;
+                }
+            }
+        }
+
+        // the knot removal changes the geometry within the tolerance
+        if (removed) {
+            const int nSamples = 20;
+            for (size_t iseg = 0; iseg + 1 < new_parameters.size(); ++iseg) {
+                for (int i = 0; i <= nSamples; ++i) {
+                    const double t = new_parameters[iseg] + (new_parameters[iseg + 1] - new_parameters[iseg]) * i / nSamples;
+                    removalError = std::max(removalError, composition->Value(t).Distance(result->Value(t)));
+                }
+            }
+        }
+    }
+
+    ApproxResult approx;
+    approx.curve = result;
+    approx.error = removalError;
+    return approx;
+}
+
+std::vector<gp_XYZ> BSplineAlgorithms::evaluateCurveSorted(const Handle(Geom_BSplineCurve)& curve, const std::vector<double>& params, unsigned int derivOrder)
+{
+    if (curve.IsNull()) {
+        throw error("Null Pointer curve", NULL_POINTER);
+    }
+
+    std::vector<gp_XYZ> result(params.size());
+    if (!params.empty()) {
+        BSplineCurveEvaluator evaluator(curve);
+        evaluator.EvaluateSorted(params.data(), params.size(), static_cast<int>(derivOrder), result.data());
+    }
+    return result;
+}
+
+std::vector<gp_XYZ> BSplineAlgorithms::evaluateCurvesSorted(const std::vector<Handle(Geom_BSplineCurve)>& curves, const std::vector<double>& params)
+{
+    for (const Handle(Geom_BSplineCurve)& curve : curves) {
+        if (curve.IsNull()) {
+            throw error("Null Pointer curve", NULL_POINTER);
+        }
+    }
+
+    const size_t nCurves = curves.size();
+    std::vector<gp_XYZ> result(params.size() * nCurves);
+    if (result.empty()) {
+        return result;
+    }
+
+    if (MultiCurveEvaluator::HaveCommonKnots(curves)) {
+        MultiCurveEvaluator evaluator(curves);
+        evaluator.EvaluateSorted(params.data(), params.size(), result.data());
+        return result;
+    }
+
+    // e.g. curves with kinks are approximated with different knots
+    for (size_t icurve = 0; icurve < nCurves; ++icurve) {
+        std::vector<gp_XYZ> points = evaluateCurveSorted(curves[icurve], params);
+        for (size_t iparam = 0; iparam < params.size(); ++iparam) {
+            result[iparam * nCurves + icurve] = points[iparam];
+        }
+    }
+    return result;
+}
+
 std::vector<double> BSplineAlgorithms::getKinkParameters(const Handle(Geom_BSplineCurve)& curve)
 {
     if (curve.IsNull()) {
@@ -880,15 +1296,33 @@ std::vector<double> BSplineAlgorithms::getKinkParameters(const Handle(Geom_BSpli
 
     double eps = 1e-8;
 
-    std::vector<double> kinks;
+    // candidates are knots with multiplicity equal to the degree
+    std::vector<double> candidates;
     for (int knotIndex = 2; knotIndex < curve->NbKnots(); ++knotIndex) {
         if (curve->Multiplicity(knotIndex) == curve->Degree()) {
-            double knot = curve->Knot(knotIndex);
-            // check if really a kink
-            double angle = curve->DN(knot + eps, 1).Angle(curve->DN(knot - eps, 1));
-            if (angle > 6./180. * M_PI) {
-                kinks.push_back(knot);
-            }
+            candidates.push_back(curve->Knot(knotIndex));
+        }
+    }
+
+    if (candidates.empty()) {
+        return {};
+    }
+
+    // evaluate the derivatives left and right of each candidate in one sweep
+    std::vector<double> params;
+    params.reserve(2 * candidates.size());
+    for (double knot : candidates) {
+        params.push_back(knot - eps);
+        params.push_back(knot + eps);
+    }
+    std::vector<gp_XYZ> derivatives = evaluateCurveSorted(curve, params, 1);
+
+    std::vector<double> kinks;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        // check if really a kink
+        double angle = gp_Vec(derivatives[2 * i + 1]).Angle(gp_Vec(derivatives[2 * i]));
+        if (angle > 6./180. * M_PI) {
+            kinks.push_back(candidates[i]);
         }
     }
 
@@ -921,6 +1355,258 @@ BSplineAlgorithms::SurfaceKinks BSplineAlgorithms::getKinkParameters(const Handl
 }
 
 
+BSplineAlgorithms::SurfaceKnotRemovalResult BSplineAlgorithms::removeSurfaceKnots(const Handle(Geom_BSplineSurface)& surface, double tolerance,
+                                                                                 TaskMonitor* monitor)
+{
+    if (surface.IsNull()) {
+        throw error("Null Pointer surface", NULL_POINTER);
+    }
+
+    SurfaceKnotRemovalResult result;
+    result.surface = surface;
+    result.nPolesBefore = surface->NbUPoles() * surface->NbVPoles();
+    result.nPolesAfter = result.nPolesBefore;
+    result.maxDeviation = 0.;
+
+    // no copy is needed, if the removal is disabled
+    if (tolerance <= 0.) {
+        return result;
+    }
+
+    result.surface = Handle(Geom_BSplineSurface)::DownCast(surface->Copy());
+
+    const SurfaceSamples samples(surface);
+    Handle(Geom_BSplineSurface) reduced = result.surface;
+
+    bool removedKnot = true;
+    while (removedKnot) {
+        removedKnot = false;
+
+        // try to remove each knot independently
+        std::vector<KnotRemovalCandidate> candidates = knotRemovalCandidates(reduced);
+        ParallelFor(0, static_cast<int>(candidates.size()), [&](int i) {
+            if (monitor) {
+                monitor->CheckCancelled();
+            }
+            KnotRemovalCandidate& candidate = candidates[i];
+            double rangeMin = 0., rangeMax = 0.;
+            Handle(Geom_BSplineSurface) trial = tryRemoveKnot(reduced, candidate, tolerance, rangeMin, rangeMax);
+            candidate.deviation = trial.IsNull() ? std::numeric_limits<double>::max()
+                                                 : candidateDeviation(samples, trial, candidate, rangeMin, rangeMax);
+        });
+
+        std::stable_sort(candidates.begin(), candidates.end(), [](const KnotRemovalCandidate& a, const KnotRemovalCandidate& b) {
+            return a.deviation < b.deviation;
+        });
+
+        // Removals of neighboring knots interact. Hence, each removal is checked
+        // again on the reduced surface, before it is accepted.
+        // The number of passes is unknown. Each pass reports its own progress,
+        // the monitor ignores the decreasing progress of the following passes.
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            const KnotRemovalCandidate& candidate = candidates[i];
+            if (candidate.deviation > tolerance) {
+                break;
+            }
+
+            double rangeMin = 0., rangeMax = 0.;
+            Handle(Geom_BSplineSurface) trial = tryRemoveKnot(reduced, candidate, tolerance, rangeMin, rangeMax);
+            if (!trial.IsNull() && candidateDeviation(samples, trial, candidate, rangeMin, rangeMax) <= tolerance) {
+                reduced = trial;
+                removedKnot = true;
+            }
+
+            if (monitor) {
+                monitor->SetStageProgress(static_cast<double>(i + 1) / static_cast<double>(candidates.size()));
+            }
+        }
+    }
+
+    result.surface = reduced;
+    result.nPolesAfter = reduced->NbUPoles() * reduced->NbVPoles();
+    result.maxDeviation = samples.MaxDeviation(reduced);
+    return result;
+}
+
+std::vector<Handle(Geom_BSplineSurface)> BSplineAlgorithms::makePatchesCompatible(const std::vector<Handle(Geom_BSplineSurface)>& patches,
+                                                                                  size_t nPatchesU, size_t nPatchesV, double tolerance,
+                                                                                  std::vector<int>* continuityU,
+                                                                                  std::vector<int>* continuityV)
+{
+    if (patches.empty() || patches.size() != nPatchesU * nPatchesV) {
+        throw error("The number of patches does not match the size of the patch grid", INDEX_ERROR);
+    }
+
+    int uDegree = 0;
+    int vDegree = 0;
+    for (const Handle(Geom_BSplineSurface)& patch : patches) {
+        if (patch.IsNull()) {
+            throw error("Null Pointer surface", NULL_POINTER);
+        }
+        if (patch->IsURational() || patch->IsVRational() || patch->IsUPeriodic() || patch->IsVPeriodic()) {
+            throw error("Only non-rational and non-periodic patches can be joined", MATH_ERROR);
+        }
+        uDegree = std::max(uDegree, patch->UDegree());
+        vDegree = std::max(vDegree, patch->VDegree());
+    }
+
+    std::vector<Handle(Geom_BSplineSurface)> result;
+    result.reserve(patches.size());
+    for (const Handle(Geom_BSplineSurface)& patch : patches) {
+        Handle(Geom_BSplineSurface) copy = Handle(Geom_BSplineSurface)::DownCast(patch->Copy());
+        copy->IncreaseDegree(uDegree, vDegree);
+        result.push_back(copy);
+    }
+
+    // common u knots in each column and common v knots in each row
+    for (size_t i = 0; i < nPatchesU; ++i) {
+        std::vector<Handle(Geom_BSplineSurface)> column(result.begin() + static_cast<std::ptrdiff_t>(i * nPatchesV),
+                                                        result.begin() + static_cast<std::ptrdiff_t>((i + 1) * nPatchesV));
+        column = createCommonKnotsVectorSurface(column, SurfaceDirection::u);
+        std::copy(column.begin(), column.end(), result.begin() + static_cast<std::ptrdiff_t>(i * nPatchesV));
+    }
+
+    for (size_t j = 0; j < nPatchesV; ++j) {
+        std::vector<Handle(Geom_BSplineSurface)> row;
+        for (size_t i = 0; i < nPatchesU; ++i) {
+            row.push_back(result[i * nPatchesV + j]);
+        }
+        row = createCommonKnotsVectorSurface(row, SurfaceDirection::v);
+        for (size_t i = 0; i < nPatchesU; ++i) {
+            result[i * nPatchesV + j] = row[i];
+        }
+    }
+
+    // The displacements of both joins are measured against the patches before any join.
+    // Degree elevation and knot insertion don't change the geometry.
+    std::vector<Handle(Geom_BSplineSurface)> originals;
+    originals.reserve(result.size());
+    for (const Handle(Geom_BSplineSurface)& patch : result) {
+        originals.push_back(Handle(Geom_BSplineSurface)::DownCast(patch->Copy()));
+    }
+
+    const std::vector<int> vSeams = joinVSeams(result, originals, nPatchesU, nPatchesV, tolerance);
+
+    // The seams in u direction are the v seams of the transposed grid.
+    // Both joins change the poles by the same linear combinations in each row or column,
+    // hence the second join keeps the continuity established by the first one.
+    std::vector<Handle(Geom_BSplineSurface)> transposed(result.size());
+    std::vector<Handle(Geom_BSplineSurface)> transposedOriginals(result.size());
+    for (size_t i = 0; i < nPatchesU; ++i) {
+        for (size_t j = 0; j < nPatchesV; ++j) {
+            transposed[j * nPatchesU + i] = result[i * nPatchesV + j];
+            transposed[j * nPatchesU + i]->ExchangeUV();
+            transposedOriginals[j * nPatchesU + i] = originals[i * nPatchesV + j];
+            transposedOriginals[j * nPatchesU + i]->ExchangeUV();
+        }
+    }
+
+    const std::vector<int> uSeams = joinVSeams(transposed, transposedOriginals, nPatchesV, nPatchesU, tolerance);
+
+    for (const Handle(Geom_BSplineSurface)& patch : result) {
+        patch->ExchangeUV();
+    }
+
+    if (continuityU) {
+        *continuityU = uSeams;
+    }
+    if (continuityV) {
+        *continuityV = vSeams;
+    }
+
+    return result;
+}
+
+Handle(Geom_BSplineSurface) BSplineAlgorithms::mergePatches(const std::vector<Handle(Geom_BSplineSurface)>& patches,
+                                                            size_t nPatchesU, size_t nPatchesV, double tolerance)
+{
+    if (patches.empty() || patches.size() != nPatchesU * nPatchesV) {
+        throw error("The number of patches does not match the size of the patch grid", INDEX_ERROR);
+    }
+
+    const int uDegree = patches.front()->UDegree();
+    const int vDegree = patches.front()->VDegree();
+
+    // knots and pole offsets in u direction from the first row of patches
+    std::vector<double> uKnots;
+    std::vector<int> uMults, uOffsets, uSeams;
+    int nUPoles = 0;
+    for (size_t i = 0; i < nPatchesU; ++i) {
+        const Handle(Geom_BSplineSurface)& patch = patches[i * nPatchesV];
+        if (i > 0) {
+            if (std::abs(patch->UKnot(1) - uKnots.back()) > PAR_CHECK_TOL) {
+                throw error("The patches do not share the parameter of their seam", MATH_ERROR);
+            }
+            // the seam is a knot of multiplicity degree with a common pole
+            uMults.back() = uDegree;
+            uSeams.push_back(static_cast<int>(uKnots.size()));
+            nUPoles -= 1;
+        }
+        uOffsets.push_back(nUPoles);
+        nUPoles += patch->NbUPoles();
+        for (int iknot = i > 0 ? 2 : 1; iknot <= patch->NbUKnots(); ++iknot) {
+            uKnots.push_back(patch->UKnot(iknot));
+            uMults.push_back(patch->UMultiplicity(iknot));
+        }
+    }
+
+    // the same in v direction from the first column
+    std::vector<double> vKnots;
+    std::vector<int> vMults, vOffsets, vSeams;
+    int nVPoles = 0;
+    for (size_t j = 0; j < nPatchesV; ++j) {
+        const Handle(Geom_BSplineSurface)& patch = patches[j];
+        if (j > 0) {
+            if (std::abs(patch->VKnot(1) - vKnots.back()) > PAR_CHECK_TOL) {
+                throw error("The patches do not share the parameter of their seam", MATH_ERROR);
+            }
+            vMults.back() = vDegree;
+            vSeams.push_back(static_cast<int>(vKnots.size()));
+            nVPoles -= 1;
+        }
+        vOffsets.push_back(nVPoles);
+        nVPoles += patch->NbVPoles();
+        for (int iknot = j > 0 ? 2 : 1; iknot <= patch->NbVKnots(); ++iknot) {
+            vKnots.push_back(patch->VKnot(iknot));
+            vMults.push_back(patch->VMultiplicity(iknot));
+        }
+    }
+
+    // the poles of the seams are shared by neighboring patches
+    TColgp_Array2OfPnt poles(1, nUPoles, 1, nVPoles);
+    for (size_t i = 0; i < nPatchesU; ++i) {
+        for (size_t j = 0; j < nPatchesV; ++j) {
+            const Handle(Geom_BSplineSurface)& patch = patches[i * nPatchesV + j];
+            if (patch->UDegree() != uDegree || patch->VDegree() != vDegree ||
+                patch->NbUPoles() != patches[i * nPatchesV]->NbUPoles() || patch->NbVPoles() != patches[j]->NbVPoles()) {
+                throw error("The patches are not compatible", MATH_ERROR);
+            }
+
+            for (int iu = 1; iu <= patch->NbUPoles(); ++iu) {
+                for (int iv = 1; iv <= patch->NbVPoles(); ++iv) {
+                    poles(uOffsets[i] + iu, vOffsets[j] + iv) = patch->Pole(iu, iv);
+                }
+            }
+        }
+    }
+
+    Handle(Geom_BSplineSurface) result = new Geom_BSplineSurface(poles,
+                                                                 OccFArray(uKnots)->Array1(), OccFArray(vKnots)->Array1(),
+                                                                 OccIArray(uMults)->Array1(), OccIArray(vMults)->Array1(),
+                                                                 uDegree, vDegree);
+
+    // If the patches are joined with C1 continuity, the multiplicity of the seams can be reduced.
+    // The seams are processed backwards, as a removed knot shifts the indices of the following knots.
+    for (std::vector<int>::reverse_iterator it = uSeams.rbegin(); it != uSeams.rend(); ++it) {
+        result->RemoveUKnot(*it, uDegree - 1, tolerance);
+    }
+    for (std::vector<int>::reverse_iterator it = vSeams.rbegin(); it != vSeams.rend(); ++it) {
+        result->RemoveVKnot(*it, vDegree - 1, tolerance);
+    }
+
+    return result;
+}
+
 Handle(Geom_BSplineCurve) BSplineAlgorithms::trimCurve(const Handle(Geom_BSplineCurve)& curve, double umin, double umax)
 {
     Handle(Geom_BSplineCurve) copy = Handle(Geom_BSplineCurve)::DownCast(curve->Copy());
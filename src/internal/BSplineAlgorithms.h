@@ -9,6 +9,7 @@
 #define BSPLINEALGORITHMS_H
 
 #include "ApproxResult.h"
+#include "IntersectBSplines.h"
 
 #include <Geom_BSplineCurve.hxx>
 #include <Geom_BSplineSurface.hxx>
@@ -17,6 +18,7 @@
 #include <TColStd_Array1OfInteger.hxx>
 #include <TColStd_Array1OfReal.hxx>
 #include <TColStd_HArray1OfReal.hxx>
+#include <gp_XYZ.hxx>
 
 #include <utility>
 #include <vector>
@@ -27,6 +29,9 @@
 namespace occ_gordon_internal
 {
 
+class ApproxSystemCache;
+class TaskMonitor;
+
 enum class SurfaceDirection
 {
     u,
@@ -34,6 +39,16 @@ enum class SurfaceDirection
     both
 };
 
+/// Defines, how the curves of the network are reparametrized to become compatible
+enum class ReparametrizationMode
+{
+    /// Samples the reparametrized curve and approximates it with a smooth parametrization
+    Approximation,
+    /// Composes the curve exactly with a piecewise linear reparametrization function.
+    /// The knots at the joints are reduced within the spatial tolerance
+    ExactComposition
+};
+
 
 class BSplineAlgorithms
 {
@@ -78,6 +93,32 @@ public:
      */
     static math_Matrix bsplineBasisMat(int degree, const TColStd_Array1OfReal& flatKnots, const TColStd_Array1OfReal& params, unsigned int derivOrder=0);
 
+    /**
+     * @brief evaluateCurveSorted:
+     *          Evaluates the curve or one of its derivatives at many parameters at once.
+     *          The knot spans are walked incrementally and the polynomial of each span is reused
+     *          for all parameters inside the span. Hence, the parameters should be sorted ascending.
+     * @param params:
+     *          Parameters of the evaluation, preferably in ascending order
+     * @param derivOrder:
+     *          0 for the curve points, 1 or 2 for the derivatives
+     * @return
+     *          Contiguous buffer with the points or derivatives at the parameters
+     */
+    static std::vector<gp_XYZ> evaluateCurveSorted(const Handle(Geom_BSplineCurve)& curve, const std::vector<double>& params, unsigned int derivOrder=0);
+
+    /**
+     * @brief evaluateCurvesSorted:
+     *          Evaluates several curves at the same parameters. If the curves share degree
+     *          and knots, the basis functions are computed only once per parameter.
+     *          Otherwise, each curve is evaluated separately.
+     * @param params:
+     *          Parameters of the evaluation, preferably in ascending order
+     * @return
+     *          The point of curve j at parameter i is stored at index i * curves.size() + j
+     */
+    static std::vector<gp_XYZ> evaluateCurvesSorted(const std::vector<Handle(Geom_BSplineCurve)>& curves, const std::vector<double>& params);
+
     /**
      * @brief computeParamsBSplineSurf:
      *          Computes the parameters of a Geom_BSplineSurface at the given points
@@ -110,7 +151,8 @@ public:
      *          The common knot vector contains all knots of all splines with the highest multiplicity of all splines.
      * @param splines_vector:
      *          vector of B-splines that could have a different knot vector
-     * @return the given vector of B-splines with a common knot vector, the B-spline geometry isn't changed
+     * @return the given vector of B-splines with a common knot vector, the B-spline geometry isn't changed.
+     *         The input B-splines are not modified.
      */
     static std::vector<Handle(Geom_BSplineCurve)> createCommonKnotsVectorCurve(const std::vector<Handle(Geom_BSplineCurve)>& splines_vector, double tol);
 
@@ -145,11 +187,42 @@ public:
      *          array of the old parameters that shall have the values of the new parameters
      * @param new_parameters:
      *          array of the new parameters the old parameters should become
+     * @param cache:
+     *          optional cache of factorized approximation systems. Curves that are reparametrized onto the
+     *          same new parameters with the same number of control points can share the factorization.
+     * @param min_samples:
+     *          minimum number of points sampled from the B-spline for the approximation.
+     *          At least twice the number of control points are sampled.
+     * @param optimization_iterations:
+     *          number of iterations of the parameter optimization of the approximation
      * @return
      *          the continuously reparametrized given B-spline
      */
     static ApproxResult reparametrizeBSplineContinuouslyApprox(const Handle(Geom_BSplineCurve) spline, const std::vector<double>& old_parameters,
-                                                                                const std::vector<double>& new_parameters, size_t n_control_pnts);
+                                                                                const std::vector<double>& new_parameters, size_t n_control_pnts,
+                                                                                ApproxSystemCache* cache = nullptr,
+                                                                                size_t min_samples = 101, int optimization_iterations = 1);
+
+    /**
+     * @brief reparametrizeBSplineExact:
+     *          Reparametrizes a given B-spline by composing it with the piecewise linear function,
+     *          that maps the new parameters onto the old parameters.
+     *          In contrast to reparametrizeBSplineContinuouslyApprox, the geometry and degree of the
+     *          B-spline remain exactly the same. However, the parametric derivatives are only continuous
+     *          at the old parameters, if the knots can be removed there within the tolerance.
+     * @param old_parameters:
+     *          array of the old parameters that shall have the values of the new parameters, strictly ascending
+     * @param new_parameters:
+     *          array of the new parameters the old parameters should become, strictly ascending
+     * @param knot_removal_tol:
+     *          absolute tolerance for removing the knots at the old parameters after the composition.
+     *          No knots are removed, if the tolerance is not positive.
+     * @return
+     *          the reparametrized B-spline. The error is the deviation caused by the knot removal
+     *          and zero, if no knot could be removed
+     */
+    static ApproxResult reparametrizeBSplineExact(const Handle(Geom_BSplineCurve) spline, const std::vector<double>& old_parameters,
+                                                  const std::vector<double>& new_parameters, double knot_removal_tol = 0.);
 
     /**
      * @brief flipSurface:
@@ -175,13 +248,16 @@ public:
      *          Make a continuous junction in u d-directions, if the u direction is closed
      * @param vContinuousIfClosed:
      *          Make a continuous junction in v d-directions, if the v direction is closed
+     * @param uDegree, vDegree:
+     *          Maximum interpolation degrees. The degree is lower, if there are too few points.
      * @return
      *          B-spline surface which interpolates the given points with the given parameters
      */
     static Handle(Geom_BSplineSurface) pointsToSurface(const TColgp_Array2OfPnt& points,
                                                                    const std::vector<double>& uParams,
                                                                    const std::vector<double>& vParams,
-                                                                   bool uContinuousIfClosed, bool vContinuousIfClosed);
+                                                                   bool uContinuousIfClosed, bool vContinuousIfClosed,
+                                                                   int uDegree = 3, int vDegree = 3);
 
     /**
      * @brief intersections:
@@ -192,10 +268,13 @@ public:
      *          second B-spline
      * @param tolerance
      *          relative tolerance to check intersection (relative to overall size)
+     * @param options
+     *          settings of the subdivision and the local optimization of the intersection algorithm
      * @return:
      *          intersections of spline1 with spline2 as a vector of (parameter of spline1, parameter of spline2)-pairs
      */
-    static std::vector<std::pair<double, double> > intersections(const Handle(Geom_BSplineCurve) spline1, const Handle(Geom_BSplineCurve) spline2, double tolerance=3e-4);
+    static std::vector<std::pair<double, double> > intersections(const Handle(Geom_BSplineCurve) spline1, const Handle(Geom_BSplineCurve) spline2, double tolerance=3e-4,
+                                                                 const IntersectBSplinesOptions& options = IntersectBSplinesOptions());
 
     /**
      * @brief scale:
@@ -239,6 +318,76 @@ public:
     static SurfaceKinks getKinkParameters(const Handle(Geom_BSplineSurface)& surface);
 
 
+    struct SurfaceKnotRemovalResult {
+        Handle(Geom_BSplineSurface) surface;
+        int nPolesBefore;
+        int nPolesAfter;
+        double maxDeviation;
+    };
+
+    /**
+     * @brief removeSurfaceKnots:
+     *          Reduces the number of poles of the surface by removing knots in both directions
+     *          as long as the surface stays within the tolerance of the input surface.
+     *
+     *          All removal candidates are tried in parallel. The successful ones are applied
+     *          in the order of their deviation and verified again on the reduced surface,
+     *          until no further knot can be removed. The deviation is measured on a dense
+     *          sampling of the input surface.
+     * @param surface:
+     *          surface to be reduced. It is not modified.
+     * @param tolerance:
+     *          maximum allowed deviation from the input surface
+     * @param monitor:
+     *          optional monitor, which receives the progress of each removal pass.
+     *          A cancellation is checked for each removal candidate.
+     * @return
+     *          the reduced surface, the pole counts before and after and the maximum sampled deviation.
+     *          If the tolerance is not positive, the input surface itself is returned.
+     */
+    static SurfaceKnotRemovalResult removeSurfaceKnots(const Handle(Geom_BSplineSurface)& surface, double tolerance,
+                                                       TaskMonitor* monitor = nullptr);
+
+    /**
+     * @brief makePatchesCompatible:
+     *          Makes a grid of B-spline patches compatible and joins them with C1 continuity
+     *
+     *          Patch (i, j) is stored at index i * nPatchesV + j. All patches of a column i must share
+     *          their u range, all patches of a row j their v range and neighboring patches must
+     *          meet at their boundaries, at least approximately.
+     *          The patches are elevated to a common degree and get common knots in u per column and
+     *          in v per row. Then, the poles at the seams are averaged and the neighboring pole rows
+     *          are moved symmetrically, such that the first derivatives across the seams match.
+     *          A seam line, whose C1 join would move a pole further than the tolerance, is only
+     *          joined with C0 continuity.
+     * @param patches:
+     *          the non-rational, non-periodic patches. They are not modified.
+     * @param tolerance:
+     *          maximum distance of the poles and hence of the surface from the original patches,
+     *          apart from averaging the poles of the seams
+     * @param continuityU:
+     *          optional output of the continuity (0 or 1) of the nPatchesU - 1 seams between the patch columns
+     * @param continuityV:
+     *          optional output of the continuity (0 or 1) of the nPatchesV - 1 seams between the patch rows
+     * @return
+     *          the compatible patches in the same order
+     */
+    static std::vector<Handle(Geom_BSplineSurface)> makePatchesCompatible(const std::vector<Handle(Geom_BSplineSurface)>& patches,
+                                                                          size_t nPatchesU, size_t nPatchesV, double tolerance,
+                                                                          std::vector<int>* continuityU = nullptr,
+                                                                          std::vector<int>* continuityV = nullptr);
+
+    /**
+     * @brief mergePatches:
+     *          Merges a grid of compatible patches (see makePatchesCompatible) into a single surface
+     *
+     *          The seams become knots of multiplicity degree. Their multiplicity is reduced by one afterwards,
+     *          if the surface stays within the tolerance.
+     */
+    static Handle(Geom_BSplineSurface) mergePatches(const std::vector<Handle(Geom_BSplineSurface)>& patches,
+                                                    size_t nPatchesU, size_t nPatchesV, double tolerance);
+
+
     /// Checks, whether the point matrix points is closed in u direction
     static bool isUDirClosed(const TColgp_Array2OfPnt& points, double tolerance);
 
@@ -6,6 +6,10 @@
 */
 
 #include "BSplineApproxInterp.h"
+#include "ApproxSystemCache.h"
+#include "BSplineCurveEvaluator.h"
+#include "LinearAlgebra.h"
+#include "Parallel.h"
 
 #include "internal/Error.h"
 
@@ -21,7 +25,6 @@
 #include <algorithm>
 #include <BSplCLib.hxx>
 #include <math_Matrix.hxx>
-#include <math_Gauss.hxx>
 
 namespace
 {
@@ -79,6 +82,7 @@ BSplineApproxInterp::BSplineApproxInterp(const TColgp_Array1OfPnt& points, int n
     , m_degree(degree)
     , m_ncp(nControlPoints)
     , m_C2Continuous(continuous_if_closed)
+    , m_cache(nullptr)
 {
     for (Standard_Integer i = 0; i < points.Length(); ++i) {
         size_t idx = static_cast<size_t>(i);
@@ -101,6 +105,11 @@ void BSplineApproxInterp::InterpolatePoint(size_t pointIndex, bool withKink)
     }
 }
 
+void BSplineApproxInterp::SetSystemCache(ApproxSystemCache* cache)
+{
+    m_cache = cache;
+}
+
 double BSplineApproxInterp::maxDistanceOfBoundingBox(const TColgp_Array1OfPnt& points) const
 {
     gp_Pnt max(-DBL_MAX, -DBL_MAX, -DBL_MAX);
@@ -258,7 +267,9 @@ ApproxResult BSplineApproxInterp::FitCurveOptimal(const std::vector<double>& ini
         old_error = result.error;
 
         optimizeParameters(result.curve, parms);
-        result = solve(parms, occKnots->Array1(), occMults->Array1());
+
+        // only the system of the initial parameters can be shared with other curves
+        result = solve(parms, occKnots->Array1(), occMults->Array1(), false);
 
         iteration++;
     }
@@ -266,7 +277,7 @@ ApproxResult BSplineApproxInterp::FitCurveOptimal(const std::vector<double>& ini
     return result;
 }
 
-ProjectResult BSplineApproxInterp::projectOnCurve(const gp_Pnt& pnt, const Handle(Geom_Curve) &curve, double initial_Parm) const
+ProjectResult BSplineApproxInterp::projectOnCurve(const gp_Pnt& pnt, const BSplineCurveEvaluator& curve, double initial_Parm, int& spanHint) const
 {
     const int maxIter = 10; // maximum No of iterations
     const double eps  = 1.0E-6; // accuracy of arc length parameter
@@ -281,24 +292,25 @@ ProjectResult BSplineApproxInterp::projectOnCurve(const gp_Pnt& pnt, const Handl
     int iter = 0; // iteration counter
     do { // Newton iteration to get a better t parameter
 
-        // Get the derivatives of the spline wrt parameter t
-        gp_Vec p   = curve->DN(t, 0);
-        gp_Vec dp  = curve->DN(t, 1);
-        gp_Vec d2p = curve->DN(t, 2);
-
+        // Get the point and its derivatives wrt parameter t in one pass
+        gp_XYZ ders[3];
+        curve.Derivatives(t, 2, ders, spanHint);
+        const gp_XYZ& p   = ders[0];
+        const gp_XYZ& dp  = ders[1];
+        const gp_XYZ& d2p = ders[2];
 
         // compute objective function and their derivative
-        f = pnt.SquareDistance(p.XYZ());
+        f = (p - pnt.XYZ()).SquareModulus();
 
-        double df = (p.XYZ() - pnt.XYZ()).Dot(dp.XYZ());
-        double d2f = (p.XYZ() - pnt.XYZ()).Dot(d2p.XYZ()) + dp.SquareMagnitude();
+        double df = (p - pnt.XYZ()).Dot(dp);
+        double d2f = (p - pnt.XYZ()).Dot(d2p) + dp.SquareModulus();
 
         // newton iterate
         dt = -df / d2f;
         double t_new = t + dt;
 
         // if parameter out of range reset it to the start value
-        if (t_new < curve->FirstParameter() || t_new > curve->LastParameter()) {
+        if (t_new < curve.FirstParameter() || t_new > curve.LastParameter()) {
             t_new = initial_Parm;
             dt = 0.;
         }
@@ -337,7 +349,8 @@ math_Matrix BSplineApproxInterp::getContinuityMatrix(int nCtrPnts, int contin_co
     return continuity_entries;
 }
 
-ApproxResult BSplineApproxInterp::solve(const std::vector<double>& params, const TColStd_Array1OfReal& knots, const TColStd_Array1OfInteger& mults) const
+ApproxResult BSplineApproxInterp::solve(const std::vector<double>& params, const TColStd_Array1OfReal& knots, const TColStd_Array1OfInteger& mults,
+                                       bool useCache) const
 {
 
     // compute flat knots to solve system
@@ -371,107 +384,69 @@ ApproxResult BSplineApproxInterp::solve(const std::vector<double>& params, const
         throw error("Wrong number of control points for curve interpolation!");
     }
 
-    // Build left hand side of the equation
+    // The system matrix only depends on the structure of the fit and
+    // can be shared with other curves using the same parameters
+    std::shared_ptr<const ApproxSystem> system;
+    ApproxSystemKey key;
+    const bool cached = m_cache && useCache;
+    if (cached) {
+        key.degree = m_degree;
+        key.nContinuityConditions = n_continuityConditions;
+        for (Standard_Integer iknot = flatKnots.Lower(); iknot <= flatKnots.Upper(); ++iknot) {
+            key.flatKnots.push_back(flatKnots.Value(iknot));
+        }
+        key.params = params;
+        key.interpolatedIndices = m_indexOfInterpolated;
+        system = m_cache->Find(key);
+    }
+
+    if (!system) {
+        system = buildSystem(params, flatKnots, nCtrPnts, n_continuityConditions, makeClosed);
+        if (cached) {
+            m_cache->Insert(key, system);
+        }
+    }
+
     Standard_Integer n_vars = nCtrPnts + n_intpolated + n_continuityConditions;
-    math_Matrix lhs(1, n_vars, 1, n_vars);
-    lhs.Init(0.);
-    
-    // Allocate right hand side
-    math_Vector rhsx(1, n_vars);
-    math_Vector rhsy(1, n_vars);
-    math_Vector rhsz(1, n_vars);
+
+    // Allocate right hand side, one column per coordinate
+    math_Matrix rhs(1, n_vars, 1, 3, 0.);
 
     if (n_apprxmated > 0) {
-        // Write b vector. These are the points to be approximated
-        TColStd_Array1OfReal appParams(1, n_apprxmated);
-        math_Vector bx(1, n_apprxmated);
-        math_Vector by(1, n_apprxmated);
-        math_Vector bz(1, n_apprxmated);
+        // Write b matrix. These are the points to be approximated
+        math_Matrix b(1, n_apprxmated, 1, 3);
     
         Standard_Integer appIndex = 1;
         for (std::vector<size_t>::const_iterator it_idx = m_indexOfApproximated.begin(); it_idx != m_indexOfApproximated.end(); ++it_idx) {
             Standard_Integer ipnt = static_cast<Standard_Integer>(*it_idx + 1);
             const gp_Pnt& p = m_pnts.Value(ipnt);
-            bx(appIndex) = p.X();
-            by(appIndex) = p.Y();
-            bz(appIndex) = p.Z();
-            appParams(appIndex) = params[*it_idx];
+            b(appIndex, 1) = p.X();
+            b(appIndex, 2) = p.Y();
+            b(appIndex, 3) = p.Z();
             appIndex++;
         }
 
-        // Solve constrained linear least squares
-        // min(Ax - b) s.t. Cx = d
-        // Create left hand side block matrix
-        // A.T*A  C.T
-        // C      0
-        math_Matrix A = BSplineAlgorithms::bsplineBasisMat(m_degree, flatKnots, appParams);
-        math_Matrix At = A.Transposed();
-
-        lhs.Set(1, nCtrPnts, 1, nCtrPnts, At.Multiplied(A));
-
-        rhsx.Set(1, nCtrPnts, At.Multiplied(bx));
-        rhsy.Set(1, nCtrPnts, At.Multiplied(by));
-        rhsz.Set(1, nCtrPnts, At.Multiplied(bz));
-    }
-
-    if (n_intpolated + n_continuityConditions > 0) {
-        // Write d vector. These are the points that should be interpolated as well as the continuity constraints for closed curve
-        math_Vector dx(1, n_intpolated + n_continuityConditions, 0.);
-        math_Vector dy(1, n_intpolated + n_continuityConditions, 0.);
-        math_Vector dz(1, n_intpolated + n_continuityConditions, 0.);
-        if(n_intpolated > 0) {
-            TColStd_Array1OfReal interpParams(1, n_intpolated);
-            Standard_Integer intpIndex = 1;
-            for (std::vector<size_t>::const_iterator it_idx = m_indexOfInterpolated.begin(); it_idx != m_indexOfInterpolated.end(); ++it_idx) {
-                Standard_Integer ipnt = static_cast<Standard_Integer>(*it_idx + 1);
-                const gp_Pnt& p = m_pnts.Value(ipnt);
-                dx(intpIndex) = p.X();
-                dy(intpIndex) = p.Y();
-                dz(intpIndex) = p.Z();
-                interpParams(intpIndex) = params[*it_idx];
-                intpIndex++;
-            }
-            math_Matrix C = BSplineAlgorithms::bsplineBasisMat(m_degree, flatKnots, interpParams);
-            math_Matrix Ct = C.Transposed();
-            lhs.Set(1, nCtrPnts, nCtrPnts + 1, nCtrPnts + n_intpolated, Ct);
-            lhs.Set(nCtrPnts + 1,  nCtrPnts + n_intpolated, 1, nCtrPnts, C);
-        }
-
-        // sets the C2 continuity constraints for closed curves on the left hand side if requested
-        if (makeClosed) {
-            math_Matrix continuity_entries = getContinuityMatrix(nCtrPnts, n_continuityConditions, params, flatKnots);
-            lhs.Set(nCtrPnts + n_intpolated + 1, nCtrPnts + n_intpolated + n_continuityConditions, 1, nCtrPnts, continuity_entries);
-            lhs.Set(1, nCtrPnts, nCtrPnts + n_intpolated + 1, nCtrPnts + n_intpolated + n_continuityConditions, continuity_entries.Transposed());
-        }
-        rhsx.Set(nCtrPnts + 1, n_vars, dx);
-        rhsy.Set(nCtrPnts + 1, n_vars, dy);
-        rhsz.Set(nCtrPnts + 1, n_vars, dz);
-    }
-
-    math_Gauss solver(lhs);
-
-    math_Vector cp_x(1, n_vars);
-    math_Vector cp_y(1, n_vars);
-    math_Vector cp_z(1, n_vars);
-
-    solver.Solve(rhsx, cp_x);
-    if (!solver.IsDone()) {
-        throw error("Singular Matrix", MATH_ERROR);
+        rhs.Set(1, nCtrPnts, 1, 3, system->At->Multiplied(b));
     }
 
-    solver.Solve(rhsy, cp_y);
-    if (!solver.IsDone()) {
-        throw error("Singular Matrix", MATH_ERROR);
+    // Write d vector. These are the points that should be interpolated.
+    // The continuity constraints for closed curve have a zero right hand side.
+    Standard_Integer intpIndex = nCtrPnts + 1;
+    for (std::vector<size_t>::const_iterator it_idx = m_indexOfInterpolated.begin(); it_idx != m_indexOfInterpolated.end(); ++it_idx) {
+        Standard_Integer ipnt = static_cast<Standard_Integer>(*it_idx + 1);
+        const gp_Pnt& p = m_pnts.Value(ipnt);
+        rhs(intpIndex, 1) = p.X();
+        rhs(intpIndex, 2) = p.Y();
+        rhs(intpIndex, 3) = p.Z();
+        intpIndex++;
     }
 
-    solver.Solve(rhsz, cp_z);
-    if (!solver.IsDone()) {
-        throw error("Singular Matrix", MATH_ERROR);
-    }
+    math_Matrix cp(1, n_vars, 1, 3);
+    system->solver.Solve(rhs, cp);
 
     TColgp_Array1OfPnt poles(1, nCtrPnts);
     for (Standard_Integer icp = 1; icp <= nCtrPnts; ++icp) {
-        gp_Pnt pnt(cp_x.Value(icp), cp_y.Value(icp), cp_z.Value(icp));
+        gp_Pnt pnt(cp(icp, 1), cp(icp, 2), cp(icp, 3));
         poles.SetValue(icp, pnt);
     }
     
@@ -479,13 +454,19 @@ ApproxResult BSplineApproxInterp::solve(const std::vector<double>& params, const
     result.curve = new Geom_BSplineCurve(poles, knots, mults, m_degree, false);
 
     // compute error
-    double max_error = 0.;
+    std::vector<double> approxParams;
+    approxParams.reserve(m_indexOfApproximated.size());
     for (std::vector<size_t>::const_iterator it_idx = m_indexOfApproximated.begin(); it_idx != m_indexOfApproximated.end(); ++it_idx) {
-        Standard_Integer ipnt = static_cast<Standard_Integer>(*it_idx + 1);
+        approxParams.push_back(params[*it_idx]);
+    }
+    std::vector<gp_XYZ> curvePoints = BSplineAlgorithms::evaluateCurveSorted(result.curve, approxParams);
+
+    double max_error = 0.;
+    for (size_t i = 0; i < m_indexOfApproximated.size(); ++i) {
+        Standard_Integer ipnt = static_cast<Standard_Integer>(m_indexOfApproximated[i] + 1);
         const gp_Pnt& p = m_pnts.Value(ipnt);
-        double par = params[*it_idx];
 
-        double error = result.curve->Value(par).Distance(p);
+        double error = (curvePoints[i] - p.XYZ()).Modulus();
         max_error = std::max(max_error, error);
     }
     result.error = max_error;
@@ -493,21 +474,93 @@ ApproxResult BSplineApproxInterp::solve(const std::vector<double>& params, const
     return result;
 }
 
+std::shared_ptr<const ApproxSystem> BSplineApproxInterp::buildSystem(const std::vector<double>& params, const TColStd_Array1OfReal& flatKnots,
+                                                                     int nCtrPnts, int n_continuityConditions, bool makeClosed) const
+{
+    Standard_Integer n_apprxmated = static_cast<Standard_Integer>(m_indexOfApproximated.size());
+    Standard_Integer n_intpolated = static_cast<Standard_Integer>(m_indexOfInterpolated.size());
+
+    // Build left hand side of the equation
+    Standard_Integer n_vars = nCtrPnts + n_intpolated + n_continuityConditions;
+    math_Matrix lhs(1, n_vars, 1, n_vars);
+    lhs.Init(0.);
+
+    std::unique_ptr<math_Matrix> At;
+    if (n_apprxmated > 0) {
+        TColStd_Array1OfReal appParams(1, n_apprxmated);
+        Standard_Integer appIndex = 1;
+        for (std::vector<size_t>::const_iterator it_idx = m_indexOfApproximated.begin(); it_idx != m_indexOfApproximated.end(); ++it_idx) {
+            appParams(appIndex) = params[*it_idx];
+            appIndex++;
+        }
+
+        // Solve constrained linear least squares
+        // min(Ax - b) s.t. Cx = d
+        // Create left hand side block matrix
+        // A.T*A  C.T
+        // C      0
+        math_Matrix A = BSplineAlgorithms::bsplineBasisMat(m_degree, flatKnots, appParams);
+        At.reset(new math_Matrix(A.Transposed()));
+
+        lhs.Set(1, nCtrPnts, 1, nCtrPnts, TransposeMultiply(A, A));
+    }
+
+    if(n_intpolated > 0) {
+        TColStd_Array1OfReal interpParams(1, n_intpolated);
+        Standard_Integer intpIndex = 1;
+        for (std::vector<size_t>::const_iterator it_idx = m_indexOfInterpolated.begin(); it_idx != m_indexOfInterpolated.end(); ++it_idx) {
+            interpParams(intpIndex) = params[*it_idx];
+            intpIndex++;
+        }
+        math_Matrix C = BSplineAlgorithms::bsplineBasisMat(m_degree, flatKnots, interpParams);
+        math_Matrix Ct = C.Transposed();
+        lhs.Set(1, nCtrPnts, nCtrPnts + 1, nCtrPnts + n_intpolated, Ct);
+        lhs.Set(nCtrPnts + 1,  nCtrPnts + n_intpolated, 1, nCtrPnts, C);
+    }
+
+    // sets the C2 continuity constraints for closed curves on the left hand side if requested
+    if (makeClosed) {
+        math_Matrix continuity_entries = getContinuityMatrix(nCtrPnts, n_continuityConditions, params, flatKnots);
+        lhs.Set(nCtrPnts + n_intpolated + 1, nCtrPnts + n_intpolated + n_continuityConditions, 1, nCtrPnts, continuity_entries);
+        lhs.Set(1, nCtrPnts, nCtrPnts + n_intpolated + 1, nCtrPnts + n_intpolated + n_continuityConditions, continuity_entries.Transposed());
+    }
+
+    std::shared_ptr<const ApproxSystem> system = std::make_shared<ApproxSystem>(lhs, std::move(At));
+    if (!system->solver.IsDone()) {
+        throw error("Singular Matrix", MATH_ERROR);
+    }
+
+    return system;
+}
+
 /**
  * @brief Recalculates the curve parameters t_k after the
  * control points are fitted to achieve an even better fit.
  */
-void BSplineApproxInterp::optimizeParameters(const Handle(Geom_Curve)& curve, std::vector<double>& m_t) const
+void BSplineApproxInterp::optimizeParameters(const Handle(Geom_BSplineCurve)& curve, std::vector<double>& m_t) const
 {
-    // optimize each parameter by finding it's position on the curve
-    for (std::vector<size_t>::const_iterator it_idx = m_indexOfApproximated.begin(); it_idx != m_indexOfApproximated.end(); ++it_idx) {
-        size_t idx = *it_idx;
-
-        ProjectResult res = projectOnCurve(m_pnts.Value(static_cast<Standard_Integer>(idx + 1)), curve, m_t[idx]);
-
-        // store optimised parameter
-        m_t[idx] = res.parameter;
-    }
+    BSplineCurveEvaluator evaluator(curve);
+
+    // The approximated points are sorted by their parameter. Each chunk
+    // is projected sequentially, such that the knot span of the previous
+    // point is a good guess for the next one.
+    const int chunkSize = 64;
+    const int nApprox = static_cast<int>(m_indexOfApproximated.size());
+    const int nChunks = (nApprox + chunkSize - 1) / chunkSize;
+
+    ParallelFor(0, nChunks, [&](int ichunk) {
+        int spanHint = -1;
+        int last = std::min(nApprox, (ichunk + 1) * chunkSize);
+        for (int i = ichunk * chunkSize; i < last; ++i) {
+            size_t idx = m_indexOfApproximated[static_cast<size_t>(i)];
+
+            // optimize each parameter by finding it's position on the curve
+            ProjectResult res = projectOnCurve(m_pnts.Value(static_cast<Standard_Integer>(idx + 1)), evaluator, m_t[idx], spanHint);
+
+            // store optimised parameter
+            m_t[idx] = res.parameter;
+        }
+    });
 }
 
 } // namespace occ_gordon_internal
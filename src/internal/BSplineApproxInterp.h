@@ -12,6 +12,7 @@
 
 #include "ApproxResult.h"
 
+#include <memory>
 #include <vector>
 #include <Geom_BSplineCurve.hxx>
 #include <TColStd_Array1OfReal.hxx>
@@ -23,6 +24,10 @@ class gp_Pnt;
 
 namespace occ_gordon_internal {
 
+class ApproxSystemCache;
+class BSplineCurveEvaluator;
+struct ApproxSystem;
+
 struct ProjectResult
 {
     ProjectResult(double p, double e)
@@ -49,15 +54,24 @@ public:
     /// Important: Parameters of points that are interpolated are not optimized
     ApproxResult FitCurveOptimal(const std::vector<double>& initialParms = std::vector<double>(), int maxIter=10) const;
 
+    /// Sets a cache for the factorized linear systems, which may be shared
+    /// between several approximation objects. The cache is not owned.
+    void SetSystemCache(ApproxSystemCache* cache);
+
 private:
-    ProjectResult projectOnCurve(const gp_Pnt& pnt, const Handle(Geom_Curve)& curve, double initial_Parm) const;
+    ProjectResult projectOnCurve(const gp_Pnt& pnt, const BSplineCurveEvaluator& curve, double initial_Parm, int& spanHint) const;
     std::vector<double> computeParameters(double alpha) const;
     void computeKnots(int ncp, const std::vector<double>& params, std::vector<double>& knots, std::vector<int>& mults) const;
     
-    ApproxResult solve(const std::vector<double>& params, const TColStd_Array1OfReal& knots, const TColStd_Array1OfInteger& mults) const;
+    // useCache: whether the system is looked up in and stored to the system cache. Systems of
+    // optimized parameters are unique to one curve and would only evict the shared systems.
+    ApproxResult solve(const std::vector<double>& params, const TColStd_Array1OfReal& knots, const TColStd_Array1OfInteger& mults,
+                       bool useCache = true) const;
+    std::shared_ptr<const ApproxSystem> buildSystem(const std::vector<double>& params, const TColStd_Array1OfReal& flatKnots,
+                                                    int nCtrPnts, int n_continuityConditions, bool makeClosed) const;
     math_Matrix getContinuityMatrix(int nCtrPnts, int contin_cons, const std::vector<double>& params, const TColStd_Array1OfReal& flatKnots) const;
 
-    void optimizeParameters(const Handle(Geom_Curve)& curve, std::vector<double>& parms) const;
+    void optimizeParameters(const Handle(Geom_BSplineCurve)& curve, std::vector<double>& parms) const;
 
     bool isClosed() const;
     bool firstAndLastInterpolated() const;
@@ -80,6 +94,9 @@ private:
 
     /// determines the continuous closing of curve
     bool  m_C2Continuous;
+
+    /// optional cache of factorized systems
+    ApproxSystemCache* m_cache;
 };
 
 } // namespace occ_gordon_internal
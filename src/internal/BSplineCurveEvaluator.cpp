@@ -0,0 +1,507 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+#include "BSplineCurveEvaluator.h"
+
+#include "internal/Error.h"
+
+#include <TColStd_Array1OfReal.hxx>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+// Geom_BSplineCurve::MaxDegree()
+const int MAX_DEGREE = 25;
+const int MAX_ORDER = MAX_DEGREE + 1;
+const int MAX_DERIV = 2;
+
+double factorial(int n)
+{
+    double result = 1.;
+    for (int i = 2; i <= n; ++i) {
+        result *= i;
+    }
+    return result;
+}
+
+Handle(Geom_BSplineCurve) nonPeriodic(const Handle(Geom_BSplineCurve)& curve)
+{
+    if (!curve->IsPeriodic()) {
+        return curve;
+    }
+    Handle(Geom_BSplineCurve) copy = Handle(Geom_BSplineCurve)::DownCast(curve->Copy());
+    copy->SetNotPeriodic();
+    return copy;
+}
+
+std::vector<double> flatKnotsOf(const Handle(Geom_BSplineCurve)& curve)
+{
+    TColStd_Array1OfReal flatKnots(1, curve->NbPoles() + curve->Degree() + 1);
+    curve->KnotSequence(flatKnots);
+
+    std::vector<double> result;
+    result.reserve(static_cast<size_t>(flatKnots.Length()));
+    for (int i = flatKnots.Lower(); i <= flatKnots.Upper(); ++i) {
+        result.push_back(flatKnots.Value(i));
+    }
+    return result;
+}
+
+// Returns the index i of the knot span [U_i, U_i+1) containing t,
+// where n + 1 is the number of poles
+int findSpan(const std::vector<double>& flatKnots, int p, int n, double t, int hint)
+{
+    if (t >= flatKnots[static_cast<size_t>(n + 1)]) {
+        return n;
+    }
+    if (t <= flatKnots[static_cast<size_t>(p)]) {
+        return p;
+    }
+
+    // check the hint and its successor first, which is the
+    // typical case for sorted parameters
+    if (hint >= p && hint <= n) {
+        for (int span = hint; span <= std::min(hint + 1, n); ++span) {
+            if (flatKnots[static_cast<size_t>(span)] <= t && t < flatKnots[static_cast<size_t>(span + 1)]) {
+                return span;
+            }
+        }
+    }
+
+    // binary search for the last knot <= t
+    std::vector<double>::const_iterator first = flatKnots.begin() + p;
+    std::vector<double>::const_iterator last = flatKnots.begin() + n + 1;
+    return static_cast<int>(std::upper_bound(first, last, t) - flatKnots.begin()) - 1;
+}
+
+// Computes the nonzero basis functions and their derivatives up to nDeriv.
+// ders has the layout [nDeriv + 1][p + 1]
+void basisFunctionDerivatives(const double* U, int p, int span, double t, int nDeriv, double* ders)
+{
+    // Algorithm A2.3 of "The NURBS Book", Piegl and Tiller
+
+    double ndu[MAX_ORDER][MAX_ORDER];
+    double left[MAX_ORDER];
+    double right[MAX_ORDER];
+    double a[2][MAX_ORDER + 1];
+
+    ndu[0][0] = 1.0;
+    for (int j = 1; j <= p; ++j) {
+        left[j] = t - U[span + 1 - j];
+        right[j] = U[span + j] - t;
+        double saved = 0.0;
+        for (int r = 0; r < j; ++r) {
+            // lower triangle
+            ndu[j][r] = right[r + 1] + left[j - r];
+            double temp = ndu[r][j - 1] / ndu[j][r];
+            // upper triangle
+            ndu[r][j] = saved + right[r + 1] * temp;
+            saved = left[j - r] * temp;
+        }
+        ndu[j][j] = saved;
+    }
+
+    for (int j = 0; j <= p; ++j) {
+        ders[j] = ndu[j][p];
+    }
+
+    const int nd = std::min(nDeriv, p);
+    for (int k = nd + 1; k <= nDeriv; ++k) {
+        for (int j = 0; j <= p; ++j) {
+            ders[k * (p + 1) + j] = 0.0;
+        }
+    }
+
+    for (int r = 0; r <= p; ++r) {
+        int s1 = 0;
+        int s2 = 1;
+        a[0][0] = 1.0;
+        for (int k = 1; k <= nd; ++k) {
+            double d = 0.0;
+            int rk = r - k;
+            int pk = p - k;
+            if (r >= k) {
+                a[s2][0] = a[s1][0] / ndu[pk + 1][rk];
+                d = a[s2][0] * ndu[rk][pk];
+            }
+            int j1 = rk >= -1 ? 1 : -rk;
+            int j2 = (r - 1 <= pk) ? k - 1 : p - r;
+            for (int j = j1; j <= j2; ++j) {
+                a[s2][j] = (a[s1][j] - a[s1][j - 1]) / ndu[pk + 1][rk + j];
+                d += a[s2][j] * ndu[rk + j][pk];
+            }
+            if (r <= pk) {
+                a[s2][k] = -a[s1][k - 1] / ndu[pk + 1][r];
+                d += a[s2][k] * ndu[r][pk];
+            }
+            ders[k * (p + 1) + r] = d;
+            std::swap(s1, s2);
+        }
+    }
+
+    // multiply through by the correct factors
+    int factor = p;
+    for (int k = 1; k <= nd; ++k) {
+        for (int j = 0; j <= p; ++j) {
+            ders[k * (p + 1) + j] *= factor;
+        }
+        factor *= (p - k);
+    }
+}
+
+} // namespace
+
+namespace occ_gordon_internal
+{
+
+int FindKnotSpan(const std::vector<double>& flatKnots, int degree, int nPoles, double t, int hint)
+{
+    return findSpan(flatKnots, degree, nPoles - 1, t, hint);
+}
+
+void BasisFunctionDerivatives(const double* flatKnots, int degree, int span, double t, int nDeriv, double* ders)
+{
+    if (degree > MAX_DEGREE || nDeriv < 0 || nDeriv > MAX_DEGREE) {
+        throw error("Invalid degree or derivative order in BasisFunctionDerivatives", INDEX_ERROR);
+    }
+    basisFunctionDerivatives(flatKnots, degree, span, t, nDeriv, ders);
+}
+
+BSplineCurveEvaluator::BSplineCurveEvaluator(const Handle(Geom_BSplineCurve)& inputCurve)
+{
+    if (inputCurve.IsNull()) {
+        throw error("Null pointer curve in BSplineCurveEvaluator", NULL_POINTER);
+    }
+
+    Handle(Geom_BSplineCurve) curve = nonPeriodic(inputCurve);
+
+    m_degree = curve->Degree();
+    if (m_degree > MAX_DEGREE) {
+        throw error("Degree too high in BSplineCurveEvaluator", MATH_ERROR);
+    }
+    m_rational = curve->IsRational();
+    m_flatKnots = flatKnotsOf(curve);
+
+    m_poles.reserve(static_cast<size_t>(curve->NbPoles()));
+    for (int i = 1; i <= curve->NbPoles(); ++i) {
+        m_poles.push_back(curve->Pole(i).XYZ());
+    }
+
+    if (m_rational) {
+        m_weights.reserve(static_cast<size_t>(curve->NbPoles()));
+        for (int i = 1; i <= curve->NbPoles(); ++i) {
+            m_weights.push_back(curve->Weight(i));
+        }
+    }
+}
+
+double BSplineCurveEvaluator::FirstParameter() const
+{
+    return m_flatKnots[static_cast<size_t>(m_degree)];
+}
+
+double BSplineCurveEvaluator::LastParameter() const
+{
+    return m_flatKnots[m_poles.size()];
+}
+
+int BSplineCurveEvaluator::FindSpan(double t, int hint) const
+{
+    return findSpan(m_flatKnots, m_degree, NbPoles() - 1, t, hint);
+}
+
+void BSplineCurveEvaluator::basisFunctions(int span, double t, int nDeriv, double* ders) const
+{
+    basisFunctionDerivatives(m_flatKnots.data(), m_degree, span, t, nDeriv, ders);
+}
+
+gp_Pnt BSplineCurveEvaluator::Value(double t, int& spanHint) const
+{
+    gp_XYZ p;
+    Derivatives(t, 0, &p, spanHint);
+    return gp_Pnt(p);
+}
+
+struct BSplineCurveEvaluator::SpanPolynomial
+{
+    int span = -1;
+    double mid = 0.;
+    double halfLength = 1.;
+
+    // coefficients in the normalized variable s = (t - mid) / halfLength
+    gp_XYZ coeffs[MAX_ORDER];
+    double weights[MAX_ORDER];
+};
+
+void BSplineCurveEvaluator::homogeneousDerivatives(int span, double t, int nDeriv, gp_XYZ* A, double* w) const
+{
+    const int p = m_degree;
+
+    double ders[MAX_ORDER * MAX_ORDER];
+    basisFunctions(span, t, nDeriv, ders);
+
+    const size_t firstPole = static_cast<size_t>(span - p);
+    for (int k = 0; k <= nDeriv; ++k) {
+        gp_XYZ sum(0., 0., 0.);
+        double wsum = 0.;
+        for (int j = 0; j <= p; ++j) {
+            size_t ipole = firstPole + static_cast<size_t>(j);
+            double nw = ders[k * (p + 1) + j];
+            if (m_rational) {
+                nw *= m_weights[ipole];
+            }
+            sum += m_poles[ipole] * nw;
+            wsum += nw;
+        }
+        A[k] = sum;
+        w[k] = wsum;
+    }
+}
+
+void BSplineCurveEvaluator::Derivatives(double t, int nDeriv, gp_XYZ* result, int& spanHint) const
+{
+    if (nDeriv < 0 || nDeriv > MAX_DERIV) {
+        throw error("Invalid derivative order in BSplineCurveEvaluator", INDEX_ERROR);
+    }
+
+    const int span = FindSpan(t, spanHint);
+    spanHint = span;
+
+    gp_XYZ A[MAX_DERIV + 1];
+    double w[MAX_DERIV + 1];
+    homogeneousDerivatives(span, t, nDeriv, A, w);
+
+    if (!m_rational) {
+        for (int k = 0; k <= nDeriv; ++k) {
+            result[k] = A[k];
+        }
+        return;
+    }
+
+    // rational curve: apply the quotient rule to the homogeneous coordinates
+    result[0] = A[0] / w[0];
+    if (nDeriv >= 1) {
+        result[1] = (A[1] - result[0] * w[1]) / w[0];
+    }
+    if (nDeriv >= 2) {
+        result[2] = (A[2] - result[1] * (2. * w[1]) - result[0] * w[2]) / w[0];
+    }
+}
+
+void BSplineCurveEvaluator::buildSpanPolynomial(int span, SpanPolynomial& poly) const
+{
+    const int p = m_degree;
+    const double t0 = m_flatKnots[static_cast<size_t>(span)];
+    const double t1 = m_flatKnots[static_cast<size_t>(span + 1)];
+
+    poly.span = span;
+    poly.mid = 0.5 * (t0 + t1);
+    poly.halfLength = 0.5 * (t1 - t0);
+
+    // Taylor expansion around the middle of the span, which is
+    // exact, since the curve is a polynomial inside the span
+    homogeneousDerivatives(span, poly.mid, p, poly.coeffs, poly.weights);
+
+    double scale = 1.;
+    for (int k = 0; k <= p; ++k) {
+        double factor = scale / factorial(k);
+        poly.coeffs[k] = poly.coeffs[k] * factor;
+        poly.weights[k] *= factor;
+        scale *= poly.halfLength;
+    }
+}
+
+void BSplineCurveEvaluator::EvaluateSorted(const double* params, size_t n, int derivOrder, gp_XYZ* result) const
+{
+    if (derivOrder < 0 || derivOrder > MAX_DERIV) {
+        throw error("Invalid derivative order in BSplineCurveEvaluator", INDEX_ERROR);
+    }
+
+    const int p = m_degree;
+    SpanPolynomial poly;
+
+    for (size_t i = 0; i < n; ++i) {
+        const double t = params[i];
+        const int span = FindSpan(t, poly.span);
+        if (span != poly.span) {
+            buildSpanPolynomial(span, poly);
+        }
+
+        // Horner scheme for the value and the first two derivatives wrt s
+        const double s = (t - poly.mid) / poly.halfLength;
+        gp_XYZ A0 = poly.coeffs[p], A1(0., 0., 0.), A2(0., 0., 0.);
+        double w0 = poly.weights[p], w1 = 0., w2 = 0.;
+        for (int k = p - 1; k >= 0; --k) {
+            A2 = A2 * s + A1;
+            A1 = A1 * s + A0;
+            A0 = A0 * s + poly.coeffs[k];
+            w2 = w2 * s + w1;
+            w1 = w1 * s + w0;
+            w0 = w0 * s + poly.weights[k];
+        }
+
+        // derivatives wrt t
+        const double dsdt = 1. / poly.halfLength;
+        A1 = A1 * dsdt;
+        A2 = A2 * (2. * dsdt * dsdt);
+        w1 *= dsdt;
+        w2 *= 2. * dsdt * dsdt;
+
+        if (!m_rational) {
+            result[i] = derivOrder == 0 ? A0 : (derivOrder == 1 ? A1 : A2);
+            continue;
+        }
+
+        gp_XYZ C0 = A0 / w0;
+        if (derivOrder == 0) {
+            result[i] = C0;
+            continue;
+        }
+        gp_XYZ C1 = (A1 - C0 * w1) / w0;
+        if (derivOrder == 1) {
+            result[i] = C1;
+            continue;
+        }
+        result[i] = (A2 - C1 * (2. * w1) - C0 * w2) / w0;
+    }
+}
+
+MultiCurveEvaluator::MultiCurveEvaluator(const std::vector<Handle(Geom_BSplineCurve)>& curves)
+    : m_degree(0)
+    , m_nCurves(curves.size())
+    , m_nPoles(0)
+    , m_rational(false)
+{
+    if (curves.empty()) {
+        throw error("No curves given to MultiCurveEvaluator");
+    }
+
+    if (!HaveCommonKnots(curves)) {
+        throw error("Curves of the MultiCurveEvaluator must have a common degree and knot vector", MATH_ERROR);
+    }
+
+    std::vector<Handle(Geom_BSplineCurve)> nonPeriodicCurves;
+    nonPeriodicCurves.reserve(curves.size());
+    for (const Handle(Geom_BSplineCurve)& curve : curves) {
+        nonPeriodicCurves.push_back(nonPeriodic(curve));
+        m_rational = m_rational || curve->IsRational();
+    }
+
+    const Handle(Geom_BSplineCurve)& first = nonPeriodicCurves.front();
+    m_degree = first->Degree();
+    if (m_degree > MAX_DEGREE) {
+        throw error("Degree too high in MultiCurveEvaluator", MATH_ERROR);
+    }
+    m_nPoles = static_cast<size_t>(first->NbPoles());
+    m_flatKnots = flatKnotsOf(first);
+
+    // structure of arrays: the coordinates of the same pole
+    // index are stored contiguously for all curves
+    m_x.resize(m_nPoles * m_nCurves);
+    m_y.resize(m_nPoles * m_nCurves);
+    m_z.resize(m_nPoles * m_nCurves);
+    if (m_rational) {
+        m_w.resize(m_nPoles * m_nCurves);
+    }
+
+    for (size_t icurve = 0; icurve < m_nCurves; ++icurve) {
+        const Handle(Geom_BSplineCurve)& curve = nonPeriodicCurves[icurve];
+        for (size_t ipole = 0; ipole < m_nPoles; ++ipole) {
+            int occIdx = static_cast<int>(ipole + 1);
+            const gp_Pnt& pole = curve->Pole(occIdx);
+            double weight = curve->IsRational() ? curve->Weight(occIdx) : 1.;
+
+            size_t idx = ipole * m_nCurves + icurve;
+            // rational curves are stored in homogeneous coordinates
+            m_x[idx] = pole.X() * weight;
+            m_y[idx] = pole.Y() * weight;
+            m_z[idx] = pole.Z() * weight;
+            if (m_rational) {
+                m_w[idx] = weight;
+            }
+        }
+    }
+}
+
+bool MultiCurveEvaluator::HaveCommonKnots(const std::vector<Handle(Geom_BSplineCurve)>& curves, double tolerance)
+{
+    if (curves.empty()) {
+        return true;
+    }
+
+    const Handle(Geom_BSplineCurve)& first = curves.front();
+    for (const Handle(Geom_BSplineCurve)& curve : curves) {
+        if (curve.IsNull()) {
+            throw error("Null pointer curve in MultiCurveEvaluator", NULL_POINTER);
+        }
+        if (curve->Degree() != first->Degree() || curve->NbKnots() != first->NbKnots() ||
+            curve->IsPeriodic() != first->IsPeriodic()) {
+            return false;
+        }
+        for (int iknot = 1; iknot <= curve->NbKnots(); ++iknot) {
+            if (curve->Multiplicity(iknot) != first->Multiplicity(iknot) ||
+                std::abs(curve->Knot(iknot) - first->Knot(iknot)) > tolerance) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void MultiCurveEvaluator::Evaluate(double t, gp_XYZ* result, int& spanHint) const
+{
+    const int p = m_degree;
+    const int span = findSpan(m_flatKnots, p, static_cast<int>(m_nPoles) - 1, t, spanHint);
+    spanHint = span;
+
+    // the basis functions are computed once for all curves
+    double basis[MAX_ORDER];
+    basisFunctionDerivatives(m_flatKnots.data(), p, span, t, 0, basis);
+
+    // the homogeneous coordinates are accumulated directly in the
+    // result, so that no buffers are allocated per parameter
+    for (size_t icurve = 0; icurve < m_nCurves; ++icurve) {
+        result[icurve].SetCoord(0., 0., 0.);
+    }
+
+    const size_t firstPole = static_cast<size_t>(span - p);
+    for (int j = 0; j <= p; ++j) {
+        const double N = basis[j];
+        const size_t offset = (firstPole + static_cast<size_t>(j)) * m_nCurves;
+        const double* px = m_x.data() + offset;
+        const double* py = m_y.data() + offset;
+        const double* pz = m_z.data() + offset;
+        for (size_t icurve = 0; icurve < m_nCurves; ++icurve) {
+            gp_XYZ& r = result[icurve];
+            r.SetCoord(r.X() + N * px[icurve], r.Y() + N * py[icurve], r.Z() + N * pz[icurve]);
+        }
+    }
+
+    if (!m_rational) {
+        return;
+    }
+
+    const double* pw = m_w.data() + firstPole * m_nCurves;
+    for (size_t icurve = 0; icurve < m_nCurves; ++icurve) {
+        double weight = 0.;
+        for (int j = 0; j <= p; ++j) {
+            weight += basis[j] * pw[static_cast<size_t>(j) * m_nCurves + icurve];
+        }
+        result[icurve] = result[icurve] / weight;
+    }
+}
+
+void MultiCurveEvaluator::EvaluateSorted(const double* params, size_t n, gp_XYZ* result) const
+{
+    int spanHint = -1;
+    for (size_t i = 0; i < n; ++i) {
+        Evaluate(params[i], result + i * m_nCurves, spanHint);
+    }
+}
+
+} // namespace occ_gordon_internal
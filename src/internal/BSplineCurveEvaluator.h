@@ -0,0 +1,145 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+#ifndef BSPLINECURVEEVALUATOR_H
+#define BSPLINECURVEEVALUATOR_H
+
+#include <Geom_BSplineCurve.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_XYZ.hxx>
+
+#include <vector>
+
+namespace occ_gordon_internal
+{
+
+/**
+ * @brief Returns the (zero based) index i of the knot span [U_i, U_i+1) containing t
+ *
+ * @param flatKnots Knots with repetitions
+ * @param hint Span of a previous evaluation or -1, if unknown
+ */
+int FindKnotSpan(const std::vector<double>& flatKnots, int degree, int nPoles, double t, int hint = -1);
+
+/**
+ * @brief Computes the nonzero basis functions of the span and their derivatives up to nDeriv
+ *
+ * @param ders Buffer of size (nDeriv + 1) * (degree + 1), ders[k * (degree + 1) + j]
+ *             is the k-th derivative of the basis function span - degree + j
+ */
+void BasisFunctionDerivatives(const double* flatKnots, int degree, int span, double t, int nDeriv, double* ders);
+
+/**
+ * @brief Fast evaluation of a B-spline curve and its derivatives
+ *
+ * Unlike Geom_BSplineCurve::DN, all derivatives up to second order are
+ * computed from a single pass over the basis functions. The knot span
+ * of the previous evaluation can be passed as a hint, which makes
+ * the evaluation of sorted parameters cheap.
+ *
+ * Periodic curves are converted into their non-periodic representation.
+ * The evaluator is immutable and can be used from several threads.
+ */
+class BSplineCurveEvaluator
+{
+public:
+    explicit BSplineCurveEvaluator(const Handle(Geom_BSplineCurve)& curve);
+
+    int Degree() const { return m_degree; }
+    int NbPoles() const { return static_cast<int>(m_poles.size()); }
+
+    double FirstParameter() const;
+    double LastParameter() const;
+
+    /**
+     * @brief Returns the (zero based) index i of the knot span [U_i, U_i+1) containing t
+     * @param hint Span of a previous evaluation or -1, if unknown
+     */
+    int FindSpan(double t, int hint = -1) const;
+
+    /// Returns the curve point at t. spanHint is updated to the span of t
+    gp_Pnt Value(double t, int& spanHint) const;
+
+    /**
+     * @brief Computes the curve point and its derivatives up to nDeriv (max 2)
+     * @param ders Array of size nDeriv + 1. ders[k] is the k-th derivative
+     * @param spanHint Span of a previous evaluation, updated to the span of t
+     */
+    void Derivatives(double t, int nDeriv, gp_XYZ* ders, int& spanHint) const;
+
+    /**
+     * @brief Evaluates the curve or one of its derivatives at many parameters
+     *
+     * The knot spans are walked incrementally. For each span, the curve is converted
+     * into a polynomial once, which is then reused for all parameters inside the span.
+     * Hence, the parameters should be sorted in ascending order for best performance.
+     * Unsorted parameters give correct results as well.
+     *
+     * @param derivOrder 0 for the curve points, 1 or 2 for the derivatives
+     * @param result Buffer of size n
+     */
+    void EvaluateSorted(const double* params, size_t n, int derivOrder, gp_XYZ* result) const;
+
+private:
+    struct SpanPolynomial;
+
+    void basisFunctions(int span, double t, int nDeriv, double* ders) const;
+    void homogeneousDerivatives(int span, double t, int nDeriv, gp_XYZ* A, double* w) const;
+    void buildSpanPolynomial(int span, SpanPolynomial& poly) const;
+
+    int m_degree;
+    bool m_rational;
+    std::vector<double> m_flatKnots;
+    std::vector<gp_XYZ> m_poles;
+    std::vector<double> m_weights;
+};
+
+/**
+ * @brief Evaluates several B-spline curves with a common degree and knot vector
+ *
+ * The basis functions are computed only once per parameter and then applied
+ * to the poles of all curves, which are stored in a structure of arrays layout.
+ * This is the typical situation after the curves of a network have been
+ * made compatible.
+ */
+class MultiCurveEvaluator
+{
+public:
+    /// Throws, if the curves don't share degree and knots
+    explicit MultiCurveEvaluator(const std::vector<Handle(Geom_BSplineCurve)>& curves);
+
+    /// Checks, whether all curves have the same degree, knots and multiplicities
+    static bool HaveCommonKnots(const std::vector<Handle(Geom_BSplineCurve)>& curves, double tolerance = 1e-14);
+
+    size_t NbCurves() const { return m_nCurves; }
+
+    /**
+     * @brief Evaluates all curves at t
+     * @param result Buffer of size NbCurves()
+     * @param spanHint Span of a previous evaluation, updated to the span of t
+     */
+    void Evaluate(double t, gp_XYZ* result, int& spanHint) const;
+
+    /**
+     * @brief Evaluates all curves at all parameters, which should be sorted ascending
+     * @param result Buffer of size n * NbCurves(). The point of curve j at
+     *               parameter i is stored at index i * NbCurves() + j
+     */
+    void EvaluateSorted(const double* params, size_t n, gp_XYZ* result) const;
+
+private:
+    int m_degree;
+    size_t m_nCurves;
+    size_t m_nPoles;
+    bool m_rational;
+    std::vector<double> m_flatKnots;
+
+    // homogeneous pole coordinates, index = pole * nCurves + curve
+    std::vector<double> m_x, m_y, m_z, m_w;
+};
+
+} // namespace occ_gordon_internal
+
+#endif // BSPLINECURVEEVALUATOR_H
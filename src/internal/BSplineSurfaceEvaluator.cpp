@@ -0,0 +1,327 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+*/
+
+#include "BSplineSurfaceEvaluator.h"
+
+#include "internal/BSplineCurveEvaluator.h"
+#include "internal/Error.h"
+#include "internal/Parallel.h"
+
+#include <TColStd_Array1OfReal.hxx>
+
+#include <algorithm>
+
+namespace
+{
+
+// Geom_BSplineSurface::MaxDegree()
+const int MAX_DEGREE = 25;
+const int MAX_ORDER = MAX_DEGREE + 1;
+
+// number of scattered points per parallel task
+const size_t POINTS_PER_TASK = 256;
+
+std::vector<double> flatKnots(const TColStd_Array1OfReal& knots)
+{
+    std::vector<double> result;
+    result.reserve(static_cast<size_t>(knots.Length()));
+    for (int i = knots.Lower(); i <= knots.Upper(); ++i) {
+        result.push_back(knots.Value(i));
+    }
+    return result;
+}
+
+// homogeneous coordinates of a point and its derivatives
+struct Homogeneous
+{
+    double x = 0., y = 0., z = 0., w = 0.;
+};
+
+// applies the quotient rule to the homogeneous point a and its derivative da
+gp_XYZ derivative(const Homogeneous& a, const Homogeneous& da, const gp_XYZ& point)
+{
+    return (gp_XYZ(da.x, da.y, da.z) - point * da.w) / a.w;
+}
+
+} // namespace
+
+namespace occ_gordon_internal
+{
+
+BSplineSurfaceEvaluator::BSplineSurfaceEvaluator(const Handle(Geom_BSplineSurface)& inputSurface)
+{
+    if (inputSurface.IsNull()) {
+        throw error("Null pointer surface in BSplineSurfaceEvaluator", NULL_POINTER);
+    }
+
+    Handle(Geom_BSplineSurface) surface = inputSurface;
+    if (surface->IsUPeriodic() || surface->IsVPeriodic()) {
+        surface = Handle(Geom_BSplineSurface)::DownCast(inputSurface->Copy());
+        surface->SetUNotPeriodic();
+        surface->SetVNotPeriodic();
+    }
+
+    m_uDegree = surface->UDegree();
+    m_vDegree = surface->VDegree();
+    if (m_uDegree > MAX_DEGREE || m_vDegree > MAX_DEGREE) {
+        throw error("Degree too high in BSplineSurfaceEvaluator", MATH_ERROR);
+    }
+    m_nUPoles = surface->NbUPoles();
+    m_nVPoles = surface->NbVPoles();
+    m_rational = surface->IsURational() || surface->IsVRational();
+
+    TColStd_Array1OfReal uKnots(1, m_nUPoles + m_uDegree + 1);
+    surface->UKnotSequence(uKnots);
+    m_uFlatKnots = flatKnots(uKnots);
+
+    TColStd_Array1OfReal vKnots(1, m_nVPoles + m_vDegree + 1);
+    surface->VKnotSequence(vKnots);
+    m_vFlatKnots = flatKnots(vKnots);
+
+    const size_t nPoles = static_cast<size_t>(m_nUPoles) * static_cast<size_t>(m_nVPoles);
+    m_x.resize(nPoles);
+    m_y.resize(nPoles);
+    m_z.resize(nPoles);
+    if (m_rational) {
+        m_w.resize(nPoles);
+    }
+
+    for (int iu = 0; iu < m_nUPoles; ++iu) {
+        for (int iv = 0; iv < m_nVPoles; ++iv) {
+            const gp_Pnt& pole = surface->Pole(iu + 1, iv + 1);
+            const double weight = m_rational ? surface->Weight(iu + 1, iv + 1) : 1.;
+            const size_t idx = static_cast<size_t>(iu) * static_cast<size_t>(m_nVPoles) + static_cast<size_t>(iv);
+            m_x[idx] = pole.X() * weight;
+            m_y[idx] = pole.Y() * weight;
+            m_z[idx] = pole.Z() * weight;
+            if (m_rational) {
+                m_w[idx] = weight;
+            }
+        }
+    }
+}
+
+double BSplineSurfaceEvaluator::FirstUParameter() const
+{
+    return m_uFlatKnots[static_cast<size_t>(m_uDegree)];
+}
+
+double BSplineSurfaceEvaluator::LastUParameter() const
+{
+    return m_uFlatKnots[static_cast<size_t>(m_nUPoles)];
+}
+
+double BSplineSurfaceEvaluator::FirstVParameter() const
+{
+    return m_vFlatKnots[static_cast<size_t>(m_vDegree)];
+}
+
+double BSplineSurfaceEvaluator::LastVParameter() const
+{
+    return m_vFlatKnots[static_cast<size_t>(m_nVPoles)];
+}
+
+void BSplineSurfaceEvaluator::EvaluateGrid(const double* u, size_t nu, const double* v, size_t nv,
+                                           gp_XYZ* points, gp_XYZ* du, gp_XYZ* dv, int nThreads) const
+{
+    if (nu == 0 || nv == 0) {
+        return;
+    }
+
+    const int p = m_uDegree;
+    const int q = m_vDegree;
+    const int nDeriv = (du || dv) ? 1 : 0;
+    const size_t nVPoles = static_cast<size_t>(m_nVPoles);
+
+    // v basis functions of all columns, computed once for all rows.
+    // vBasis[(k * (q + 1) + b) * nv + j] is the k-th derivative of basis function b at v[j]
+    std::vector<int> vSpans(nv);
+    std::vector<double> vBasis(static_cast<size_t>((nDeriv + 1) * (q + 1)) * nv);
+    std::vector<size_t> runs;
+    int hint = -1;
+    for (size_t j = 0; j < nv; ++j) {
+        vSpans[j] = FindKnotSpan(m_vFlatKnots, q, m_nVPoles, v[j], hint);
+        hint = vSpans[j];
+
+        double ders[2 * MAX_ORDER];
+        BasisFunctionDerivatives(m_vFlatKnots.data(), q, vSpans[j], v[j], nDeriv, ders);
+        for (int k = 0; k <= nDeriv * (q + 1) + q; ++k) {
+            vBasis[static_cast<size_t>(k) * nv + j] = ders[k];
+        }
+
+        // consecutive columns in the same span share the same poles
+        if (j == 0 || vSpans[j] != vSpans[j - 1]) {
+            runs.push_back(j);
+        }
+    }
+    runs.push_back(nv);
+
+    // evaluates the iso-curve with the poles qx, qy, qz, qw at all columns
+    auto evaluateIsoCurve = [&](const double* qx, const double* qy, const double* qz, const double* qw,
+                                const double* basis, double* ax, double* ay, double* az, double* aw) {
+        std::fill(ax, ax + nv, 0.);
+        std::fill(ay, ay + nv, 0.);
+        std::fill(az, az + nv, 0.);
+        std::fill(aw, aw + nv, 1.);
+        if (qw) {
+            std::fill(aw, aw + nv, 0.);
+        }
+
+        for (size_t r = 0; r + 1 < runs.size(); ++r) {
+            const size_t begin = runs[r];
+            const size_t end = runs[r + 1];
+            const size_t firstPole = static_cast<size_t>(vSpans[begin] - q);
+            for (int b = 0; b <= q; ++b) {
+                const size_t ipole = firstPole + static_cast<size_t>(b);
+                const double px = qx[ipole], py = qy[ipole], pz = qz[ipole];
+                const double* N = basis + static_cast<size_t>(b) * nv;
+                for (size_t j = begin; j < end; ++j) {
+                    ax[j] += N[j] * px;
+                    ay[j] += N[j] * py;
+                    az[j] += N[j] * pz;
+                }
+                if (qw) {
+                    const double pw = qw[ipole];
+                    for (size_t j = begin; j < end; ++j) {
+                        aw[j] += N[j] * pw;
+                    }
+                }
+            }
+        }
+    };
+
+    ParallelFor(0, static_cast<int>(nu), [&](int i) {
+        int span = FindKnotSpan(m_uFlatKnots, p, m_nUPoles, u[i]);
+        double uders[2 * MAX_ORDER];
+        BasisFunctionDerivatives(m_uFlatKnots.data(), p, span, u[i], nDeriv, uders);
+
+        // poles of the iso-curve u = u[i] and of its u derivative
+        const size_t nComp = m_rational ? 4 : 3;
+        std::vector<double> iso(static_cast<size_t>(nDeriv + 1) * nComp * nVPoles, 0.);
+        for (int k = 0; k <= nDeriv; ++k) {
+            double* qx = iso.data() + static_cast<size_t>(k) * nComp * nVPoles;
+            double* qy = qx + nVPoles;
+            double* qz = qy + nVPoles;
+            for (int a = 0; a <= p; ++a) {
+                const double N = uders[k * (p + 1) + a];
+                const size_t row = static_cast<size_t>(span - p + a) * nVPoles;
+                const double* px = m_x.data() + row;
+                const double* py = m_y.data() + row;
+                const double* pz = m_z.data() + row;
+                for (size_t l = 0; l < nVPoles; ++l) {
+                    qx[l] += N * px[l];
+                    qy[l] += N * py[l];
+                    qz[l] += N * pz[l];
+                }
+                if (m_rational) {
+                    double* qw = qz + nVPoles;
+                    const double* pw = m_w.data() + row;
+                    for (size_t l = 0; l < nVPoles; ++l) {
+                        qw[l] += N * pw[l];
+                    }
+                }
+            }
+        }
+
+        auto isoPoles = [&](int k, int comp) -> const double* {
+            if (comp == 3 && !m_rational) {
+                return nullptr;
+            }
+            return iso.data() + (static_cast<size_t>(k) * nComp + static_cast<size_t>(comp)) * nVPoles;
+        };
+
+        // point, u and v derivative in homogeneous coordinates
+        std::vector<double> buffer(12 * nv);
+        double* a[3][4];
+        for (int d = 0; d < 3; ++d) {
+            for (int c = 0; c < 4; ++c) {
+                a[d][c] = buffer.data() + static_cast<size_t>(4 * d + c) * nv;
+            }
+        }
+
+        evaluateIsoCurve(isoPoles(0, 0), isoPoles(0, 1), isoPoles(0, 2), isoPoles(0, 3),
+                         vBasis.data(), a[0][0], a[0][1], a[0][2], a[0][3]);
+        if (du) {
+            evaluateIsoCurve(isoPoles(1, 0), isoPoles(1, 1), isoPoles(1, 2), isoPoles(1, 3),
+                             vBasis.data(), a[1][0], a[1][1], a[1][2], a[1][3]);
+        }
+        if (dv) {
+            evaluateIsoCurve(isoPoles(0, 0), isoPoles(0, 1), isoPoles(0, 2), isoPoles(0, 3),
+                             vBasis.data() + static_cast<size_t>(q + 1) * nv, a[2][0], a[2][1], a[2][2], a[2][3]);
+        }
+
+        const size_t offset = static_cast<size_t>(i) * nv;
+        for (size_t j = 0; j < nv; ++j) {
+            Homogeneous h0{a[0][0][j], a[0][1][j], a[0][2][j], a[0][3][j]};
+            const gp_XYZ point = gp_XYZ(h0.x, h0.y, h0.z) / h0.w;
+            points[offset + j] = point;
+            if (du) {
+                Homogeneous h1{a[1][0][j], a[1][1][j], a[1][2][j], m_rational ? a[1][3][j] : 0.};
+                du[offset + j] = derivative(h0, h1, point);
+            }
+            if (dv) {
+                Homogeneous h2{a[2][0][j], a[2][1][j], a[2][2][j], m_rational ? a[2][3][j] : 0.};
+                dv[offset + j] = derivative(h0, h2, point);
+            }
+        }
+    }, nThreads);
+}
+
+void BSplineSurfaceEvaluator::EvaluatePoints(const double* u, const double* v, size_t n,
+                                             gp_XYZ* points, gp_XYZ* du, gp_XYZ* dv, int nThreads) const
+{
+    const int p = m_uDegree;
+    const int q = m_vDegree;
+    const int nDeriv = (du || dv) ? 1 : 0;
+    const size_t nVPoles = static_cast<size_t>(m_nVPoles);
+    const int nTasks = static_cast<int>((n + POINTS_PER_TASK - 1) / POINTS_PER_TASK);
+
+    ParallelFor(0, nTasks, [&](int task) {
+        const size_t begin = static_cast<size_t>(task) * POINTS_PER_TASK;
+        const size_t end = std::min(n, begin + POINTS_PER_TASK);
+
+        int uHint = -1, vHint = -1;
+        for (size_t i = begin; i < end; ++i) {
+            uHint = FindKnotSpan(m_uFlatKnots, p, m_nUPoles, u[i], uHint);
+            vHint = FindKnotSpan(m_vFlatKnots, q, m_nVPoles, v[i], vHint);
+
+            double uders[2 * MAX_ORDER], vders[2 * MAX_ORDER];
+            BasisFunctionDerivatives(m_uFlatKnots.data(), p, uHint, u[i], nDeriv, uders);
+            BasisFunctionDerivatives(m_vFlatKnots.data(), q, vHint, v[i], nDeriv, vders);
+
+            // point, u and v derivative in homogeneous coordinates
+            Homogeneous h[3];
+            for (int a = 0; a <= p; ++a) {
+                const size_t row = static_cast<size_t>(uHint - p + a) * nVPoles + static_cast<size_t>(vHint - q);
+                for (int b = 0; b <= q; ++b) {
+                    const size_t idx = row + static_cast<size_t>(b);
+                    const double w = m_rational ? m_w[idx] : 1.;
+                    const double N[3] = {
+                        uders[a] * vders[b],
+                        nDeriv > 0 ? uders[p + 1 + a] * vders[b] : 0.,
+                        nDeriv > 0 ? uders[a] * vders[q + 1 + b] : 0.
+                    };
+                    for (int d = 0; d <= 2 * nDeriv; ++d) {
+                        h[d].x += N[d] * m_x[idx];
+                        h[d].y += N[d] * m_y[idx];
+                        h[d].z += N[d] * m_z[idx];
+                        h[d].w += N[d] * w;
+                    }
+                }
+            }
+
+            const gp_XYZ point = gp_XYZ(h[0].x, h[0].y, h[0].z) / h[0].w;
+            points[i] = point;
+            if (du) {
+                du[i] = derivative(h[0], h[1], point);
+            }
+            if (dv) {
+                dv[i] = derivative(h[0], h[2], point);
+            }
+        }
+    }, nThreads);
+}
+
+} // namespace occ_gordon_internal
@@ -0,0 +1,83 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+*/
+
+#ifndef BSPLINESURFACEEVALUATOR_H
+#define BSPLINESURFACEEVALUATOR_H
+
+#include <Geom_BSplineSurface.hxx>
+#include <gp_XYZ.hxx>
+
+#include <cstddef>
+#include <vector>
+
+namespace occ_gordon_internal
+{
+
+/**
+ * @brief Evaluation of a B-spline surface and its first derivatives on many parameters
+ *
+ * On tensor grids, the basis functions are computed once per grid line. Each grid row
+ * u = const is first reduced to the poles of its iso-curve, which is then evaluated
+ * at all v parameters. The poles are stored as a structure of arrays, such that the
+ * inner loops run over contiguous memory and are vectorized by the compiler.
+ * Grid rows and batches of scattered points are evaluated in parallel.
+ *
+ * Periodic surfaces are converted into their non-periodic representation.
+ * The evaluator is immutable and can be used from several threads.
+ */
+class BSplineSurfaceEvaluator
+{
+public:
+    explicit BSplineSurfaceEvaluator(const Handle(Geom_BSplineSurface)& surface);
+
+    int UDegree() const { return m_uDegree; }
+    int VDegree() const { return m_vDegree; }
+
+    double FirstUParameter() const;
+    double LastUParameter() const;
+    double FirstVParameter() const;
+    double LastVParameter() const;
+
+    /**
+     * @brief Evaluates the surface on the tensor grid u x v
+     *
+     * The results of the point (u[i], v[j]) are stored at index i * nv + j.
+     * The parameters should be sorted ascending for best performance.
+     *
+     * @param points Buffer of size nu * nv
+     * @param du Optional buffer of size nu * nv for the derivatives in u direction
+     * @param dv Optional buffer of size nu * nv for the derivatives in v direction
+     * @param nThreads Maximum number of threads, <= 0 uses all threads
+     */
+    void EvaluateGrid(const double* u, size_t nu, const double* v, size_t nv,
+                      gp_XYZ* points, gp_XYZ* du = nullptr, gp_XYZ* dv = nullptr, int nThreads = -1) const;
+
+    /**
+     * @brief Evaluates the surface at the scattered parameters (u[i], v[i])
+     *
+     * @param points Buffer of size n
+     * @param du Optional buffer of size n for the derivatives in u direction
+     * @param dv Optional buffer of size n for the derivatives in v direction
+     * @param nThreads Maximum number of threads, <= 0 uses all threads
+     */
+    void EvaluatePoints(const double* u, const double* v, size_t n,
+                        gp_XYZ* points, gp_XYZ* du = nullptr, gp_XYZ* dv = nullptr, int nThreads = -1) const;
+
+private:
+    int m_uDegree;
+    int m_vDegree;
+    int m_nUPoles;
+    int m_nVPoles;
+    bool m_rational;
+    std::vector<double> m_uFlatKnots;
+    std::vector<double> m_vFlatKnots;
+
+    // homogeneous pole coordinates, index = iu * nVPoles + iv
+    std::vector<double> m_x, m_y, m_z, m_w;
+};
+
+} // namespace occ_gordon_internal
+
+#endif // BSPLINESURFACEEVALUATOR_H
@@ -0,0 +1,254 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+*/
+
+#include "CurveNetworkClassifier.h"
+
+#include "internal/BSplineAlgorithms.h"
+#include "internal/Error.h"
+#include "internal/Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace occ_gordon_internal
+{
+
+CurveNetworkClassifier::CurveNetworkClassifier(const std::vector<Handle(Geom_BSplineCurve)>& curves,
+                                               double tolerance,
+                                               const IntersectBSplinesOptions& options)
+    : m_curves(curves)
+    , m_tolerance(tolerance)
+    , m_options(options)
+    , m_origin{0., 0., 0.}
+    , m_cellSize(1.)
+    , m_gridSize{1, 1, 1}
+    , m_nIntersectionTests(0)
+    , m_hasPerformed(false)
+{
+    for (const Handle(Geom_BSplineCurve)& curve : m_curves) {
+        if (curve.IsNull()) {
+            throw error("Curve network contains a null curve", NULL_POINTER);
+        }
+    }
+}
+
+void CurveNetworkClassifier::ComputeBoxes()
+{
+    // the curves lie inside the convex hull of their control points
+    m_boxes.resize(m_curves.size());
+    for (size_t i = 0; i < m_curves.size(); ++i) {
+        // the tolerance is relative to the curve size, as in BSplineAlgorithms::intersections
+        const double tolerance = m_tolerance * BSplineAlgorithms::scale(m_curves[i]);
+
+        Box& box = m_boxes[i];
+        std::fill(box.min, box.min + 3, std::numeric_limits<double>::max());
+        std::fill(box.max, box.max + 3, std::numeric_limits<double>::lowest());
+
+        for (int ipole = 1; ipole <= m_curves[i]->NbPoles(); ++ipole) {
+            const gp_Pnt& pole = m_curves[i]->Pole(ipole);
+            for (int k = 0; k < 3; ++k) {
+                box.min[k] = std::min(box.min[k], pole.Coord(k + 1));
+                box.max[k] = std::max(box.max[k], pole.Coord(k + 1));
+            }
+        }
+
+        for (int k = 0; k < 3; ++k) {
+            box.min[k] -= tolerance;
+            box.max[k] += tolerance;
+        }
+    }
+}
+
+void CurveNetworkClassifier::BuildSpatialHash()
+{
+    double lower[3], upper[3];
+    std::fill(lower, lower + 3, std::numeric_limits<double>::max());
+    std::fill(upper, upper + 3, std::numeric_limits<double>::lowest());
+    for (const Box& box : m_boxes) {
+        for (int k = 0; k < 3; ++k) {
+            lower[k] = std::min(lower[k], box.min[k]);
+            upper[k] = std::max(upper[k], box.max[k]);
+        }
+    }
+
+    // about one cell per curve, i.e. cbrt(n) cells along the largest extent
+    double extent = 0.;
+    for (int k = 0; k < 3; ++k) {
+        extent = std::max(extent, upper[k] - lower[k]);
+    }
+    const double cellsPerAxis = std::ceil(std::cbrt(static_cast<double>(m_curves.size())));
+    m_cellSize = extent > 0. ? extent / cellsPerAxis : 1.;
+
+    for (int k = 0; k < 3; ++k) {
+        m_origin[k] = lower[k];
+        m_gridSize[k] = static_cast<long>((upper[k] - lower[k]) / m_cellSize) + 1;
+    }
+
+    m_cells.clear();
+    for (size_t i = 0; i < m_boxes.size(); ++i) {
+        long lo[3], hi[3];
+        CellRange(m_boxes[i], lo, hi);
+        for (long ix = lo[0]; ix <= hi[0]; ++ix) {
+            for (long iy = lo[1]; iy <= hi[1]; ++iy) {
+                for (long iz = lo[2]; iz <= hi[2]; ++iz) {
+                    const std::uint64_t key = static_cast<std::uint64_t>((ix * m_gridSize[1] + iy) * m_gridSize[2] + iz);
+                    m_cells[key].push_back(i);
+                }
+            }
+        }
+    }
+}
+
+void CurveNetworkClassifier::CellRange(const Box& box, long lower[3], long upper[3]) const
+{
+    for (int k = 0; k < 3; ++k) {
+        lower[k] = std::max(0L, static_cast<long>(std::floor((box.min[k] - m_origin[k]) / m_cellSize)));
+        upper[k] = std::min(m_gridSize[k] - 1, static_cast<long>(std::floor((box.max[k] - m_origin[k]) / m_cellSize)));
+    }
+}
+
+std::vector<size_t> CurveNetworkClassifier::Candidates(size_t curveIdx, const std::function<bool(size_t)>& accept,
+                                                       std::vector<size_t>& visited) const
+{
+    const Box& box = m_boxes[curveIdx];
+    auto overlaps = [&box](const Box& other) {
+        for (int k = 0; k < 3; ++k) {
+            if (other.max[k] < box.min[k] || other.min[k] > box.max[k]) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::vector<size_t> candidates;
+    long lo[3], hi[3];
+    CellRange(box, lo, hi);
+    for (long ix = lo[0]; ix <= hi[0]; ++ix) {
+        for (long iy = lo[1]; iy <= hi[1]; ++iy) {
+            for (long iz = lo[2]; iz <= hi[2]; ++iz) {
+                const std::uint64_t key = static_cast<std::uint64_t>((ix * m_gridSize[1] + iy) * m_gridSize[2] + iz);
+                auto cell = m_cells.find(key);
+                if (cell == m_cells.end()) {
+                    continue;
+                }
+
+                for (size_t other : cell->second) {
+                    // visited stores the curve, that has last seen the other curve
+                    if (visited[other] == curveIdx) {
+                        continue;
+                    }
+                    visited[other] = curveIdx;
+                    if (accept(other) && overlaps(m_boxes[other])) {
+                        candidates.push_back(other);
+                    }
+                }
+            }
+        }
+    }
+
+    // independent of the hash map order
+    std::sort(candidates.begin(), candidates.end());
+    return candidates;
+}
+
+void CurveNetworkClassifier::Perform()
+{
+    if (m_hasPerformed) {
+        return;
+    }
+
+    const size_t nCurves = m_curves.size();
+    if (nCurves < 4) {
+        throw error("A curve network requires at least 4 curves");
+    }
+
+    ComputeBoxes();
+    BuildSpatialHash();
+
+    auto intersect = [this](size_t i, size_t j) {
+        return !BSplineAlgorithms::intersections(m_curves[i], m_curves[j], m_tolerance, m_options).empty();
+    };
+
+    // breadth first 2-coloring, starting with the first curve as profile.
+    // Only the uncolored curves are tested, i.e. the search follows a spanning tree.
+    // Hence, each pair is tested at most once and each curve is colored by its first intersection.
+    std::vector<int> colors(nCurves, -1);
+    std::vector<size_t> visited(nCurves, nCurves);
+    std::deque<size_t> queue;
+    colors[0] = 0;
+    queue.push_back(0);
+
+    while (!queue.empty()) {
+        const size_t current = queue.front();
+        queue.pop_front();
+
+        const std::vector<size_t> candidates = Candidates(current, [&colors](size_t other) {
+            return colors[other] < 0;
+        }, visited);
+        std::vector<char> intersects(candidates.size(), 0);
+        ParallelFor(0, static_cast<int>(candidates.size()), [&](int i) {
+            intersects[i] = intersect(current, candidates[i]);
+        });
+        m_nIntersectionTests += candidates.size();
+
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (intersects[i]) {
+                colors[candidates[i]] = 1 - colors[current];
+                queue.push_back(candidates[i]);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < nCurves; ++i) {
+        if (colors[i] < 0) {
+            throw error("Curve " + std::to_string(i) + " does not intersect the curve network");
+        }
+    }
+
+    // The spanning tree does not see intersections within a family. These can only occur
+    // between curves of the same color with overlapping boxes.
+    std::fill(visited.begin(), visited.end(), nCurves);
+    std::vector<std::pair<size_t, size_t>> sameColorPairs;
+    for (size_t i = 0; i < nCurves; ++i) {
+        const std::vector<size_t> candidates = Candidates(i, [&colors, i](size_t other) {
+            return other > i && colors[other] == colors[i];
+        }, visited);
+        for (size_t other : candidates) {
+            sameColorPairs.emplace_back(i, other);
+        }
+    }
+
+    std::vector<char> intersects(sameColorPairs.size(), 0);
+    ParallelFor(0, static_cast<int>(sameColorPairs.size()), [&](int i) {
+        intersects[i] = intersect(sameColorPairs[i].first, sameColorPairs[i].second);
+    });
+    m_nIntersectionTests += sameColorPairs.size();
+
+    for (size_t i = 0; i < sameColorPairs.size(); ++i) {
+        if (intersects[i]) {
+            throw error("The curves " + std::to_string(sameColorPairs[i].first) + " and " +
+                        std::to_string(sameColorPairs[i].second) +
+                        " intersect, but cannot be assigned to different families");
+        }
+    }
+
+    m_profileIndices.clear();
+    m_guideIndices.clear();
+    for (size_t i = 0; i < nCurves; ++i) {
+        (colors[i] == 0 ? m_profileIndices : m_guideIndices).push_back(i);
+    }
+
+    if (m_profileIndices.size() < 2 || m_guideIndices.size() < 2) {
+        throw error("The curves cannot be split into at least two profiles and two guides");
+    }
+
+    m_hasPerformed = true;
+}
+
+} // namespace occ_gordon_internal
@@ -0,0 +1,114 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+*/
+
+#ifndef CURVENETWORKCLASSIFIER_H
+#define CURVENETWORKCLASSIFIER_H
+
+#include "IntersectBSplines.h"
+
+#include <Geom_BSplineCurve.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace occ_gordon_internal
+{
+
+/**
+ * @brief Splits an unordered set of curves into the profiles and guides of a curve network
+ *
+ * The curves are the vertices of an intersection graph. Curves of the same family don't
+ * intersect, hence the graph is bipartite and its 2-colouring yields the two families.
+ *
+ * Candidates for intersections are found with a spatial hash over the bounding boxes of
+ * the control polygons. The graph is coloured by a breadth first search along a spanning
+ * tree: each curve is only tested against the candidates, that have not been coloured yet,
+ * hence each curve is coloured by its first intersection. Afterwards, only the curves of
+ * the same colour with overlapping boxes are tested again. In a regular network, the boxes
+ * of a family hardly overlap, hence the number of tests is about the number of curves.
+ * Intersecting curves of the same colour are reported as an error, as the curves then
+ * don't form two families.
+ *
+ * The family of the first curve is returned as the profiles.
+ */
+class CurveNetworkClassifier
+{
+public:
+    /**
+     * @param curves Curves of the network in arbitrary order
+     * @param tolerance Tolerance, in which profiles and guides intersect, relative to the curve sizes
+     * @param options Settings of the intersection tests
+     */
+    CurveNetworkClassifier(const std::vector<Handle(Geom_BSplineCurve)>& curves,
+                           double tolerance,
+                           const IntersectBSplinesOptions& options = IntersectBSplinesOptions());
+
+    /**
+     * @brief Classifies the curves
+     *
+     * @throws error, if the curves don't form a connected network with two families,
+     *         e.g. if three curves intersect each other mutually
+     */
+    void Perform();
+
+    /// Indices of the profiles in the input curves
+    std::vector<size_t> const & ProfileIndices() const
+    {
+        return m_profileIndices;
+    }
+
+    /// Indices of the guides in the input curves
+    std::vector<size_t> const & GuideIndices() const
+    {
+        return m_guideIndices;
+    }
+
+    /// Number of intersection tests, that have been performed
+    size_t NIntersectionTests() const
+    {
+        return m_nIntersectionTests;
+    }
+
+private:
+    struct Box
+    {
+        double min[3];
+        double max[3];
+    };
+
+    void ComputeBoxes();
+    void BuildSpatialHash();
+
+    // range of grid cells covered by a box
+    void CellRange(const Box& box, long lower[3], long upper[3]) const;
+
+    // curves with an overlapping box, that are accepted by the filter
+    std::vector<size_t> Candidates(size_t curveIdx, const std::function<bool(size_t)>& accept,
+                                   std::vector<size_t>& visited) const;
+
+    std::vector<Handle(Geom_BSplineCurve)> m_curves;
+    double m_tolerance;
+    IntersectBSplinesOptions m_options;
+
+    std::vector<Box> m_boxes;
+    double m_origin[3];
+    double m_cellSize;
+    long m_gridSize[3];
+
+    // spatial hash: curves, whose boxes overlap a grid cell
+    std::unordered_map<std::uint64_t, std::vector<size_t>> m_cells;
+
+    std::vector<size_t> m_profileIndices;
+    std::vector<size_t> m_guideIndices;
+    size_t m_nIntersectionTests;
+    bool m_hasPerformed;
+};
+
+} // namespace occ_gordon_internal
+
+#endif // CURVENETWORKCLASSIFIER_H
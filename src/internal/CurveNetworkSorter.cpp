@@ -9,8 +9,10 @@
 
 #include "internal/Error.h"
 
-#include <utility>
+#include <algorithm>
 #include <cassert>
+#include <numeric>
+#include <utility>
 
 using namespace occ_gordon_internal;
 
@@ -81,6 +83,17 @@ namespace
         return imin;
     }
 
+    // original indices as strings, reversed curves are prefixed by "-"
+    std::vector<std::string> indexStrings(const std::vector<size_t>& permutation, const std::vector<bool>& reversed)
+    {
+        std::vector<std::string> result;
+        result.reserve(permutation.size());
+        for (size_t k = 0; k < permutation.size(); ++k) {
+            result.push_back((reversed[k] ? "-" : "") + std::to_string(permutation[k]));
+        }
+        return result;
+    }
+
 }
 
 namespace occ_gordon_internal
@@ -122,42 +135,13 @@ CurveNetworkSorter::CurveNetworkSorter(const std::vector<Handle (Geom_Curve)> &p
     assert(m_parmsIntersGuides.UpperCol() == n_guides - 1);
     assert(m_parmsIntersProfiles.UpperCol() == n_guides - 1);
 
-    // create helper vectors with indices
-    for (size_t i = 0; i < n_profiles; ++i) {
-        std::stringstream str;
-        str << i;
-        m_profIdx.push_back(str.str());
-    }
-
-    for (size_t i = 0; i < n_guides; ++i) {
-        std::stringstream str;
-        str << i;
-        m_guidIdx.push_back(str.str());
-    }
-}
-
-void CurveNetworkSorter::swapProfiles(size_t idx1, size_t idx2)
-{
-    if (idx1 == idx2) {
-        return;
-    }
-
-    std::swap(m_profiles[idx1], m_profiles[idx2]);
-    std::swap(m_profIdx[idx1], m_profIdx[idx2]);
-    m_parmsIntersGuides.SwapRow(static_cast<Standard_Integer>(idx1), static_cast<Standard_Integer>(idx2));
-    m_parmsIntersProfiles.SwapRow(static_cast<Standard_Integer>(idx1), static_cast<Standard_Integer>(idx2));
-}
-
-void CurveNetworkSorter::swapGuides(size_t idx1, size_t idx2)
-{
-    if (idx1 == idx2) {
-        return;
-    }
-
-    std::swap(m_guides[idx1], m_guides[idx2]);
-    std::swap(m_guidIdx[idx1], m_guidIdx[idx2]);
-    m_parmsIntersGuides.SwapCol(static_cast<Standard_Integer>(idx1), static_cast<Standard_Integer>(idx2));
-    m_parmsIntersProfiles.SwapCol(static_cast<Standard_Integer>(idx1), static_cast<Standard_Integer>(idx2));
+    // identity permutation until the network is sorted
+    m_profilePermutation.resize(n_profiles);
+    std::iota(m_profilePermutation.begin(), m_profilePermutation.end(), size_t(0));
+    m_guidePermutation.resize(n_guides);
+    std::iota(m_guidePermutation.begin(), m_guidePermutation.end(), size_t(0));
+    m_profileReversed.assign(n_profiles, false);
+    m_guideReversed.assign(n_guides, false);
 }
 
 void CurveNetworkSorter::GetStartCurveIndices(size_t &prof_idx, size_t &guid_idx, bool &guideMustBeReversed) const
@@ -201,54 +185,100 @@ void CurveNetworkSorter::Perform()
         return;
     }
 
-    size_t prof_start = 0, guide_start = 0;
-    Standard_Integer nGuid = static_cast<Standard_Integer>(NGuides());
-    Standard_Integer nProf = static_cast<Standard_Integer>(NProfiles());
+    const size_t nProf = NProfiles();
+    const size_t nGuid = NGuides();
 
+    size_t prof_start = 0, guide_start = 0;
     bool guideMustBeReversed = false;
     GetStartCurveIndices(prof_start, guide_start, guideMustBeReversed);
 
-    // put start curves first in array
-    swapProfiles(0, prof_start);
-    swapGuides(0, guide_start);
-
+    // The order is computed on the input matrices by index only. The matrices
+    // are permuted afterwards in a single pass.
+    std::vector<Standard_Real> profileSums(nProf, 0.), guideSums(nGuid, 0.);
+    std::vector<bool> profileReversed(nProf, false), guideReversed(nGuid, false);
     if (guideMustBeReversed) {
-        reverseGuide(0);
+        guideReversed[guide_start] = true;
+        guideSums[guide_start] = guideReversalSum(guide_start);
     }
 
-    // perform a bubble sort for the guides,
-    // such that the guides intersection of the first profile are ascending
-    for (int n = nGuid; n > 1; n = n - 1) {
-        for (int j = 1; j < n - 1; ++j) {
-            if (m_parmsIntersProfiles(0, j) > m_parmsIntersProfiles(0, j + 1)) {
-                swapGuides(j, j + 1);
-            }
+    // guide parameter including a reversal of the guide
+    auto guideParm = [&](size_t iProf, size_t iGuid) {
+        Standard_Real t = m_parmsIntersGuides(static_cast<Standard_Integer>(iProf), static_cast<Standard_Integer>(iGuid));
+        return guideReversed[iGuid] ? guideSums[iGuid] - t : t;
+    };
+
+    auto profileParm = [&](size_t iProf, size_t iGuid) {
+        Standard_Real t = m_parmsIntersProfiles(static_cast<Standard_Integer>(iProf), static_cast<Standard_Integer>(iGuid));
+        return profileReversed[iProf] ? profileSums[iProf] - t : t;
+    };
+
+    // put start curves first. The remaining curves are sorted stably
+    std::vector<size_t> guidePerm(nGuid), profPerm(nProf);
+    std::iota(guidePerm.begin(), guidePerm.end(), size_t(0));
+    std::iota(profPerm.begin(), profPerm.end(), size_t(0));
+    std::swap(guidePerm[0], guidePerm[guide_start]);
+    std::swap(profPerm[0], profPerm[prof_start]);
+
+    // the guides intersections of the first profile are ascending
+    std::stable_sort(guidePerm.begin() + 1, guidePerm.end(), [&](size_t g1, size_t g2) {
+        return profileParm(prof_start, g1) < profileParm(prof_start, g2);
+    });
+
+    // the profiles are in ascending order of the first guide
+    std::stable_sort(profPerm.begin() + 1, profPerm.end(), [&](size_t p1, size_t p2) {
+        return guideParm(p1, guide_start) < guideParm(p2, guide_start);
+    });
+
+    // reverse profiles, if necessary
+    for (size_t k = 1; k < nProf; ++k) {
+        const size_t iProf = profPerm[k];
+        if (profileParm(iProf, guidePerm.front()) > profileParm(iProf, guidePerm.back())) {
+            profileSums[iProf] = profileReversalSum(iProf);
+            profileReversed[iProf] = true;
         }
     }
 
-    // perform a bubble sort of the profiles,
-    // such that the profiles are in ascending order of the first guide
-    for (int n = nProf; n > 1; n = n - 1) {
-        for (int i = 1; i < n - 1; ++i) {
-            if (m_parmsIntersGuides(i, 0) > m_parmsIntersGuides(i + 1, 0)) {
-                swapProfiles(i, i + 1);
-            }
+    // reverse guides, if necessary
+    for (size_t k = 1; k < nGuid; ++k) {
+        const size_t iGuid = guidePerm[k];
+        if (guideParm(profPerm.front(), iGuid) > guideParm(profPerm.back(), iGuid)) {
+            guideSums[iGuid] = guideReversalSum(iGuid);
+            guideReversed[iGuid] = true;
         }
     }
 
-    // reverse profiles, if necessary
-    for (Standard_Integer iProf = 1; iProf < nProf; ++iProf) {
-        if (m_parmsIntersProfiles(iProf, 0) > m_parmsIntersProfiles(iProf, nGuid - 1)) {
-            reverseProfile(iProf);
+    // gather the sorted and reversed intersection parameters
+    math_Matrix parmsIntersProfiles(0, static_cast<Standard_Integer>(nProf) - 1, 0, static_cast<Standard_Integer>(nGuid) - 1);
+    math_Matrix parmsIntersGuides(0, static_cast<Standard_Integer>(nProf) - 1, 0, static_cast<Standard_Integer>(nGuid) - 1);
+    for (size_t k = 0; k < nProf; ++k) {
+        for (size_t l = 0; l < nGuid; ++l) {
+            parmsIntersProfiles(static_cast<Standard_Integer>(k), static_cast<Standard_Integer>(l)) = profileParm(profPerm[k], guidePerm[l]);
+            parmsIntersGuides(static_cast<Standard_Integer>(k), static_cast<Standard_Integer>(l)) = guideParm(profPerm[k], guidePerm[l]);
         }
     }
-
-    // reverse guide, if necessary
-    for (Standard_Integer iGuid = 1; iGuid < nGuid; ++iGuid) {
-        if (m_parmsIntersGuides(0, iGuid) > m_parmsIntersGuides(nProf - 1, iGuid)) {
-            reverseGuide(iGuid);
+    m_parmsIntersProfiles = parmsIntersProfiles;
+    m_parmsIntersGuides = parmsIntersGuides;
+
+    // reorder and reverse the curves
+    std::vector<Handle(Geom_Curve)> profiles(nProf), guides(nGuid);
+    for (size_t k = 0; k < nProf; ++k) {
+        profiles[k] = m_profiles[profPerm[k]];
+        m_profileReversed[k] = profileReversed[profPerm[k]];
+        if (m_profileReversed[k] && !profiles[k].IsNull()) {
+            profiles[k]->Reverse();
+        }
+    }
+    for (size_t l = 0; l < nGuid; ++l) {
+        guides[l] = m_guides[guidePerm[l]];
+        m_guideReversed[l] = guideReversed[guidePerm[l]];
+        if (m_guideReversed[l] && !guides[l].IsNull()) {
+            guides[l]->Reverse();
         }
     }
+    m_profiles = std::move(profiles);
+    m_guides = std::move(guides);
+    m_profilePermutation = std::move(profPerm);
+    m_guidePermutation = std::move(guidePerm);
 
     m_hasPerformed = true;
 }
@@ -263,67 +293,38 @@ size_t CurveNetworkSorter::NGuides() const
     return m_guides.size();
 }
 
-const std::vector<std::string> &CurveNetworkSorter::ProfileIndices() const
+std::vector<std::string> CurveNetworkSorter::ProfileIndices() const
 {
-    return m_profIdx;
+    return indexStrings(m_profilePermutation, m_profileReversed);
 }
 
-const std::vector<std::string> &CurveNetworkSorter::GuideIndices() const
+std::vector<std::string> CurveNetworkSorter::GuideIndices() const
 {
-    return m_guidIdx;
+    return indexStrings(m_guidePermutation, m_guideReversed);
 }
 
-void CurveNetworkSorter::reverseProfile(size_t profileIdx)
+Standard_Real CurveNetworkSorter::profileReversalSum(size_t profileIdx) const
 {
-    Standard_Integer pIdx = static_cast<Standard_Integer>(profileIdx);
-
-    Handle(Geom_Curve) profile = m_profiles[profileIdx];
-    Standard_Real lastParm = !profile.IsNull() ?
-                profile->LastParameter() :
-                m_parmsIntersProfiles(pIdx, static_cast<Standard_Integer>(maxRowIndex(m_parmsIntersProfiles, pIdx)));
-
-    Standard_Real firstParm = !profile.IsNull() ?
-                profile->FirstParameter() :
-                m_parmsIntersProfiles(pIdx, static_cast<Standard_Integer>(minRowIndex(m_parmsIntersProfiles, pIdx)));
-
-
-    // compute new parameters
-    for (int icol = 0; icol < static_cast<int>(NGuides()); ++icol) {
-        m_parmsIntersProfiles(pIdx, icol) = -m_parmsIntersProfiles(pIdx, icol) + firstParm + lastParm;
-    }
-
+    const Handle(Geom_Curve)& profile = m_profiles[profileIdx];
     if (!profile.IsNull()) {
-        profile->Reverse();
+        return profile->FirstParameter() + profile->LastParameter();
     }
 
-    m_profIdx[profileIdx] = "-" + m_profIdx[profileIdx];
+    Standard_Integer pIdx = static_cast<Standard_Integer>(profileIdx);
+    return m_parmsIntersProfiles(pIdx, static_cast<Standard_Integer>(minRowIndex(m_parmsIntersProfiles, profileIdx))) +
+           m_parmsIntersProfiles(pIdx, static_cast<Standard_Integer>(maxRowIndex(m_parmsIntersProfiles, profileIdx)));
 }
 
-void CurveNetworkSorter::reverseGuide(size_t guideIdx)
+Standard_Real CurveNetworkSorter::guideReversalSum(size_t guideIdx) const
 {
-
-    Standard_Integer gIdx = static_cast<Standard_Integer>(guideIdx);
-
-    Handle(Geom_Curve) guide = m_guides[guideIdx];
-    Standard_Real lastParm = !guide.IsNull() ?
-                guide->LastParameter() :
-                m_parmsIntersGuides(static_cast<Standard_Integer>(maxColIndex(m_parmsIntersGuides, gIdx)), gIdx);
-
-    Standard_Real firstParm = !guide.IsNull() ?
-                guide->FirstParameter() :
-                m_parmsIntersGuides(static_cast<Standard_Integer>(minColIndex(m_parmsIntersGuides, gIdx)), gIdx);
-
-    // compute new parameter
-    for (int irow = 0; irow < static_cast<int>(NProfiles()); ++irow) {
-        m_parmsIntersGuides(irow, gIdx) = -m_parmsIntersGuides(irow, gIdx) + firstParm + lastParm;
-    }
-
+    const Handle(Geom_Curve)& guide = m_guides[guideIdx];
     if (!guide.IsNull()) {
-        guide->Reverse();
+        return guide->FirstParameter() + guide->LastParameter();
     }
 
-    m_guidIdx[guideIdx] = "-" + m_guidIdx[guideIdx];
+    Standard_Integer gIdx = static_cast<Standard_Integer>(guideIdx);
+    return m_parmsIntersGuides(static_cast<Standard_Integer>(minColIndex(m_parmsIntersGuides, guideIdx)), gIdx) +
+           m_parmsIntersGuides(static_cast<Standard_Integer>(maxColIndex(m_parmsIntersGuides, guideIdx)), gIdx);
 }
 
-
 } // namespace occ_gordon_internal
@@ -13,6 +13,7 @@
 #include <Geom_Curve.hxx>
 #include <math_Matrix.hxx>
 
+#include <string>
 #include <vector>
 
 namespace occ_gordon_internal
@@ -116,26 +117,61 @@ public:
         return m_guides;
     }
 
+    /**
+     * @brief Returns the original indices of the sorted profiles
+     *
+     * The k-th sorted profile is the profile ProfilePermutation()[k] of the input.
+     */
+    std::vector<size_t> const & ProfilePermutation() const
+    {
+        return m_profilePermutation;
+    }
+
+    /**
+     * @brief Returns the original indices of the sorted guides
+     */
+    std::vector<size_t> const & GuidePermutation() const
+    {
+        return m_guidePermutation;
+    }
+
+    /**
+     * @brief Returns, whether the k-th sorted profile has been reversed
+     */
+    std::vector<bool> const & ProfileReversed() const
+    {
+        return m_profileReversed;
+    }
+
+    /**
+     * @brief Returns, whether the k-th sorted guide has been reversed
+     */
+    std::vector<bool> const & GuideReversed() const
+    {
+        return m_guideReversed;
+    }
+
     // The next functions are just for testing the algorithm and
-    // are not required elsewhere.
-    std::vector<std::string> const & ProfileIndices() const;
-    std::vector<std::string> const & GuideIndices() const;
+    // are not required elsewhere. They return the original indices
+    // of the sorted curves as strings, reversed curves are prefixed by "-".
+    std::vector<std::string> ProfileIndices() const;
+    std::vector<std::string> GuideIndices() const;
 
 private:
-    void swapProfiles(size_t idx1, size_t idx2);
-    void swapGuides(size_t idx1, size_t idx2);
-
-    void reverseProfile(size_t profileIdx);
-    void reverseGuide(size_t guideIdx);
+    // sum of the first and last parameter, which maps a parameter t to
+    // the parameter of the reversed curve (sum - t)
+    Standard_Real profileReversalSum(size_t profileIdx) const;
+    Standard_Real guideReversalSum(size_t guideIdx) const;
 
     std::vector<Handle(Geom_Curve)> m_profiles;
     std::vector<Handle(Geom_Curve)> m_guides;
     math_Matrix m_parmsIntersProfiles;
     math_Matrix m_parmsIntersGuides;
 
-    // helper vectors for testing
-    std::vector<std::string> m_profIdx;
-    std::vector<std::string> m_guidIdx;
+    std::vector<size_t> m_profilePermutation;
+    std::vector<size_t> m_guidePermutation;
+    std::vector<bool> m_profileReversed;
+    std::vector<bool> m_guideReversed;
 
     bool m_hasPerformed;
 };
@@ -10,6 +10,7 @@
 #include "CurvesToSurface.h"
 #include "internal/Error.h"
 #include "BSplineAlgorithms.h"
+#include "TaskMonitor.h"
 
 #include <GeomAPI_Interpolate.hxx>
 #include <Geom_TrimmedCurve.hxx>
@@ -160,6 +161,10 @@ void CurvesToSurface::Perform()
 
         // check degree always the same
         assert(degreeV == interpSpline->Degree());
+
+        if (_monitor) {
+            _monitor->SetStageProgress(static_cast<double>(cpUIdx) / static_cast<double>(numControlPointsU));
+        }
     }
 
     TColStd_Array1OfReal knotsU(1, firstCurve->NbKnots());
@@ -15,6 +15,8 @@
 
 namespace occ_gordon_internal {
 
+class TaskMonitor;
+
 class CurvesToSurface
 {
 public:
@@ -54,6 +56,16 @@ public:
      */
     void SetMaxDegree(int degree);
 
+    /**
+     * @brief sets a monitor, which receives the progress of the skinning columns and can cancel the skinning
+     *
+     * The monitor is not owned and must live until the surface is computed.
+     */
+    void SetTaskMonitor(TaskMonitor* monitor)
+    {
+        _monitor = monitor;
+    }
+
     /**
      * @brief returns the parameters at the profile curves
      */
@@ -85,6 +97,7 @@ private:
     bool _continuousIfClosed = false;
     bool _hasPerformed = false;
     int _maxDegree = 3;
+    TaskMonitor* _monitor = nullptr;
 };
 
 }
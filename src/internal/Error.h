@@ -19,7 +19,8 @@ enum error_code
     GENERIC_ERROR,
     MATH_ERROR,
     NULL_POINTER,
-    INDEX_ERROR
+    INDEX_ERROR,
+    CANCELLED
 };
 
 class error : public std::exception
@@ -12,6 +12,7 @@
 
 #include <BSplineAlgorithms.h>
 #include <CurvesToSurface.h>
+#include <TaskMonitor.h>
 #include <TColgp_Array2OfPnt.hxx>
 
 #include <algorithm>
@@ -25,6 +26,43 @@ namespace
             throw occ_gordon_internal::error("Curve not in range [" + std::to_string(umin) + ", " + std::to_string(umax) + "].");
         }
     }
+
+    int maxDegree(const std::vector<Handle(Geom_BSplineCurve)>& curves)
+    {
+        int degree = 0;
+        for (const Handle(Geom_BSplineCurve)& curve : curves) {
+            degree = std::max(degree, curve->Degree());
+        }
+        return degree;
+    }
+
+    // Degree of the skinning / point interpolation of nCurves sections
+    // (see PointsToBSplineInterpolation::Degree)
+    int interpolationDegree(size_t nCurves, bool closed, int maxInterpolationDegree = 3)
+    {
+        int degree = static_cast<int>(nCurves) - 1;
+        if (closed) {
+            degree -= 1;
+        }
+        return std::max(1, std::min(degree, maxInterpolationDegree));
+    }
+
+    // Returns the curves elevated to the given degree. The input curves are not modified.
+    std::vector<Handle(Geom_Curve)> elevatedCurves(const std::vector<Handle(Geom_BSplineCurve)>& curves, int degree)
+    {
+        std::vector<Handle(Geom_Curve)> result;
+        for (const Handle(Geom_BSplineCurve)& curve : curves) {
+            if (curve->Degree() < degree) {
+                Handle(Geom_BSplineCurve) elevated = Handle(Geom_BSplineCurve)::DownCast(curve->Copy());
+                elevated->IncreaseDegree(degree);
+                result.push_back(elevated);
+            }
+            else {
+                result.push_back(curve);
+            }
+        }
+        return result;
+    }
 }
 
 namespace occ_gordon_internal
@@ -39,7 +77,10 @@ GordonSurfaceBuilder::GordonSurfaceBuilder(const CurveArray &profiles, const Cur
     , m_intersection_params_spline_u(intersection_params_spline_u)
     , m_intersection_params_spline_v(intersection_params_spline_v)
     , m_hasPerformed(false)
+    , m_degreeElevated(false)
     , m_tol(tol)
+    , m_monitor(nullptr)
+    , m_monitorWeight(0.)
 {
 }
 
@@ -72,6 +113,19 @@ Handle(Geom_BSplineSurface) GordonSurfaceBuilder::SurfaceIntersections()
     return m_tensorProdSurf;
 }
 
+bool GordonSurfaceBuilder::DegreeElevated()
+{
+    Perform();
+
+    return m_degreeElevated;
+}
+
+void GordonSurfaceBuilder::SetTaskMonitor(TaskMonitor* monitor, double weight)
+{
+    m_monitor = monitor;
+    m_monitorWeight = weight;
+}
+
 void GordonSurfaceBuilder::Perform()
 {
     if (m_hasPerformed) {
@@ -110,28 +164,18 @@ void GordonSurfaceBuilder::CreateGordonSurface(const std::vector<Handle(Geom_BSp
         assertRange(*it, vmin, vmax, 1e-5);
     }
 
+    // setting everything up for creating Tensor Product Surface by interpolating intersection points of profiles and guides with B-Spline surface
+    // find the intersection points and check the compatibility of the network at the same time
+    TColgp_Array2OfPnt intersection_pnts(1, static_cast<Standard_Integer>(intersection_params_spline_u.size()),
+                                         1, static_cast<Standard_Integer>(intersection_params_spline_v.size()));
+
     // TODO: Do we really need to check compatibility?
     // We don't need to do this, if the curves were reparametrized before
     // In this case, they might be even incompatible, as the curves have been approximated
     CheckCurveNetworkCompatibility(profiles, guides,
                                    intersection_params_spline_u,
                                    intersection_params_spline_v,
-                                   m_tol);
-
-    // setting everything up for creating Tensor Product Surface by interpolating intersection points of profiles and guides with B-Spline surface
-    // find the intersection points:
-    TColgp_Array2OfPnt intersection_pnts(1, static_cast<Standard_Integer>(intersection_params_spline_u.size()),
-                                         1, static_cast<Standard_Integer>(intersection_params_spline_v.size()));
-
-    // use splines in u-direction to get intersection points
-    for (size_t spline_idx = 0; spline_idx < profiles.size(); ++spline_idx) {
-        for (size_t intersection_idx = 0; intersection_idx < intersection_params_spline_u.size(); ++intersection_idx) {
-            Handle(Geom_BSplineCurve) spline_u = profiles[spline_idx];
-            double parameter = intersection_params_spline_u[intersection_idx];
-            intersection_pnts(static_cast<Standard_Integer>(intersection_idx + 1),
-                              static_cast<Standard_Integer>(spline_idx + 1)) = spline_u->Value(parameter);
-        }
-    }
+                                   m_tol, intersection_pnts);
 
     // check, whether to build a closed continuous surface
     double curve_u_tolerance = BSplineAlgorithms::REL_TOL_CLOSED * BSplineAlgorithms::scale(guides);
@@ -141,15 +185,35 @@ void GordonSurfaceBuilder::CreateGordonSurface(const std::vector<Handle(Geom_BSp
     bool makeUClosed = BSplineAlgorithms::isUDirClosed(intersection_pnts, tp_tolerance) && guides.front()->IsEqual(guides.back(), curve_u_tolerance);
     bool makeVClosed = BSplineAlgorithms::isVDirClosed(intersection_pnts, tp_tolerance) && profiles.front()->IsEqual(profiles.back(), curve_v_tolerance);
 
+    // Work out the common degrees of the three surfaces up front. The curves are elevated
+    // and all surfaces are interpolated directly at these degrees. Hence, the full
+    // surfaces don't have to be elevated, which would increase the knot multiplicities.
+    const int degreeU = std::max(maxDegree(profiles), interpolationDegree(guides.size(), makeUClosed));
+    const int degreeV = std::max(maxDegree(guides), interpolationDegree(profiles.size(), makeVClosed));
+
     // Skinning in v-direction with u directional B-Splines
-    CurvesToSurface surfProfilesSkinner(std::vector<Handle(Geom_Curve)>(profiles.begin(), profiles.end()), intersection_params_spline_v, makeVClosed);
+    if (m_monitor) {
+        m_monitor->BeginStage("profile skinning", 0.4 * m_monitorWeight);
+    }
+    CurvesToSurface surfProfilesSkinner(elevatedCurves(profiles, degreeU), intersection_params_spline_v, makeVClosed);
+    surfProfilesSkinner.SetMaxDegree(degreeV);
+    surfProfilesSkinner.SetTaskMonitor(m_monitor);
     Handle(Geom_BSplineSurface) surfProfiles = surfProfilesSkinner.Surface();
     // therefore reparametrization before this method
 
     // Skinning in u-direction with v directional B-Splines
-    CurvesToSurface surfGuidesSkinner(std::vector<Handle(Geom_Curve)>(guides.begin(), guides.end()), intersection_params_spline_u, makeUClosed);
+    if (m_monitor) {
+        m_monitor->BeginStage("guide skinning", 0.4 * m_monitorWeight);
+    }
+    CurvesToSurface surfGuidesSkinner(elevatedCurves(guides, degreeV), intersection_params_spline_u, makeUClosed);
+    surfGuidesSkinner.SetMaxDegree(degreeU);
+    surfGuidesSkinner.SetTaskMonitor(m_monitor);
     Handle(Geom_BSplineSurface) surfGuides = surfGuidesSkinner.Surface();
 
+    if (m_monitor) {
+        m_monitor->BeginStage("gordon surface", 0.2 * m_monitorWeight);
+    }
+
     // flipping of the surface in v-direction; flipping is redundant here, therefore the next line is a comment!
     surfGuides = BSplineAlgorithms::flipSurface(surfGuides);
 
@@ -158,20 +222,18 @@ void GordonSurfaceBuilder::CreateGordonSurface(const std::vector<Handle(Geom_BSp
     // Open CASCADE doesn't have a B-spline surface interpolation method where one can give the u- and v-directional parameters as arguments
     Handle(Geom_BSplineSurface) tensorProdSurf = BSplineAlgorithms::pointsToSurface(intersection_pnts,
                                                                                          intersection_params_spline_u, intersection_params_spline_v,
-                                                                                         makeUClosed, makeVClosed);
-    // match degree of all three surfaces
-    Standard_Integer degreeU = std::max(std::max(surfGuides->UDegree(),
-                                                 surfProfiles->UDegree()),
-                                                 tensorProdSurf->UDegree());
-
-    Standard_Integer degreeV = std::max(std::max(surfGuides->VDegree(),
-                                                 surfProfiles->VDegree()),
-                                                 tensorProdSurf->VDegree());
-
-    // check whether degree elevation is necessary (does method elevate_degree_u()) and if yes, elevate degree
-    surfGuides->IncreaseDegree(degreeU, degreeV);
-    surfProfiles->IncreaseDegree(degreeU, degreeV);
-    tensorProdSurf->IncreaseDegree(degreeU, degreeV);
+                                                                                         makeUClosed, makeVClosed,
+                                                                                         degreeU, degreeV);
+
+    // The interpolation degree is limited by the number of curves.
+    // Only in this case, the surfaces still have to be elevated.
+    m_degreeElevated = false;
+    for (const Handle(Geom_BSplineSurface)& surface : {surfGuides, surfProfiles, tensorProdSurf}) {
+        if (surface->UDegree() < degreeU || surface->VDegree() < degreeV) {
+            surface->IncreaseDegree(degreeU, degreeV);
+            m_degreeElevated = true;
+        }
+    }
 
     std::vector<Handle(Geom_BSplineSurface)> surfaces_vector_unmod;
     surfaces_vector_unmod.push_back(surfGuides);
@@ -209,7 +271,8 @@ void GordonSurfaceBuilder::CheckCurveNetworkCompatibility(const std::vector<Hand
                                                                const std::vector<Handle(Geom_BSplineCurve) >& guides,
                                                                const std::vector<double>& intersection_params_spline_u,
                                                                const std::vector<double>& intersection_params_spline_v,
-                                                               double tol)
+                                                               double tol,
+                                                               TColgp_Array2OfPnt& intersection_pnts)
 {
     // find out the 'average' scale of the B-splines in order to being able to handle a more approximate dataset and find its intersections
     double splines_scale = 0.5 * (BSplineAlgorithms::scale(profiles)+ BSplineAlgorithms::scale(guides));
@@ -222,21 +285,28 @@ void GordonSurfaceBuilder::CheckCurveNetworkCompatibility(const std::vector<Hand
         throw error("WARNING: B-splines in v-direction mustn't stick out, spline network must be 'closed'!");
     }
 
+    // Evaluate all profiles and guides once at the intersection parameters.
+    // As the curves share their knots after the reparametrization, the
+    // basis functions are computed only once per parameter.
+    const size_t nProfiles = profiles.size();
+    const size_t nGuides = guides.size();
+    std::vector<gp_XYZ> profilePnts = BSplineAlgorithms::evaluateCurvesSorted(profiles, intersection_params_spline_u);
+    std::vector<gp_XYZ> guidePnts = BSplineAlgorithms::evaluateCurvesSorted(guides, intersection_params_spline_v);
+
     // check compatibilty of network
     for (size_t u_param_idx = 0; u_param_idx < intersection_params_spline_u.size(); ++u_param_idx) {
-        double spline_u_param = intersection_params_spline_u[u_param_idx];
-        const Handle(Geom_BSplineCurve)& spline_v = guides[u_param_idx];
         for (size_t v_param_idx = 0; v_param_idx < intersection_params_spline_v.size(); ++v_param_idx) {
-            const Handle(Geom_BSplineCurve)& spline_u = profiles[v_param_idx];
-            double spline_v_param = intersection_params_spline_v[v_param_idx];
-
-            gp_Pnt p_prof = spline_u->Value(spline_u_param);
-            gp_Pnt p_guid = spline_v->Value(spline_v_param);
-            double distance = p_prof.Distance(p_guid);
+            const gp_XYZ& p_prof = profilePnts[u_param_idx * nProfiles + v_param_idx];
+            const gp_XYZ& p_guid = guidePnts[v_param_idx * nGuides + u_param_idx];
+            double distance = (p_prof - p_guid).Modulus();
 
             if (distance > splines_scale * tol) {
                 throw error("B-spline network is incompatible (e.g. wrong parametrization) or intersection parameters are in a wrong order!");
             }
+
+            // use splines in u-direction to get intersection points
+            intersection_pnts(static_cast<Standard_Integer>(u_param_idx + 1),
+                              static_cast<Standard_Integer>(v_param_idx + 1)) = gp_Pnt(p_prof);
         }
     }
 }
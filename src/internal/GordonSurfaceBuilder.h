@@ -13,10 +13,13 @@
 #include <vector>
 #include <Geom_BSplineSurface.hxx>
 #include <Geom_BSplineCurve.hxx>
+#include <TColgp_Array2OfPnt.hxx>
 
 namespace occ_gordon_internal
 {
 
+class TaskMonitor;
+
 /**
  * @brief This class is basically a helper class for the occ_gordon_internal::InterpolateCurveNetwork algorithm.
  * 
@@ -65,15 +68,35 @@ public:
     
     /// Returns the Surface that interpolations the intersection point of both surfaces
     Handle(Geom_BSplineSurface) SurfaceIntersections();
+
+    /**
+     * @brief Returns true, if a component surface had to be degree elevated
+     *
+     * Usually, all surfaces are built at the common degree directly. Only if there are
+     * too few curves to interpolate them at this degree, the surface is elevated afterwards,
+     * which increases its knot multiplicities.
+     */
+    bool DegreeElevated();
+
+    /**
+     * @brief Reports the progress of the surface creation to the monitor
+     *
+     * The skinning of the profiles and guides and the creation of the
+     * gordon surface are reported as stages with a total weight of weight.
+     * The monitor is not owned and must live until the surface is computed.
+     */
+    void SetTaskMonitor(TaskMonitor* monitor, double weight);
     
 private:
     void Perform();
 
+    /// Checks the compatibility of the network and computes the intersection points of profiles and guides
     void CheckCurveNetworkCompatibility(const std::vector<Handle(Geom_BSplineCurve) >& profiles,
                                         const std::vector<Handle(Geom_BSplineCurve) >& guides,
                                         const std::vector<double>& intersection_params_spline_u,
                                         const std::vector<double>& intersection_params_spline_v,
-                                        double tol);
+                                        double tol,
+                                        TColgp_Array2OfPnt& intersection_pnts);
 
     void CreateGordonSurface(const std::vector<Handle(Geom_BSplineCurve)>& profiles,
                              const std::vector<Handle(Geom_BSplineCurve)>& guides,
@@ -86,7 +109,10 @@ private:
     const std::vector<double>& m_intersection_params_spline_u, m_intersection_params_spline_v;
     Handle(Geom_BSplineSurface) m_skinningSurfProfiles, m_skinningSurfGuides, m_tensorProdSurf, m_gordonSurf;
     bool m_hasPerformed;
+    bool m_degreeElevated;
     double m_tol;
+    TaskMonitor* m_monitor;
+    double m_monitorWeight;
 };
 
 } // namespace occ_gordon_internal
@@ -10,16 +10,26 @@
 
 #include "internal/Error.h"
 
+#include "ApproxSystemCache.h"
 #include "BSplineAlgorithms.h"
+#include "BSplineSurfaceEvaluator.h"
 #include "CurveNetworkSorter.h"
 #include "GordonSurfaceBuilder.h"
+#include "MonotoneCubicInterpolation.h"
+#include "Parallel.h"
+#include "TaskMonitor.h"
 
+#include <BSplCLib.hxx>
 #include <math_Matrix.hxx>
+#include <TColStd_Array1OfReal.hxx>
 #include <TColStd_HArray1OfReal.hxx>
 #include <GeomConvert.hxx>
 
 #include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
 #include <sstream>
 #include <iostream>
 #include <iomanip>
@@ -28,6 +38,201 @@
 namespace occ_gordon_internal
 {
 
+namespace
+{
+
+// eliminate small inaccuracies at the first and last knot
+void SnapToUnitRange(std::vector<double>& parameters)
+{
+    if (std::abs(parameters.front()) < BSplineAlgorithms::PAR_CHECK_TOL) {
+        parameters.front() = 0;
+    }
+
+    if (std::abs(parameters.back() - 1) < BSplineAlgorithms::PAR_CHECK_TOL) {
+        parameters.back() = 1;
+    }
+}
+
+// Maps parameters of a reparametrized curve onto the parameters of the curve before
+// the reparametrization. This is the same function as used by the reparametrization.
+std::vector<double> InputParameters(ReparametrizationMode mode,
+                                    const std::vector<double>& newParameters,
+                                    const std::vector<double>& oldParameters,
+                                    const std::vector<double>& parameters)
+{
+    std::vector<double> result(parameters.size());
+    if (mode == ReparametrizationMode::ExactComposition) {
+        // piecewise linear between the intersections
+        for (size_t i = 0; i < parameters.size(); ++i) {
+            const size_t k = static_cast<size_t>(
+                std::upper_bound(newParameters.begin() + 1, newParameters.end() - 1, parameters[i]) - newParameters.begin()) - 1;
+            const double t = (parameters[i] - newParameters[k]) / (newParameters[k + 1] - newParameters[k]);
+            result[i] = oldParameters[k] + t * (oldParameters[k + 1] - oldParameters[k]);
+        }
+    }
+    else {
+        MonotoneCubicInterpolation reparametrizingFunction(newParameters, oldParameters);
+        for (size_t i = 0; i < parameters.size(); ++i) {
+            result[i] = reparametrizingFunction.Value(parameters[i]);
+        }
+    }
+    return result;
+}
+
+// Maps the parameters with the indices first to last affinely onto [0, 1]
+std::vector<double> LocalParameters(const std::vector<double>& parameters, size_t first, size_t last)
+{
+    const double offset = parameters[first];
+    const double length = parameters[last] - parameters[first];
+
+    std::vector<double> result;
+    for (size_t i = first; i <= last; ++i) {
+        result.push_back((parameters[i] - offset) / length);
+    }
+    result.front() = 0.;
+    result.back() = 1.;
+    return result;
+}
+
+// Range of crossing curves interpolated by one block of the decomposition
+struct CurveBlock
+{
+    // curves at the boundaries of the patch
+    size_t first, last;
+
+    // curves at the boundaries of the block, including the overlap
+    size_t extendedFirst, extendedLast;
+};
+
+// Splits the curves 0, ..., nCurves - 1 into blocks of nearly equal size with at most
+// blockSize curves. Neighboring blocks share their boundary curve.
+std::vector<CurveBlock> CurveBlocks(size_t nCurves, size_t blockSize, size_t overlap)
+{
+    const size_t nIntervals = nCurves - 1;
+    const size_t nBlocks = (nIntervals + blockSize - 2) / (blockSize - 1);
+
+    std::vector<CurveBlock> blocks(nBlocks);
+    for (size_t iblock = 0; iblock < nBlocks; ++iblock) {
+        CurveBlock& block = blocks[iblock];
+        block.first = iblock * nIntervals / nBlocks;
+        block.last = (iblock + 1) * nIntervals / nBlocks;
+        block.extendedFirst = block.first > overlap ? block.first - overlap : 0;
+        block.extendedLast = std::min(block.last + overlap, nIntervals);
+    }
+    return blocks;
+}
+
+// Maps the sorted parameters of a curve, which has been reparametrized segment wise per block
+// (see InterpolateCurveNetwork::ReparametrizeSegments), onto the parameters of the input curve.
+// Each parameter is mapped by the reparametrization of the block, whose patch contains it.
+std::vector<double> BlockInputParameters(ReparametrizationMode mode,
+                                         const std::vector<double>& newParameters,
+                                         const std::vector<double>& oldParameters,
+                                         const std::vector<CurveBlock>& blocks,
+                                         const std::vector<double>& parameters)
+{
+    std::vector<double> result;
+    result.reserve(parameters.size());
+    size_t iparam = 0;
+    for (size_t iblock = 0; iblock < blocks.size(); ++iblock) {
+        const CurveBlock& block = blocks[iblock];
+        const double offset = newParameters[block.extendedFirst];
+        const double length = newParameters[block.extendedLast] - offset;
+        const bool isLast = iblock + 1 == blocks.size();
+
+        std::vector<double> localParameters;
+        for (; iparam < parameters.size() && (isLast || parameters[iparam] <= newParameters[block.last]); ++iparam) {
+            localParameters.push_back((parameters[iparam] - offset) / length);
+        }
+
+        const std::vector<double> oldSegmentParameters(oldParameters.begin() + static_cast<std::ptrdiff_t>(block.extendedFirst),
+                                                       oldParameters.begin() + static_cast<std::ptrdiff_t>(block.extendedLast) + 1);
+        const std::vector<double> mapped = InputParameters(mode, LocalParameters(newParameters, block.extendedFirst, block.extendedLast),
+                                                           oldSegmentParameters, localParameters);
+        result.insert(result.end(), mapped.begin(), mapped.end());
+    }
+    return result;
+}
+
+// By construction, the 3 surfaces of the gordon method could have different degrees
+// resulting in a higher knot multiplicity. This then results
+// in OCCT reporting lower continuity.
+// To fix it, we try to remove those knots using a small tolerance
+// If successful, this surface should remain unchainged within the
+// tolerance. We want at least C2.
+void EnsureC2(const Handle(Geom_BSplineSurface)& surface, double tolerance)
+{
+    assert(surface);
+
+    int minUMult = std::max(1, surface->UDegree() - 2);
+    for (int iu = 2; iu <= surface->NbUKnots()-1; ++iu)
+    {
+        if (surface->UMultiplicity(iu) > minUMult)
+        {
+            surface->RemoveUKnot(iu, minUMult, tolerance);
+        }
+    }
+
+    int minVMult = std::max(1, surface->VDegree() - 2);
+    for (int iv = 2; iv <= surface->NbVKnots()-1; ++iv)
+    {
+        if (surface->VMultiplicity(iv) > minVMult)
+        {
+            surface->RemoveVKnot(iv, minVMult, tolerance);
+        }
+    }
+}
+
+// Interpolates one block of the network and trims the surface to the patch of the block,
+// which is mapped onto the parameters of the whole network
+Handle(Geom_BSplineSurface) InterpolateBlock(const std::vector<ApproxResult>& profileSegments,
+                                             const std::vector<ApproxResult>& guideSegments,
+                                             const std::vector<double>& parametersU,
+                                             const std::vector<double>& parametersV,
+                                             const CurveBlock& blockU,
+                                             const CurveBlock& blockV,
+                                             double spatialTolerance)
+{
+    std::vector<Handle(Geom_BSplineCurve)> profiles, guides;
+    for (size_t iprofile = blockV.extendedFirst; iprofile <= blockV.extendedLast; ++iprofile) {
+        profiles.push_back(profileSegments[iprofile].curve);
+    }
+    for (size_t iguide = blockU.extendedFirst; iguide <= blockU.extendedLast; ++iguide) {
+        guides.push_back(guideSegments[iguide].curve);
+    }
+
+    const std::vector<double> blockParametersU = LocalParameters(parametersU, blockU.extendedFirst, blockU.extendedLast);
+    const std::vector<double> blockParametersV = LocalParameters(parametersV, blockV.extendedFirst, blockV.extendedLast);
+
+    GordonSurfaceBuilder builder(profiles, guides, blockParametersU, blockParametersV, spatialTolerance);
+    Handle(Geom_BSplineSurface) patch = builder.SurfaceGordon();
+    if (builder.DegreeElevated()) {
+        EnsureC2(patch, spatialTolerance);
+    }
+
+    patch->Segment(blockParametersU[blockU.first - blockU.extendedFirst], blockParametersU[blockU.last - blockU.extendedFirst],
+                   blockParametersV[blockV.first - blockV.extendedFirst], blockParametersV[blockV.last - blockV.extendedFirst]);
+
+    // neighboring patches must share the parameters of their seam exactly
+    TColStd_Array1OfReal uKnots(1, patch->NbUKnots());
+    patch->UKnots(uKnots);
+    BSplCLib::Reparametrize(parametersU[blockU.first], parametersU[blockU.last], uKnots);
+    uKnots(uKnots.Lower()) = parametersU[blockU.first];
+    uKnots(uKnots.Upper()) = parametersU[blockU.last];
+    patch->SetUKnots(uKnots);
+
+    TColStd_Array1OfReal vKnots(1, patch->NbVKnots());
+    patch->VKnots(vKnots);
+    BSplCLib::Reparametrize(parametersV[blockV.first], parametersV[blockV.last], vKnots);
+    vKnots(vKnots.Lower()) = parametersV[blockV.first];
+    vKnots(vKnots.Upper()) = parametersV[blockV.last];
+    patch->SetVKnots(vKnots);
+
+    return patch;
+}
+
+} // namespace
+
 template <class T>
 T Clamp(T val, T min, T max)
 {
@@ -51,6 +256,19 @@ InterpolateCurveNetwork::InterpolateCurveNetwork(const std::vector<Handle(Geom_B
                                                             double spatialTol)
     : m_hasPerformed(false)
     , m_spatialTol(spatialTol)
+    , m_reparametrizationMode(ReparametrizationMode::Approximation)
+    , m_reparametrizationTol(0.)
+    , m_knotRemovalTol(0.)
+    , m_minControlPoints(10)
+    , m_maxControlPoints(80)
+    , m_minReparametrizationSamples(101)
+    , m_parameterOptimizationIterations(1)
+    , m_nThreads(-1)
+    , m_monitor(nullptr)
+    , m_blockSize(0)
+    , m_blockOverlap(2)
+    , m_nPatchesU(0)
+    , m_nPatchesV(0)
 {
     // check whether there are any u-directional and v-directional B-splines in the vectors
     if (profiles.size() < 2) {
@@ -68,24 +286,28 @@ InterpolateCurveNetwork::InterpolateCurveNetwork(const std::vector<Handle(Geom_B
     // if profiles or guides are closed curves, we will add the first curve at the end later
     // after sorting the intersection matrix
     std::vector<Handle(Geom_BSplineCurve)> uniqueProfiles;
-    for (const auto& profile : profiles) {
+    for (size_t iprofile = 0; iprofile < profiles.size(); ++iprofile) {
+        const Handle(Geom_BSplineCurve)& profile = profiles[iprofile];
         const bool isUnique = std::none_of(uniqueProfiles.begin(), uniqueProfiles.end(), [&](const Handle(Geom_BSplineCurve) & curve) {
             return profile->IsEqual(curve, Precision::Confusion());
         });
 
         if (isUnique) {
             uniqueProfiles.push_back(profile);
+            m_profileInputIndices.push_back(iprofile);
         }
     }
 
     std::vector<Handle(Geom_BSplineCurve)> uniqueGuides;
-    for (const auto& guide : guides) {
+    for (size_t iguide = 0; iguide < guides.size(); ++iguide) {
+        const Handle(Geom_BSplineCurve)& guide = guides[iguide];
         const bool isUnique = std::none_of(uniqueGuides.begin(), uniqueGuides.end(), [&](const Handle(Geom_BSplineCurve) & curve) {
             return guide->IsEqual(curve, Precision::Confusion());
         });
 
         if (isUnique) {
             uniqueGuides.push_back(guide);
+            m_guideInputIndices.push_back(iguide);
         }
     }
 
@@ -104,15 +326,83 @@ InterpolateCurveNetwork::InterpolateCurveNetwork(const std::vector<Handle(Geom_B
     m_profiles.reserve(uniqueProfiles.size());
     m_guides.reserve(uniqueGuides.size());
 
-    // Store the curves
+    // Store copies of the curves. The algorithm reparametrizes and reverses the curves,
+    // which must not modify the curves of the caller, that might be used by other threads.
     for (auto&& profile : uniqueProfiles) {
-        m_profiles.push_back(profile);
+        m_profiles.push_back(Handle(Geom_BSplineCurve)::DownCast(profile->Copy()));
     }
     for (auto&& guide : uniqueGuides) {
-        m_guides.push_back(guide);
+        m_guides.push_back(Handle(Geom_BSplineCurve)::DownCast(guide->Copy()));
+    }
+}
+
+
+void InterpolateCurveNetwork::SetReparametrizationMode(ReparametrizationMode mode)
+{
+    if (mode == ReparametrizationMode::ExactComposition && m_blockSize > 0) {
+        throw error("The exact reparametrization cannot be combined with a block decomposition.", MATH_ERROR);
+    }
+    m_reparametrizationMode = mode;
+}
+
+void InterpolateCurveNetwork::SetReparametrizationTolerance(double tolerance)
+{
+    m_reparametrizationTol = tolerance;
+}
+
+void InterpolateCurveNetwork::SetKnotRemovalTolerance(double tolerance)
+{
+    m_knotRemovalTol = tolerance;
+}
+
+void InterpolateCurveNetwork::SetControlPointLimits(size_t minControlPoints, size_t maxControlPoints)
+{
+    if (minControlPoints > maxControlPoints) {
+        throw error("The minimum number of control points must not exceed the maximum number.", MATH_ERROR);
     }
+    m_minControlPoints = minControlPoints;
+    m_maxControlPoints = maxControlPoints;
+}
+
+void InterpolateCurveNetwork::SetMinReparametrizationSamples(size_t nSamples)
+{
+    m_minReparametrizationSamples = nSamples;
+}
+
+void InterpolateCurveNetwork::SetParameterOptimizationIterations(int nIterations)
+{
+    m_parameterOptimizationIterations = nIterations;
+}
+
+void InterpolateCurveNetwork::SetIntersectionOptions(const IntersectBSplinesOptions& options)
+{
+    m_intersectionOptions = options;
+}
+
+void InterpolateCurveNetwork::SetNumberOfThreads(int nThreads)
+{
+    m_nThreads = nThreads;
+}
+
+void InterpolateCurveNetwork::SetTaskMonitor(TaskMonitor* monitor)
+{
+    m_monitor = monitor;
 }
 
+void InterpolateCurveNetwork::SetBlockDecomposition(size_t blockSize, size_t overlap)
+{
+    if (blockSize == 1) {
+        throw error("A block of the curve network must contain at least two curves in each direction.", MATH_ERROR);
+    }
+    if (overlap < 1) {
+        throw error("The blocks of the curve network must overlap by at least one curve.", MATH_ERROR);
+    }
+    if (blockSize > 0 && m_reparametrizationMode == ReparametrizationMode::ExactComposition) {
+        throw error("The exact reparametrization cannot be combined with a block decomposition.", MATH_ERROR);
+    }
+    m_blockSize = blockSize;
+    m_blockOverlap = overlap;
+}
 
 void InterpolateCurveNetwork::ComputeIntersections(math_Matrix& intersection_params_u,
     math_Matrix& intersection_params_v) const
@@ -124,7 +414,7 @@ void InterpolateCurveNetwork::ComputeIntersections(math_Matrix& intersection_par
         for (int spline_v_idx = 0; spline_v_idx < static_cast<int>(guides.size()); ++spline_v_idx) {
             std::vector<std::pair<double, double> > currentIntersections = BSplineAlgorithms::intersections(profiles[static_cast<size_t>(spline_u_idx)],
                 guides[static_cast<size_t>(spline_v_idx)],
-                m_spatialTol);
+                m_spatialTol, m_intersectionOptions);
             if (currentIntersections.size() < 1) {
                 throw error("U-directional B-spline and V-directional B-spline don't intersect "
                     "each other!");
@@ -148,6 +438,12 @@ void InterpolateCurveNetwork::ComputeIntersections(math_Matrix& intersection_par
                 throw error("U-directional B-spline and V-directional B-spline have more than two intersections with each other! "
                     "Closed in bot U and V directions surface isn't supported at this time");
             }
+
+            if (m_monitor) {
+                size_t nPairs = profiles.size() * guides.size();
+                size_t iPair = static_cast<size_t>(spline_u_idx) * guides.size() + static_cast<size_t>(spline_v_idx) + 1;
+                m_monitor->SetStageProgress(static_cast<double>(iPair) / static_cast<double>(nPairs));
+            }
         }
     }
 }
@@ -173,9 +469,19 @@ void InterpolateCurveNetwork::SortCurves(math_Matrix& intersection_params_u, mat
 
     std::transform(sorterObj.Profiles().begin(), sorterObj.Profiles().end(), m_profiles.begin(), caster);
     std::transform(sorterObj.Guides().begin(), sorterObj.Guides().end(), m_guides.begin(), caster);
+
+    // keep track of the input index of each sorted curve
+    const std::vector<size_t> profileInputIndices = m_profileInputIndices;
+    for (size_t iprofile = 0; iprofile < m_profileInputIndices.size(); ++iprofile) {
+        m_profileInputIndices[iprofile] = profileInputIndices[sorterObj.ProfilePermutation()[iprofile]];
+    }
+    const std::vector<size_t> guideInputIndices = m_guideInputIndices;
+    for (size_t iguide = 0; iguide < m_guideInputIndices.size(); ++iguide) {
+        m_guideInputIndices[iguide] = guideInputIndices[sorterObj.GuidePermutation()[iguide]];
+    }
 }
 
-void InterpolateCurveNetwork::MakeCurvesCompatible()
+void InterpolateCurveNetwork::ComputeNetworkParameters()
 {
 
     // reparametrize into [0,1]
@@ -197,6 +503,9 @@ void InterpolateCurveNetwork::MakeCurvesCompatible()
     // closed profiles/guides should not be handled by this method ideally
     // it will only work if first profile/guide intersects with guide/profile at it's lowest parameter
     // We cover case when curves alredy somewhat sorted and for closed profiles we already have 1 additional guide
+    if (m_monitor) {
+        m_monitor->BeginStage("intersections", 0.3);
+    }
     ComputeIntersections(tmp_intersection_params_u, tmp_intersection_params_v);
 
     // sort intersection_params_u and intersection_params_v and u-directional and v-directional B-spline curves
@@ -216,6 +525,7 @@ void InterpolateCurveNetwork::MakeCurvesCompatible()
 
     if (isClosedProfile) {
         m_guides.push_back(m_guides.front());
+        m_guideInputIndices.push_back(m_guideInputIndices.front());
         ++nGuides;
 
         // profiles
@@ -238,6 +548,7 @@ void InterpolateCurveNetwork::MakeCurvesCompatible()
     }
     else if (isClosedGuides) {
         m_profiles.push_back(m_profiles.front());
+        m_profileInputIndices.push_back(m_profileInputIndices.front());
         ++nProfiles;
 
         for (int spline_v_idx = 0; spline_v_idx < nGuides; ++spline_v_idx) {
@@ -286,135 +597,219 @@ void InterpolateCurveNetwork::MakeCurvesCompatible()
         throw error("At least one B-splines has no intersection at the beginning.");
     }
 
-    // Get maximum number of control points to figure out detail of spline
-    size_t max_cp_u = 0, max_cp_v = 0;
-    for(CurveArray::const_iterator it = m_profiles.begin(); it != m_profiles.end(); ++it) {
-        max_cp_u = std::max(max_cp_u, static_cast<size_t>((*it)->NbPoles()));
-    }
-    for(CurveArray::const_iterator it = m_guides.begin(); it != m_guides.end(); ++it) {
-        max_cp_v = std::max(max_cp_v, static_cast<size_t>((*it)->NbPoles()));
-    }
-
-    // we want to use at least 10 and max 80 control points to be able to reparametrize the geometry properly
-    size_t mincp = 10;
-    size_t maxcp = 80;
-
-    // since we interpolate the intersections, we cannot use fewer control points than curves
-    // We need to add two since we want c2 continuity, which adds two equations
-    size_t min_u = std::max(m_guides.size() + 2, mincp);
-    size_t min_v = std::max(m_profiles.size() + 2, mincp);
-
-    size_t max_u = std::max(min_u, maxcp);
-    size_t max_v = std::max(min_v, maxcp);
+    // eliminate small inaccuracies at the first and last knot
+    SnapToUnitRange(newParametersProfiles);
+    SnapToUnitRange(newParametersGuides);
 
-    max_cp_u = Clamp(max_cp_u + 10, min_u, max_u);
-    max_cp_v = Clamp(max_cp_v + 10, min_v, max_v);
-
-    // reparametrize u-directional B-splines
+    std::vector<std::vector<double>> oldParametersProfiles(static_cast<size_t>(nProfiles));
     for (int spline_u_idx = 0; spline_u_idx < nProfiles; ++spline_u_idx) {
-
-        std::vector<double> oldParametersProfile;
+        std::vector<double>& oldParametersProfile = oldParametersProfiles[static_cast<size_t>(spline_u_idx)];
         for (int spline_v_idx = 0; spline_v_idx < nGuides; ++spline_v_idx) {
             oldParametersProfile.push_back(intersection_params_u(spline_u_idx, spline_v_idx));
         }
+        SnapToUnitRange(oldParametersProfile);
+    }
 
-        // eliminate small inaccuracies at the first knot
-        if (std::abs(oldParametersProfile.front()) < BSplineAlgorithms::PAR_CHECK_TOL) {
-            oldParametersProfile.front() = 0;
+    std::vector<std::vector<double>> oldParametersGuides(static_cast<size_t>(nGuides));
+    for (int spline_v_idx = 0; spline_v_idx < nGuides; ++spline_v_idx) {
+        std::vector<double>& oldParameterGuide = oldParametersGuides[static_cast<size_t>(spline_v_idx)];
+        for (int spline_u_idx = 0; spline_u_idx < nProfiles; ++spline_u_idx) {
+            oldParameterGuide.push_back(intersection_params_v(spline_u_idx, spline_v_idx));
         }
+        SnapToUnitRange(oldParameterGuide);
+    }
 
-        if (std::abs(newParametersProfiles.front()) < BSplineAlgorithms::PAR_CHECK_TOL) {
-            newParametersProfiles.front() = 0;
-        }
+    // the curves before the reparametrization are kept to validate the surface
+    m_inputProfiles = m_profiles;
+    m_inputGuides = m_guides;
+    m_oldParametersProfiles = oldParametersProfiles;
+    m_oldParametersGuides = oldParametersGuides;
 
-        // eliminate small inaccuracies at the last knot
-        if (std::abs(oldParametersProfile.back() - 1) < BSplineAlgorithms::PAR_CHECK_TOL) {
-            oldParametersProfile.back() = 1;
-        }
+    m_intersectionParamsU = newParametersProfiles;
+    m_intersectionParamsV = newParametersGuides;
+}
 
-        if (std::abs(newParametersProfiles.back() - 1) < BSplineAlgorithms::PAR_CHECK_TOL) {
-            newParametersProfiles.back() = 1;
-        }
+void InterpolateCurveNetwork::ReparametrizeNetwork()
+{
+    // all profiles are approximated at the same parameters, hence they
+    // mostly share the same linear system. The same holds for the guides.
+    // The adaptive mode visits each candidate size only once, hence only the
+    // curves of one family share the systems of a size.
+    ApproxSystemCache profileSystems(32), guideSystems(32);
+
+    if (m_monitor) {
+        m_monitor->BeginStage("profile reparametrization", 0.15);
+    }
+    std::vector<ApproxResult> profileResults = ReparametrizeFamily(m_inputProfiles, m_oldParametersProfiles, m_intersectionParamsU,
+                                                                   profileSystems, "profile");
+    if (m_monitor) {
+        m_monitor->BeginStage("guide reparametrization", 0.15);
+    }
+    std::vector<ApproxResult> guideResults = ReparametrizeFamily(m_inputGuides, m_oldParametersGuides, m_intersectionParamsV,
+                                                                 guideSystems, "guide");
 
-        Handle(Geom_BSplineCurve)& profile = m_profiles[static_cast<size_t>(spline_u_idx)];
-        try {
-            profile = BSplineAlgorithms::reparametrizeBSplineContinuouslyApprox(profile, oldParametersProfile, newParametersProfiles, max_cp_u).curve;
-        }
-        catch (const Standard_Failure& err) {
-            std::ostringstream oss;
-            const Standard_CString msg = err.GetMessageString();
-            oss << "Profile reparametrization failed at profile index " << spline_u_idx
-                << " (OCCT Standard_Failure): " << (msg ? msg : "<empty>");
-            throw error(oss.str());
-        }
-        catch (const std::exception& err) {
-            std::ostringstream oss;
-            oss << "Profile reparametrization failed at profile index " << spline_u_idx
-                << ": " << err.what();
-            throw error(oss.str());
-        }
-        catch (...) {
-            std::ostringstream oss;
-            oss << "Profile reparametrization failed at profile index " << spline_u_idx
-                << ": unknown non-standard exception";
-            throw error(oss.str());
-        }
+    m_reparametrizationErrorsProfiles.clear();
+    for (size_t iprofile = 0; iprofile < profileResults.size(); ++iprofile) {
+        m_profiles[iprofile] = profileResults[iprofile].curve;
+        m_reparametrizationErrorsProfiles.push_back(profileResults[iprofile].error);
     }
 
-    // reparametrize v-directional B-splines
-    for (int spline_v_idx = 0; spline_v_idx < nGuides; ++spline_v_idx) {
+    m_reparametrizationErrorsGuides.clear();
+    for (size_t iguide = 0; iguide < guideResults.size(); ++iguide) {
+        m_guides[iguide] = guideResults[iguide].curve;
+        m_reparametrizationErrorsGuides.push_back(guideResults[iguide].error);
+    }
+}
 
-        std::vector<double> oldParameterGuide;
-        for (int spline_u_idx = 0; spline_u_idx < nProfiles; ++spline_u_idx) {
-            oldParameterGuide.push_back(intersection_params_v(spline_u_idx, spline_v_idx));
-        }
+std::vector<ApproxResult> InterpolateCurveNetwork::ReparametrizeFamily(const CurveArray& curves,
+                                                                     const std::vector<std::vector<double>>& oldParameters,
+                                                                     const std::vector<double>& newParameters,
+                                                                     ApproxSystemCache& cache,
+                                                                     const std::string& curveType) const
+{
+    // Get maximum number of control points to figure out detail of spline
+    size_t max_cp = 0;
+    for (CurveArray::const_iterator it = curves.begin(); it != curves.end(); ++it) {
+        max_cp = std::max(max_cp, static_cast<size_t>((*it)->NbPoles()));
+    }
 
-        // eliminate small inaccuracies at the first knot
-        if (std::abs(oldParameterGuide.front()) < BSplineAlgorithms::PAR_CHECK_TOL) {
-            oldParameterGuide.front() = 0;
-        }
+    // we want to use at least 10 and max 80 control points (by default) to be able to reparametrize the geometry properly
+    size_t mincp = m_minControlPoints;
+    size_t maxcp = m_maxControlPoints;
 
-        if (std::abs(newParametersGuides.front()) < BSplineAlgorithms::PAR_CHECK_TOL) {
-            newParametersGuides.front() = 0;
-        }
+    // since we interpolate the intersections, we cannot use fewer control points than crossing curves
+    // We need to add two since we want c2 continuity, which adds two equations
+    size_t min_cp = std::max(newParameters.size() + 2, mincp);
 
-        // eliminate small inaccuracies at the last knot
-        if (std::abs(oldParameterGuide.back() - 1) < BSplineAlgorithms::PAR_CHECK_TOL) {
-            oldParameterGuide.back() = 1;
-        }
+    if (m_reparametrizationTol > 0. && m_reparametrizationMode == ReparametrizationMode::Approximation) {
+        // the adaptive mode searches the whole range of the control point limits
+        return ReparametrizeCurvesAdaptive(curves, oldParameters, newParameters,
+                                           min_cp, std::max(min_cp, maxcp), cache, curveType);
+    }
 
-        if (std::abs(newParametersGuides.back() - 1) < BSplineAlgorithms::PAR_CHECK_TOL) {
-            newParametersGuides.back() = 1;
-        }
+    max_cp = Clamp(max_cp + 10, min_cp, std::max(min_cp, maxcp));
+    return ReparametrizeCurves(curves, oldParameters, newParameters, max_cp, cache, curveType);
+}
 
-        Handle(Geom_BSplineCurve)& guide = m_guides[static_cast<size_t>(spline_v_idx)];
+std::vector<ApproxResult> InterpolateCurveNetwork::ReparametrizeSegments(const CurveArray& curves,
+                                                                       const std::vector<std::vector<double>>& oldParameters,
+                                                                       const std::vector<double>& newParameters,
+                                                                       size_t first,
+                                                                       size_t last,
+                                                                       const std::string& curveType) const
+{
+    // the segments between the crossing curves first and last are parametrized in [0, 1]
+    const std::vector<double> segmentParameters = LocalParameters(newParameters, first, last);
+
+    CurveArray segments;
+    std::vector<std::vector<double>> oldSegmentParameters;
+    for (size_t icurve = 0; icurve < curves.size(); ++icurve) {
+        const Handle(Geom_BSplineCurve)& curve = curves[icurve];
+        std::vector<double> parameters(oldParameters[icurve].begin() + static_cast<std::ptrdiff_t>(first),
+                                       oldParameters[icurve].begin() + static_cast<std::ptrdiff_t>(last) + 1);
+        segments.push_back(BSplineAlgorithms::trimCurve(curve,
+                                                        std::max(parameters.front(), curve->FirstParameter()),
+                                                        std::min(parameters.back(), curve->LastParameter())));
+        oldSegmentParameters.push_back(std::move(parameters));
+    }
+
+    ApproxSystemCache systems(32);
+    return ReparametrizeFamily(segments, oldSegmentParameters, segmentParameters, systems, curveType);
+}
+
+std::vector<ApproxResult> InterpolateCurveNetwork::ReparametrizeCurves(const CurveArray& curves,
+                                                                     const std::vector<std::vector<double>>& oldParameters,
+                                                                     const std::vector<double>& newParameters,
+                                                                     size_t nControlPoints,
+                                                                     ApproxSystemCache& cache,
+                                                                     const std::string& curveType) const
+{
+    std::string curveTypeCapitalized = curveType;
+    curveTypeCapitalized[0] = static_cast<char>(std::toupper(curveTypeCapitalized[0]));
+
+    std::vector<ApproxResult> results;
+    results.reserve(curves.size());
+    for (size_t icurve = 0; icurve < curves.size(); ++icurve) {
         try {
-            guide = BSplineAlgorithms::reparametrizeBSplineContinuouslyApprox(guide, oldParameterGuide, newParametersGuides, max_cp_v).curve;
+            if (m_reparametrizationMode == ReparametrizationMode::ExactComposition) {
+                // the joints of the composition are smoothed within the spatial tolerance
+                const double knotRemovalTol = m_spatialTol * BSplineAlgorithms::scale(curves[icurve]);
+                results.push_back(BSplineAlgorithms::reparametrizeBSplineExact(curves[icurve], oldParameters[icurve], newParameters, knotRemovalTol));
+            }
+            else {
+                results.push_back(BSplineAlgorithms::reparametrizeBSplineContinuouslyApprox(curves[icurve], oldParameters[icurve], newParameters, nControlPoints, &cache,
+                                                                                            m_minReparametrizationSamples,
+                                                                                            m_parameterOptimizationIterations));
+            }
         }
         catch (const Standard_Failure& err) {
             std::ostringstream oss;
             const Standard_CString msg = err.GetMessageString();
-            oss << "Guide reparametrization failed at guide index " << spline_v_idx
+            oss << curveTypeCapitalized << " reparametrization failed at " << curveType << " index " << icurve
                 << " (OCCT Standard_Failure): " << (msg ? msg : "<empty>");
             throw error(oss.str());
         }
         catch (const std::exception& err) {
             std::ostringstream oss;
-            oss << "Guide reparametrization failed at guide index " << spline_v_idx
+            oss << curveTypeCapitalized << " reparametrization failed at " << curveType << " index " << icurve
                 << ": " << err.what();
             throw error(oss.str());
         }
         catch (...) {
             std::ostringstream oss;
-            oss << "Guide reparametrization failed at guide index " << spline_v_idx
+            oss << curveTypeCapitalized << " reparametrization failed at " << curveType << " index " << icurve
                 << ": unknown non-standard exception";
             throw error(oss.str());
         }
+
+        // in the adaptive mode, the stage is repeated. The monitor ignores the decreasing progress
+        if (m_monitor) {
+            m_monitor->SetStageProgress(static_cast<double>(icurve + 1) / static_cast<double>(curves.size()));
+        }
     }
+    return results;
+}
 
+std::vector<ApproxResult> InterpolateCurveNetwork::ReparametrizeCurvesAdaptive(const CurveArray& curves,
+                                                                             const std::vector<std::vector<double>>& oldParameters,
+                                                                             const std::vector<double>& newParameters,
+                                                                             size_t minControlPoints,
+                                                                             size_t maxControlPoints,
+                                                                             ApproxSystemCache& cache,
+                                                                             const std::string& curveType) const
+{
+    auto maxError = [](const std::vector<ApproxResult>& results) {
+        double err = 0.;
+        for (const ApproxResult& result : results) {
+            err = std::max(err, result.error);
+        }
+        return err;
+    };
+
+    // All curves of one direction use the same number of control points.
+    // Otherwise, the common knot vector of the skinning surface would
+    // contain the knots of all curves.
+    std::vector<ApproxResult> best = ReparametrizeCurves(curves, oldParameters, newParameters, maxControlPoints, cache, curveType);
+    if (maxError(best) > m_reparametrizationTol) {
+        // the tolerance cannot be reached, use the most accurate result
+        return best;
+    }
 
-    m_intersectionParamsU = newParametersProfiles;
-    m_intersectionParamsV = newParametersGuides;
+    // binary search for the smallest number of control points meeting the tolerance
+    // invariant: best contains the result of maxControlPoints
+    while (minControlPoints < maxControlPoints) {
+        size_t nControlPoints = minControlPoints + (maxControlPoints - minControlPoints) / 2;
+        std::vector<ApproxResult> results = ReparametrizeCurves(curves, oldParameters, newParameters, nControlPoints, cache, curveType);
+        if (maxError(results) <= m_reparametrizationTol) {
+            best = std::move(results);
+            maxControlPoints = nControlPoints;
+        }
+        else {
+            minControlPoints = nControlPoints + 1;
+        }
+    }
+
+    return best;
 }
 
 void InterpolateCurveNetwork::EliminateInaccuraciesNetworkIntersections(const std::vector<Handle(Geom_BSplineCurve)> & sortedProfiles,
@@ -463,36 +858,6 @@ void InterpolateCurveNetwork::EliminateInaccuraciesNetworkIntersections(const st
     }
 }
 
-void occ_gordon_internal::InterpolateCurveNetwork::EnsureC2()
-{
-    assert(m_gordonSurf);
-
-    // By construction, the 3 surfaces could have different degrees
-    // resulting in a higher knot multiplicity. This then results
-    // in OCCT reporting lower continuity.
-    // To fix it, we try to remove those knots using a small tolerance
-    // If successful, this surface should remain unchainged within the
-    // tolerance. We want at least C2.
-    int minUMult = std::max(1, m_gordonSurf->UDegree() - 2);
-    for (int iu = 2; iu <= m_gordonSurf->NbUKnots()-1; ++iu)
-    {
-        if (m_gordonSurf->UMultiplicity(iu) > minUMult)
-        {
-            m_gordonSurf->RemoveUKnot(iu, minUMult, m_spatialTol);
-        }
-    }
-
-    int minVMult = std::max(1, m_gordonSurf->VDegree() - 2);
-    for (int iv = 2; iv <= m_gordonSurf->NbVKnots()-1; ++iv)
-    {
-        if (m_gordonSurf->VMultiplicity(iv) > minVMult)
-        {
-            m_gordonSurf->RemoveVKnot(iv, minVMult, m_spatialTol);
-        }
-    }
-}
-
-
 Handle(Geom_BSplineSurface) InterpolateCurveNetwork::Surface()
 {
     Perform();
@@ -540,23 +905,277 @@ std::vector<double> InterpolateCurveNetwork::ParametersGuides()
     return m_intersectionParamsU;
 }
 
+std::vector<double> InterpolateCurveNetwork::ReparametrizationErrorsProfiles()
+{
+    Perform();
+
+    return m_reparametrizationErrorsProfiles;
+}
+
+std::vector<double> InterpolateCurveNetwork::ReparametrizationErrorsGuides()
+{
+    Perform();
+
+    return m_reparametrizationErrorsGuides;
+}
+
+std::vector<Handle(Geom_BSplineSurface)> InterpolateCurveNetwork::Patches()
+{
+    Perform();
+
+    return m_patches;
+}
+
+size_t InterpolateCurveNetwork::NumberOfPatchesU()
+{
+    Perform();
+
+    return m_nPatchesU;
+}
+
+size_t InterpolateCurveNetwork::NumberOfPatchesV()
+{
+    Perform();
+
+    return m_nPatchesV;
+}
+
+std::vector<int> InterpolateCurveNetwork::SeamContinuityU()
+{
+    Perform();
+
+    return m_seamContinuityU;
+}
+
+std::vector<int> InterpolateCurveNetwork::SeamContinuityV()
+{
+    Perform();
+
+    return m_seamContinuityV;
+}
+
+BSplineAlgorithms::SurfaceKnotRemovalResult InterpolateCurveNetwork::KnotRemovalStatistics()
+{
+    Perform();
+
+    return m_knotRemoval;
+}
+
+std::vector<CurveDeviation> InterpolateCurveNetwork::DeviationsProfiles(size_t nSamples)
+{
+    Perform();
+
+    return ComputeDeviations(m_inputProfiles, m_profileInputIndices, m_oldParametersProfiles,
+                             m_intersectionParamsU, m_intersectionParamsV, true, nSamples);
+}
+
+std::vector<CurveDeviation> InterpolateCurveNetwork::DeviationsGuides(size_t nSamples)
+{
+    Perform();
+
+    return ComputeDeviations(m_inputGuides, m_guideInputIndices, m_oldParametersGuides,
+                             m_intersectionParamsV, m_intersectionParamsU, false, nSamples);
+}
+
+std::vector<CurveDeviation> InterpolateCurveNetwork::ComputeDeviations(const CurveArray& inputCurves,
+                                                                       const std::vector<size_t>& inputIndices,
+                                                                       const std::vector<std::vector<double>>& oldParameters,
+                                                                       const std::vector<double>& newParameters,
+                                                                       const std::vector<double>& isoParameters,
+                                                                       bool isoCurvesInU,
+                                                                       size_t nSamples) const
+{
+    if (nSamples < 2) {
+        throw error("At least two samples per curve are required to compute the deviations", INDEX_ERROR);
+    }
+
+    // the reparametrized curves and hence the surface are parametrized in [0, 1]
+    std::vector<double> samples(nSamples);
+    for (size_t isample = 0; isample < nSamples; ++isample) {
+        samples[isample] = static_cast<double>(isample) / static_cast<double>(nSamples - 1);
+    }
+
+    // all iso-curves of one direction are evaluated at once on a grid
+    const size_t nCurves = inputCurves.size();
+    std::vector<gp_XYZ> surfacePoints(nSamples * nCurves);
+    BSplineSurfaceEvaluator evaluator(m_gordonSurf);
+    if (isoCurvesInU) {
+        evaluator.EvaluateGrid(samples.data(), nSamples, isoParameters.data(), nCurves,
+                               surfacePoints.data(), nullptr, nullptr, m_nThreads);
+    }
+    else {
+        evaluator.EvaluateGrid(isoParameters.data(), nCurves, samples.data(), nSamples,
+                               surfacePoints.data(), nullptr, nullptr, m_nThreads);
+    }
+
+    // with a block decomposition, each curve has been reparametrized per block of crossing curves
+    const std::vector<CurveBlock> blocks = UsesBlockDecomposition()
+        ? CurveBlocks(newParameters.size(), m_blockSize, m_blockOverlap)
+        : std::vector<CurveBlock>();
+
+    std::vector<CurveDeviation> deviations(nCurves);
+    ParallelFor(0, static_cast<int>(nCurves), [&](int i) {
+        const size_t icurve = static_cast<size_t>(i);
+        const Handle(Geom_BSplineCurve)& curve = inputCurves[icurve];
+
+        std::vector<double> parameters = blocks.empty()
+            ? InputParameters(m_reparametrizationMode, newParameters, oldParameters[icurve], samples)
+            : BlockInputParameters(m_reparametrizationMode, newParameters, oldParameters[icurve], blocks, samples);
+        for (double& parameter : parameters) {
+            parameter = std::max(curve->FirstParameter(), std::min(parameter, curve->LastParameter()));
+        }
+        const std::vector<gp_XYZ> curvePoints = BSplineAlgorithms::evaluateCurveSorted(curve, parameters);
+
+        double maxDeviation = 0.;
+        double sumSquares = 0.;
+        for (size_t isample = 0; isample < nSamples; ++isample) {
+            const size_t index = isoCurvesInU ? isample * nCurves + icurve : icurve * nSamples + isample;
+            const double deviation = (curvePoints[isample] - surfacePoints[index]).Modulus();
+            maxDeviation = std::max(maxDeviation, deviation);
+            sumSquares += deviation * deviation;
+        }
+
+        CurveDeviation& result = deviations[icurve];
+        result.inputIndex = inputIndices[icurve];
+        result.parameter = isoParameters[icurve];
+        result.maxDeviation = maxDeviation;
+        result.rmsDeviation = std::sqrt(sumSquares / static_cast<double>(nSamples));
+    }, m_nThreads);
+
+    return deviations;
+}
+
+void InterpolateCurveNetwork::PerformBlocks()
+{
+    // closed networks contain the first curve twice, see ComputeNetworkParameters
+    if (m_profiles.front() == m_profiles.back() || m_guides.front() == m_guides.back()) {
+        throw error("The block decomposition does not support closed curve networks.", MATH_ERROR);
+    }
+
+    const std::vector<CurveBlock> blocksU = CurveBlocks(m_guides.size(), m_blockSize, m_blockOverlap);
+    const std::vector<CurveBlock> blocksV = CurveBlocks(m_profiles.size(), m_blockSize, m_blockOverlap);
+    const size_t nBlocksU = blocksU.size();
+    const size_t nBlocksV = blocksV.size();
+
+    // The profiles are reparametrized separately between the guides of each block column.
+    // All blocks of a column share these segments. Hence, neighboring blocks interpolate
+    // the same curve at their common boundary. The same holds for the guides of each block row.
+    std::vector<std::vector<ApproxResult>> profileSegments(nBlocksU);
+    for (size_t iu = 0; iu < nBlocksU; ++iu) {
+        if (m_monitor) {
+            m_monitor->BeginStage("profile reparametrization", 0.15 / static_cast<double>(nBlocksU));
+        }
+        profileSegments[iu] = ReparametrizeSegments(m_inputProfiles, m_oldParametersProfiles, m_intersectionParamsU,
+                                                    blocksU[iu].extendedFirst, blocksU[iu].extendedLast, "profile");
+    }
+
+    std::vector<std::vector<ApproxResult>> guideSegments(nBlocksV);
+    for (size_t iv = 0; iv < nBlocksV; ++iv) {
+        if (m_monitor) {
+            m_monitor->BeginStage("guide reparametrization", 0.15 / static_cast<double>(nBlocksV));
+        }
+        guideSegments[iv] = ReparametrizeSegments(m_inputGuides, m_oldParametersGuides, m_intersectionParamsV,
+                                                  blocksV[iv].extendedFirst, blocksV[iv].extendedLast, "guide");
+    }
+
+    m_reparametrizationErrorsProfiles.assign(m_profiles.size(), 0.);
+    for (const std::vector<ApproxResult>& segments : profileSegments) {
+        for (size_t iprofile = 0; iprofile < segments.size(); ++iprofile) {
+            m_reparametrizationErrorsProfiles[iprofile] = std::max(m_reparametrizationErrorsProfiles[iprofile], segments[iprofile].error);
+        }
+    }
+
+    m_reparametrizationErrorsGuides.assign(m_guides.size(), 0.);
+    for (const std::vector<ApproxResult>& segments : guideSegments) {
+        for (size_t iguide = 0; iguide < segments.size(); ++iguide) {
+            m_reparametrizationErrorsGuides[iguide] = std::max(m_reparametrizationErrorsGuides[iguide], segments[iguide].error);
+        }
+    }
+
+    // The blocks are independent of each other. The workers only check for cancellation,
+    // which is thread-safe, but don't report any progress.
+    if (m_monitor) {
+        m_monitor->BeginStage("patches", 0.35);
+    }
+    std::vector<Handle(Geom_BSplineSurface)> patches(nBlocksU * nBlocksV);
+    ParallelFor(0, static_cast<int>(patches.size()), [&](int ipatch) {
+        if (m_monitor) {
+            m_monitor->CheckCancelled();
+        }
+        const size_t iu = static_cast<size_t>(ipatch) / nBlocksV;
+        const size_t iv = static_cast<size_t>(ipatch) % nBlocksV;
+        patches[static_cast<size_t>(ipatch)] = InterpolateBlock(profileSegments[iu], guideSegments[iv],
+                                                                m_intersectionParamsU, m_intersectionParamsV,
+                                                                blocksU[iu], blocksV[iv], m_spatialTol);
+    }, m_nThreads);
+
+    // the joins of the patches must not move the surface away from the curves by more than the tolerance
+    const double seamTolerance = m_spatialTol * std::max(BSplineAlgorithms::scale(m_profiles), BSplineAlgorithms::scale(m_guides));
+    m_patches = BSplineAlgorithms::makePatchesCompatible(patches, nBlocksU, nBlocksV, seamTolerance,
+                                                         &m_seamContinuityU, &m_seamContinuityV);
+    m_nPatchesU = nBlocksU;
+    m_nPatchesV = nBlocksV;
+    m_gordonSurf = BSplineAlgorithms::mergePatches(m_patches, nBlocksU, nBlocksV, seamTolerance);
+
+    if (m_monitor) {
+        m_monitor->SetStageProgress(1.);
+    }
+}
+
+bool InterpolateCurveNetwork::UsesBlockDecomposition() const
+{
+    return m_blockSize > 0 && (m_profiles.size() > m_blockSize || m_guides.size() > m_blockSize);
+}
+
 void InterpolateCurveNetwork::Perform()
 {
     if (m_hasPerformed) {
         return;
     }
 
+    ScopedThreadLimit threadLimit(m_nThreads);
+
     // Gordon surfaces are only defined on a compatible curve network
-    // We first have to reparametrize the network
-    MakeCurvesCompatible();
-    
-    GordonSurfaceBuilder builder(m_profiles, m_guides, m_intersectionParamsU, m_intersectionParamsV, m_spatialTol);
-    m_gordonSurf = builder.SurfaceGordon();
-    m_skinningSurfProfiles = builder.SurfaceProfiles();
-    m_skinningSurfGuides = builder.SurfaceGuides();
-    m_tensorProdSurf = builder.SurfaceIntersections();
-
-    EnsureC2();
+    // We first have to compute the parameters of the intersections
+    ComputeNetworkParameters();
+
+    if (UsesBlockDecomposition()) {
+        PerformBlocks();
+    }
+    else {
+        // We have to reparametrize the network
+        ReparametrizeNetwork();
+
+        GordonSurfaceBuilder builder(m_profiles, m_guides, m_intersectionParamsU, m_intersectionParamsV, m_spatialTol);
+        builder.SetTaskMonitor(m_monitor, 0.35);
+        m_gordonSurf = builder.SurfaceGordon();
+        m_skinningSurfProfiles = builder.SurfaceProfiles();
+        m_skinningSurfGuides = builder.SurfaceGuides();
+        m_tensorProdSurf = builder.SurfaceIntersections();
+
+        // The knot multiplicities only have to be reduced, if the
+        // degree of the surfaces had to be elevated by the builder
+        if (builder.DegreeElevated()) {
+            EnsureC2(m_gordonSurf, m_spatialTol);
+        }
+    }
+
+    // optional data reduction of the final surface
+    if (m_monitor) {
+        m_monitor->BeginStage("knot removal", 0.05);
+    }
+    m_knotRemoval = BSplineAlgorithms::removeSurfaceKnots(m_gordonSurf, m_knotRemovalTol, m_monitor);
+    m_gordonSurf = m_knotRemoval.surface;
+
+    if (m_patches.empty()) {
+        m_patches.push_back(m_gordonSurf);
+        m_nPatchesU = 1;
+        m_nPatchesV = 1;
+    }
+
+    if (m_monitor) {
+        m_monitor->Finish();
+    }
 
     m_hasPerformed = true;
 }
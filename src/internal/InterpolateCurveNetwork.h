@@ -11,6 +11,9 @@
 
 
 
+#include "BSplineAlgorithms.h"
+
+#include <string>
 #include <vector>
 #include <Geom_BSplineCurve.hxx>
 #include <Geom_BSplineSurface.hxx>
@@ -20,6 +23,21 @@ class math_Matrix;
 namespace occ_gordon_internal
 {
 
+class TaskMonitor;
+
+/// Deviation of an input curve from the corresponding iso-curve of the gordon surface
+struct CurveDeviation
+{
+    /// Index of the curve in the input vector
+    size_t inputIndex;
+
+    /// Parameter of the iso-curve, i.e. v for profiles and u for guides
+    double parameter;
+
+    double maxDeviation;
+    double rmsDeviation;
+};
+
 /**
  * @brief Curve network interpolation with gordon surfaces
  * 
@@ -29,6 +47,10 @@ namespace occ_gordon_internal
  *  - Sort the profiles and guides
  *  - Reparametrize profiles and curves to make the network compatible (in most cases necessary)
  *  - Compute the gordon surface
+ *
+ * The algorithm works on copies of the input curves, the curves of the caller are never modified.
+ * An instance must only be used by one thread, but independent instances can run concurrently,
+ * even if they share their input curves.
  */
 class InterpolateCurveNetwork
 {
@@ -53,11 +75,122 @@ public:
                                              const std::vector<Handle(Geom_Curve)>& guides,
                                              double spatialTolerance);
 
+    /**
+     * @brief Selects, how the curves are reparametrized to make the network compatible
+     *
+     * The default is ReparametrizationMode::Approximation. This must be called
+     * before the surface is computed.
+     *
+     * @throws error, if ExactComposition is combined with a block decomposition
+     */
+    void SetReparametrizationMode(ReparametrizationMode mode);
+
+    /**
+     * @brief Enables the adaptive choice of the number of control points of the reparametrized curves
+     *
+     * If the tolerance is positive, the smallest number of control points is searched,
+     * such that all profiles (and likewise all guides) are approximated within this tolerance.
+     * The search is bounded by the limits of SetControlPointLimits. If the tolerance cannot
+     * be reached, the maximum number of control points is used.
+     * Otherwise, the number of control points is derived from the input curves (default).
+     */
+    void SetReparametrizationTolerance(double tolerance);
+
+    /**
+     * @brief Enables the data reduction of the final surface by knot removal
+     *
+     * If the tolerance is positive, knots are removed from the gordon surface in both directions,
+     * as long as the surface deviates less than the tolerance from the unreduced surface.
+     * This reduces the number of poles considerably for larger curve networks.
+     * The default tolerance is zero, i.e. no knots are removed.
+     */
+    void SetKnotRemovalTolerance(double tolerance);
+
+    /**
+     * @brief Sets the range of the number of control points of the reparametrized curves
+     *
+     * The defaults are 10 and 80. The number of control points is at least the number of
+     * crossing curves plus two.
+     */
+    void SetControlPointLimits(size_t minControlPoints, size_t maxControlPoints);
+
+    /// Sets the minimum number of points sampled from each curve for the reparametrization (default: 101)
+    void SetMinReparametrizationSamples(size_t nSamples);
+
+    /// Sets the number of iterations of the parameter optimization in the reparametrization (default: 1)
+    void SetParameterOptimizationIterations(int nIterations);
+
+    /// Sets the settings of the curve intersection algorithm
+    void SetIntersectionOptions(const IntersectBSplinesOptions& options);
+
+    /**
+     * @brief Limits the number of threads used to compute the surface
+     *
+     * A value <= 0 uses all available threads (default).
+     */
+    void SetNumberOfThreads(int nThreads);
+
+    /**
+     * @brief Sets a monitor, which receives the progress of the computation and can cancel it
+     *
+     * The progress is reported per intersection pair, reparametrized curve and skinning column.
+     * The monitor is not owned and must live until the surface is computed.
+     */
+    void SetTaskMonitor(TaskMonitor* monitor);
+
+    /**
+     * @brief Splits large curve networks into overlapping blocks, which are interpolated independently
+     *
+     * The profiles and guides are divided into blocks of at most blockSize curves per direction,
+     * where neighboring blocks share their boundary curves. Each block is extended by overlap
+     * curves on each side, interpolated by its own gordon surface in parallel and trimmed back
+     * to a patch. The patches are joined with C1 continuity and merged into a single surface.
+     * Seams, where the C1 join would move the patches further than the spatial tolerance, scaled
+     * by the network size, are only joined with C0 continuity.
+     * This reduces the effort of the reparametrization and of the gordon surfaces, which grows
+     * much faster than linearly with the network size otherwise. The intersections and the
+     * sorting of the curves are still computed for the whole network, their effort grows
+     * with the number of profiles times the number of guides.
+     * A cancellation is checked before each block is interpolated.
+     *
+     * A block size of 0 disables the decomposition (default). Closed networks and
+     * ReparametrizationMode::ExactComposition are not supported.
+     * With a decomposition, SurfaceProfiles, SurfaceGuides and SurfaceIntersections return null handles.
+     *
+     * @throws error, if the block size is 1, the overlap is 0 or the exact reparametrization is enabled
+     */
+    void SetBlockDecomposition(size_t blockSize, size_t overlap = 2);
+
     operator Handle(Geom_BSplineSurface) ();
     
     /// Returns the interpolation surface
     Handle(Geom_BSplineSurface) Surface();
 
+    /**
+     * @brief Returns the patches of the block decomposition before they are merged
+     *
+     * Patch (i, j) is stored at index i * NumberOfPatchesV() + j. Without a block decomposition,
+     * the interpolation surface is the only patch.
+     */
+    std::vector<Handle(Geom_BSplineSurface)> Patches();
+
+    /// Returns the number of patches in u direction
+    size_t NumberOfPatchesU();
+
+    /// Returns the number of patches in v direction
+    size_t NumberOfPatchesV();
+
+    /**
+     * @brief Returns the continuity (0 or 1) of the seams between the patch columns
+     *
+     * Seam i joins the patches (i, j) and (i + 1, j). A seam is only joined with C0 continuity,
+     * if the C1 join would move the surface further than the tolerance.
+     */
+    std::vector<int> SeamContinuityU();
+
+    /// Returns the continuity (0 or 1) of the seams between the patch rows, see SeamContinuityU
+    std::vector<int> SeamContinuityV();
+
     /// Returns the surface that interpolates the profiles
     Handle(Geom_BSplineSurface) SurfaceProfiles();
     
@@ -73,6 +206,29 @@ public:
     /// Returns the u parameters of the final surface, that correspond to the guide curve locations
     std::vector<double> ParametersGuides();
 
+    /// Returns the approximation error of each profile caused by the reparametrization
+    std::vector<double> ReparametrizationErrorsProfiles();
+
+    /// Returns the approximation error of each guide caused by the reparametrization
+    std::vector<double> ReparametrizationErrorsGuides();
+
+    /// Returns the number of poles before and after the knot removal and the introduced deviation
+    BSplineAlgorithms::SurfaceKnotRemovalResult KnotRemovalStatistics();
+
+    /**
+     * @brief Returns the deviation of each profile from its iso-curve v = const of the surface
+     *
+     * The reparametrization maps each profile parameter onto a known u parameter of the surface.
+     * Hence, no point projection is required: the input profile and the surface are
+     * evaluated at nSamples corresponding parameters. The profiles are returned in the
+     * order of ParametersProfiles(). For closed networks, the first profile is repeated at the end.
+     * With a block decomposition, each sample is mapped by the reparametrization of its block.
+     */
+    std::vector<CurveDeviation> DeviationsProfiles(size_t nSamples = 101);
+
+    /// Returns the deviation of each guide from its iso-curve u = const of the surface, see DeviationsProfiles
+    std::vector<CurveDeviation> DeviationsGuides(size_t nSamples = 101);
+
 private:
     void Perform();
 
@@ -83,23 +239,92 @@ private:
     // Sorts the profiles and guides
     void SortCurves(math_Matrix& intersection_params_u, math_Matrix& intersection_params_v);
 
-    void MakeCurvesCompatible();
+    // Computes the parameters of the intersections before and after the reparametrization
+    void ComputeNetworkParameters();
+
+    // Reparametrizes the whole network to make the curves compatible
+    void ReparametrizeNetwork();
+
+    // Whether the network is large enough to be split into blocks
+    bool UsesBlockDecomposition() const;
+
+    // Interpolates the blocks of the network and merges the patches
+    void PerformBlocks();
+
+    typedef std::vector<Handle(Geom_BSplineCurve)> CurveArray;
+
+    // Chooses the number of control points and reparametrizes all curves of one direction
+    std::vector<ApproxResult> ReparametrizeFamily(const CurveArray& curves,
+                                                  const std::vector<std::vector<double>>& oldParameters,
+                                                  const std::vector<double>& newParameters,
+                                                  ApproxSystemCache& cache,
+                                                  const std::string& curveType) const;
+
+    // Reparametrizes the segments of the curves between the crossing curves first and last
+    std::vector<ApproxResult> ReparametrizeSegments(const CurveArray& curves,
+                                                    const std::vector<std::vector<double>>& oldParameters,
+                                                    const std::vector<double>& newParameters,
+                                                    size_t first,
+                                                    size_t last,
+                                                    const std::string& curveType) const;
+
+    std::vector<ApproxResult> ReparametrizeCurves(const CurveArray& curves,
+                                                  const std::vector<std::vector<double>>& oldParameters,
+                                                  const std::vector<double>& newParameters,
+                                                  size_t nControlPoints,
+                                                  ApproxSystemCache& cache,
+                                                  const std::string& curveType) const;
+
+    std::vector<ApproxResult> ReparametrizeCurvesAdaptive(const CurveArray& curves,
+                                                          const std::vector<std::vector<double>>& oldParameters,
+                                                          const std::vector<double>& newParameters,
+                                                          size_t minControlPoints,
+                                                          size_t maxControlPoints,
+                                                          ApproxSystemCache& cache,
+                                                          const std::string& curveType) const;
 
     void EliminateInaccuraciesNetworkIntersections(const std::vector<Handle(Geom_BSplineCurve)> & sorted_splines_u,
                                                    const std::vector<Handle(Geom_BSplineCurve)> & sorted_splines_v,
                                                    math_Matrix & intersection_params_u,
                                                    math_Matrix & intersection_params_v) const;
 
-    void EnsureC2();
+    // Compares the input curves with the iso-curves of the final surface
+    std::vector<CurveDeviation> ComputeDeviations(const CurveArray& inputCurves,
+                                                  const std::vector<size_t>& inputIndices,
+                                                  const std::vector<std::vector<double>>& oldParameters,
+                                                  const std::vector<double>& newParameters,
+                                                  const std::vector<double>& isoParameters,
+                                                  bool isoCurvesInU,
+                                                  size_t nSamples) const;
 
     bool m_hasPerformed;
     double m_spatialTol;
+    ReparametrizationMode m_reparametrizationMode;
+    double m_reparametrizationTol;
+    double m_knotRemovalTol;
+    size_t m_minControlPoints, m_maxControlPoints;
+    size_t m_minReparametrizationSamples;
+    int m_parameterOptimizationIterations;
+    IntersectBSplinesOptions m_intersectionOptions;
+    int m_nThreads;
+    TaskMonitor* m_monitor;
+    size_t m_blockSize, m_blockOverlap;
     
-    typedef std::vector<Handle(Geom_BSplineCurve)> CurveArray;
     CurveArray m_profiles;
     CurveArray m_guides;
+
+    // sorted input curves before the reparametrization together with their input indices
+    // and the parameters of the intersections before and after the reparametrization
+    CurveArray m_inputProfiles, m_inputGuides;
+    std::vector<size_t> m_profileInputIndices, m_guideInputIndices;
+    std::vector<std::vector<double>> m_oldParametersProfiles, m_oldParametersGuides;
     std::vector<double> m_intersectionParamsU, m_intersectionParamsV;
+    std::vector<double> m_reparametrizationErrorsProfiles, m_reparametrizationErrorsGuides;
+    BSplineAlgorithms::SurfaceKnotRemovalResult m_knotRemoval;
     Handle(Geom_BSplineSurface) m_skinningSurfProfiles, m_skinningSurfGuides, m_tensorProdSurf, m_gordonSurf;
+    std::vector<Handle(Geom_BSplineSurface)> m_patches;
+    size_t m_nPatchesU, m_nPatchesV;
+    std::vector<int> m_seamContinuityU, m_seamContinuityV;
 };
 
 /// Convenience function calling InterpolateCurveNetwork
@@ -161,7 +161,7 @@ namespace
 
     
     /// Computes possible ranges of intersections by a bracketing approach
-    std::list<BoundingBoxPair> getRangesOfIntersection(const Handle(Geom_BSplineCurve) curve1, const Handle(Geom_BSplineCurve) curve2, double tolerance)
+    std::list<BoundingBoxPair> getRangesOfIntersection(const Handle(Geom_BSplineCurve) curve1, const Handle(Geom_BSplineCurve) curve2, double tolerance, double max_curvature)
     {
         BoundingBox h1(curve1);
         BoundingBox h2(curve2);
@@ -173,8 +173,6 @@ namespace
         
         double c1_curvature = curvature(curve1);
         double c2_curvature = curvature(curve2);
-        double max_curvature = 1.0005;
-        
         // If both curves are linear enough, we can stop refining
         if (c1_curvature <= max_curvature && c2_curvature <= max_curvature) {
             return {BoundingBoxPair(h1, h2)};
@@ -191,10 +189,10 @@ namespace
             Handle(Geom_BSplineCurve) c21 = occ_gordon_internal::BSplineAlgorithms::trimCurve(curve2, curve2->FirstParameter(), curve2MidParm);
             Handle(Geom_BSplineCurve) c22 = occ_gordon_internal::BSplineAlgorithms::trimCurve(curve2, curve2MidParm, curve2->LastParameter());
             
-            auto result1 = getRangesOfIntersection(c11, c21, tolerance);
-            auto result2 = getRangesOfIntersection(c11, c22, tolerance);
-            auto result3 = getRangesOfIntersection(c12, c21, tolerance);
-            auto result4 = getRangesOfIntersection(c12, c22, tolerance);
+            auto result1 = getRangesOfIntersection(c11, c21, tolerance, max_curvature);
+            auto result2 = getRangesOfIntersection(c11, c22, tolerance, max_curvature);
+            auto result3 = getRangesOfIntersection(c12, c21, tolerance, max_curvature);
+            auto result4 = getRangesOfIntersection(c12, c22, tolerance, max_curvature);
             
             // append all results
             result1.splice(std::begin(result1), result2);
@@ -208,8 +206,8 @@ namespace
             Handle(Geom_BSplineCurve) c21 = occ_gordon_internal::BSplineAlgorithms::trimCurve(curve2, curve2->FirstParameter(), curve2MidParm);
             Handle(Geom_BSplineCurve) c22 = occ_gordon_internal::BSplineAlgorithms::trimCurve(curve2, curve2MidParm, curve2->LastParameter());
             
-            auto result1 = getRangesOfIntersection(curve1, c21, tolerance);
-            auto result2 = getRangesOfIntersection(curve1, c22, tolerance);
+            auto result1 = getRangesOfIntersection(curve1, c21, tolerance, max_curvature);
+            auto result2 = getRangesOfIntersection(curve1, c22, tolerance, max_curvature);
             
             result1.splice(std::begin(result1), result2);
             return result1;
@@ -219,8 +217,8 @@ namespace
             Handle(Geom_BSplineCurve) c11 = occ_gordon_internal::BSplineAlgorithms::trimCurve(curve1, curve1->FirstParameter(), curve1MidParm);
             Handle(Geom_BSplineCurve) c12 = occ_gordon_internal::BSplineAlgorithms::trimCurve(curve1, curve1MidParm, curve1->LastParameter());
             
-            auto result1 = getRangesOfIntersection(c11, curve2, tolerance);
-            auto result2 = getRangesOfIntersection(c12, curve2, tolerance);
+            auto result1 = getRangesOfIntersection(c11, curve2, tolerance, max_curvature);
+            auto result2 = getRangesOfIntersection(c12, curve2, tolerance, max_curvature);
             
             result1.splice(std::begin(result1), result2);
             return result1;
@@ -371,10 +369,11 @@ namespace occ_gordon_internal
 {
 
 
-std::vector<CurveIntersectionResult> IntersectBSplines(const Handle(Geom_BSplineCurve) curve1, const Handle(Geom_BSplineCurve) curve2, double tolerance)
+std::vector<CurveIntersectionResult> IntersectBSplines(const Handle(Geom_BSplineCurve) curve1, const Handle(Geom_BSplineCurve) curve2, double tolerance,
+                                                       const IntersectBSplinesOptions& options)
 {
     const double optimizerScale = (BSplineAlgorithms::scale(curve1) + BSplineAlgorithms::scale(curve2)) / 2.;
-    auto hulls = getRangesOfIntersection(curve1, curve2, tolerance);
+    auto hulls = getRangesOfIntersection(curve1, curve2, tolerance, options.maxFlatness);
     
     std::list<BoundingBox> curve1_ints, curve2_ints;
     for (const auto& hull : hulls) {
@@ -436,7 +435,7 @@ std::vector<CurveIntersectionResult> IntersectBSplines(const Handle(Geom_BSpline
         // Only comment in for debugging purposes
         //CheckGradient(obj, guess, 1e-6);
 
-        math_FRPR optimizer(obj, 1e-10, 200);
+        math_FRPR optimizer(obj, options.optimizerTolerance, options.optimizerMaxIterations);
         optimizer.Perform(obj, guess);
 
         if (!optimizer.IsDone()) {
@@ -23,6 +23,19 @@ struct CurveIntersectionResult
     gp_Pnt point;
 };
 
+/// Settings of the curve intersection algorithm
+struct IntersectBSplinesOptions
+{
+    /// Curve segments are subdivided, until the ratio of their control polygon length and chord is below this value
+    double maxFlatness = 1.0005;
+
+    /// Tolerance of the local distance minimization
+    double optimizerTolerance = 1e-10;
+
+    /// Maximum number of iterations of the local distance minimization
+    int optimizerMaxIterations = 200;
+};
+
 /**
  * @brief Computes all intersections of 2 B-Splines curves
  *
@@ -35,7 +48,8 @@ struct CurveIntersectionResult
  */
 std::vector<CurveIntersectionResult> IntersectBSplines(const Handle(Geom_BSplineCurve) curve1,
                                                        const Handle(Geom_BSplineCurve) curve2,
-                                                       double absTolerance=1e-5);
+                                                       double absTolerance=1e-5,
+                                                       const IntersectBSplinesOptions& options = IntersectBSplinesOptions());
 
 } // namespace occ_gordon_internal
 
@@ -0,0 +1,215 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+#include "LinearAlgebra.h"
+
+#include "internal/Error.h"
+
+#ifdef OCC_GORDON_USE_EIGEN
+#include <Eigen/Dense>
+#else
+#include <math_Gauss.hxx>
+#endif
+
+#include <cmath>
+
+namespace
+{
+
+void checkSolveDimensions(int nRows, int rhsLength, int xLength)
+{
+    if (rhsLength != nRows || xLength != nRows) {
+        throw occ_gordon_internal::error("Dimension mismatch in DenseLUSolver::Solve", occ_gordon_internal::MATH_ERROR);
+    }
+}
+
+#ifdef OCC_GORDON_USE_EIGEN
+
+Eigen::MatrixXd toEigen(const math_Matrix& m)
+{
+    Eigen::MatrixXd result(m.RowNumber(), m.ColNumber());
+    for (int i = 0; i < m.RowNumber(); ++i) {
+        for (int j = 0; j < m.ColNumber(); ++j) {
+            result(i, j) = m(m.LowerRow() + i, m.LowerCol() + j);
+        }
+    }
+    return result;
+}
+
+#endif
+
+} // namespace
+
+namespace occ_gordon_internal
+{
+
+#ifdef OCC_GORDON_USE_EIGEN
+
+const char* LinearAlgebraBackendName()
+{
+    return "Eigen";
+}
+
+struct DenseLUSolver::Impl
+{
+    Impl(const math_Matrix& lhs, double minPivot)
+        : lu(toEigen(lhs))
+        , done(true)
+    {
+        const Eigen::MatrixXd& factors = lu.matrixLU();
+        for (Eigen::Index i = 0; i < factors.rows(); ++i) {
+            if (std::abs(factors(i, i)) <= minPivot) {
+                done = false;
+                break;
+            }
+        }
+    }
+
+    Eigen::PartialPivLU<Eigen::MatrixXd> lu;
+    bool done;
+};
+
+DenseLUSolver::DenseLUSolver(const math_Matrix& lhs, double minPivot)
+    : m_impl(new Impl(lhs, minPivot))
+{
+}
+
+void DenseLUSolver::Solve(const math_Vector& rhs, math_Vector& x) const
+{
+    int n = static_cast<int>(m_impl->lu.rows());
+    checkSolveDimensions(n, rhs.Length(), x.Length());
+
+    Eigen::VectorXd b(n);
+    for (int i = 0; i < n; ++i) {
+        b(i) = rhs(rhs.Lower() + i);
+    }
+    Eigen::VectorXd sol = m_impl->lu.solve(b);
+    for (int i = 0; i < n; ++i) {
+        x(x.Lower() + i) = sol(i);
+    }
+}
+
+void DenseLUSolver::Solve(const math_Matrix& rhs, math_Matrix& x) const
+{
+    int n = static_cast<int>(m_impl->lu.rows());
+    checkSolveDimensions(n, rhs.RowNumber(), x.RowNumber());
+    if (rhs.ColNumber() != x.ColNumber()) {
+        throw error("Dimension mismatch in DenseLUSolver::Solve", MATH_ERROR);
+    }
+
+    Eigen::MatrixXd sol = m_impl->lu.solve(toEigen(rhs));
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < rhs.ColNumber(); ++j) {
+            x(x.LowerRow() + i, x.LowerCol() + j) = sol(i, j);
+        }
+    }
+}
+
+math_Matrix TransposeMultiply(const math_Matrix& a, const math_Matrix& b)
+{
+    if (a.RowNumber() != b.RowNumber()) {
+        throw error("Dimension mismatch in TransposeMultiply", MATH_ERROR);
+    }
+
+    Eigen::MatrixXd prod = toEigen(a).transpose() * toEigen(b);
+
+    math_Matrix result(1, a.ColNumber(), 1, b.ColNumber());
+    for (int i = 0; i < a.ColNumber(); ++i) {
+        for (int j = 0; j < b.ColNumber(); ++j) {
+            result(i + 1, j + 1) = prod(i, j);
+        }
+    }
+    return result;
+}
+
+#else // OCCT backend
+
+const char* LinearAlgebraBackendName()
+{
+    return "OCCT";
+}
+
+struct DenseLUSolver::Impl
+{
+    Impl(const math_Matrix& lhs, double minPivot)
+        : gauss(lhs, minPivot)
+        , n(lhs.RowNumber())
+    {
+    }
+
+    math_Gauss gauss;
+    int n;
+};
+
+DenseLUSolver::DenseLUSolver(const math_Matrix& lhs, double minPivot)
+    : m_impl(new Impl(lhs, minPivot))
+{
+}
+
+void DenseLUSolver::Solve(const math_Vector& rhs, math_Vector& x) const
+{
+    checkSolveDimensions(m_impl->n, rhs.Length(), x.Length());
+    m_impl->gauss.Solve(rhs, x);
+}
+
+void DenseLUSolver::Solve(const math_Matrix& rhs, math_Matrix& x) const
+{
+    checkSolveDimensions(m_impl->n, rhs.RowNumber(), x.RowNumber());
+    if (rhs.ColNumber() != x.ColNumber()) {
+        throw error("Dimension mismatch in DenseLUSolver::Solve", MATH_ERROR);
+    }
+
+    math_Vector b(1, m_impl->n);
+    math_Vector sol(1, m_impl->n);
+    for (int j = 0; j < rhs.ColNumber(); ++j) {
+        for (int i = 1; i <= m_impl->n; ++i) {
+            b(i) = rhs(rhs.LowerRow() + i - 1, rhs.LowerCol() + j);
+        }
+        m_impl->gauss.Solve(b, sol);
+        for (int i = 1; i <= m_impl->n; ++i) {
+            x(x.LowerRow() + i - 1, x.LowerCol() + j) = sol(i);
+        }
+    }
+}
+
+math_Matrix TransposeMultiply(const math_Matrix& a, const math_Matrix& b)
+{
+    if (a.RowNumber() != b.RowNumber()) {
+        throw error("Dimension mismatch in TransposeMultiply", MATH_ERROR);
+    }
+
+    math_Matrix result(1, a.ColNumber(), 1, b.ColNumber(), 0.);
+
+    // basis matrices are banded, hence we skip zero entries
+    for (int k = 0; k < a.RowNumber(); ++k) {
+        int ka = a.LowerRow() + k;
+        int kb = b.LowerRow() + k;
+        for (int i = 0; i < a.ColNumber(); ++i) {
+            double aki = a(ka, a.LowerCol() + i);
+            if (aki == 0.) {
+                continue;
+            }
+            for (int j = 0; j < b.ColNumber(); ++j) {
+                result(i + 1, j + 1) += aki * b(kb, b.LowerCol() + j);
+            }
+        }
+    }
+    return result;
+}
+
+#endif
+
+DenseLUSolver::~DenseLUSolver() = default;
+
+bool DenseLUSolver::IsDone() const
+{
+#ifdef OCC_GORDON_USE_EIGEN
+    return m_impl->done;
+#else
+    return m_impl->gauss.IsDone();
+#endif
+}
+
+} // namespace occ_gordon_internal
@@ -0,0 +1,60 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+#ifndef LINEARALGEBRA_H
+#define LINEARALGEBRA_H
+
+#include <math_Matrix.hxx>
+#include <math_Vector.hxx>
+
+#include <memory>
+
+namespace occ_gordon_internal
+{
+
+/**
+ * @brief Returns the name of the dense linear algebra backend
+ *
+ * The backend is selected at configure time with the CMake
+ * option OCC_GORDON_USE_EIGEN. Returns either "OCCT" or "Eigen".
+ */
+const char* LinearAlgebraBackendName();
+
+/**
+ * @brief LU factorization of a dense square matrix
+ *
+ * The matrix is factorized once in the constructor. Afterwards,
+ * an arbitrary number of right hand sides can be solved. The
+ * solve methods are const and may be called concurrently.
+ */
+class DenseLUSolver
+{
+public:
+    explicit DenseLUSolver(const math_Matrix& lhs, double minPivot = 1e-20);
+    ~DenseLUSolver();
+
+    DenseLUSolver(const DenseLUSolver&) = delete;
+    DenseLUSolver& operator=(const DenseLUSolver&) = delete;
+
+    /// Returns false, if the matrix is singular
+    bool IsDone() const;
+
+    /// Solves lhs * x = rhs
+    void Solve(const math_Vector& rhs, math_Vector& x) const;
+
+    /// Solves lhs * X = RHS for all columns of rhs at once
+    void Solve(const math_Matrix& rhs, math_Matrix& x) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/// Computes a^T * b without forming the transposed matrix
+math_Matrix TransposeMultiply(const math_Matrix& a, const math_Matrix& b);
+
+} // namespace occ_gordon_internal
+
+#endif // LINEARALGEBRA_H
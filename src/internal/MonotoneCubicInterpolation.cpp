@@ -0,0 +1,196 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+#include "MonotoneCubicInterpolation.h"
+
+#include "Error.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace occ_gordon_internal
+{
+
+namespace
+{
+
+// One sided three point estimate of the end slope, modified to preserve monotonicity
+double endSlope(double h0, double h1, double d0, double d1)
+{
+    double slope = ((2. * h0 + h1) * d0 - h0 * d1) / (h0 + h1);
+    if (slope * d0 <= 0.) {
+        return 0.;
+    }
+    if (d0 * d1 <= 0. && std::abs(slope) > std::abs(3. * d0)) {
+        return 3. * d0;
+    }
+    return slope;
+}
+
+} // namespace
+
+MonotoneCubicInterpolation::MonotoneCubicInterpolation(const std::vector<double>& x, const std::vector<double>& y)
+    : m_x(x)
+    , m_y(y)
+    , m_strictlyAscending(true)
+{
+    if (x.size() != y.size()) {
+        throw error("Number of nodes and values don't match in MonotoneCubicInterpolation");
+    }
+
+    if (x.size() < 2) {
+        throw error("At least two nodes are required for MonotoneCubicInterpolation", MATH_ERROR);
+    }
+
+    const size_t n = x.size();
+    std::vector<double> h(n - 1), d(n - 1);
+    for (size_t k = 0; k + 1 < n; ++k) {
+        h[k] = x[k + 1] - x[k];
+        if (h[k] <= 0.) {
+            throw error("Nodes of MonotoneCubicInterpolation must be strictly ascending", MATH_ERROR);
+        }
+        if (y[k + 1] < y[k]) {
+            throw error("Values of MonotoneCubicInterpolation must be ascending", MATH_ERROR);
+        }
+        m_strictlyAscending = m_strictlyAscending && y[k + 1] > y[k];
+        d[k] = (y[k + 1] - y[k]) / h[k];
+    }
+
+    m_slopes.resize(n);
+    if (n == 2) {
+        m_slopes[0] = m_slopes[1] = d[0];
+        return;
+    }
+
+    // weighted harmonic mean of the neighboring secants (Fritsch-Butland)
+    for (size_t k = 1; k + 1 < n; ++k) {
+        if (d[k - 1] * d[k] <= 0.) {
+            m_slopes[k] = 0.;
+        }
+        else {
+            double w1 = 2. * h[k] + h[k - 1];
+            double w2 = h[k] + 2. * h[k - 1];
+            m_slopes[k] = (w1 + w2) / (w1 / d[k - 1] + w2 / d[k]);
+        }
+    }
+
+    m_slopes[0] = endSlope(h[0], h[1], d[0], d[1]);
+    m_slopes[n - 1] = endSlope(h[n - 2], h[n - 3], d[n - 2], d[n - 3]);
+}
+
+size_t MonotoneCubicInterpolation::segment(const std::vector<double>& nodes, double x) const
+{
+    size_t k = static_cast<size_t>(std::upper_bound(nodes.begin(), nodes.end(), x) - nodes.begin());
+    return std::min(std::max(k, static_cast<size_t>(1)), nodes.size() - 1) - 1;
+}
+
+double MonotoneCubicInterpolation::segmentValue(size_t k, double t) const
+{
+    const double h = m_x[k + 1] - m_x[k];
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+
+    // cubic Hermite basis
+    const double h00 = 2. * t3 - 3. * t2 + 1.;
+    const double h10 = t3 - 2. * t2 + t;
+    const double h01 = -2. * t3 + 3. * t2;
+    const double h11 = t3 - t2;
+
+    return h00 * m_y[k] + h10 * h * m_slopes[k] + h01 * m_y[k + 1] + h11 * h * m_slopes[k + 1];
+}
+
+double MonotoneCubicInterpolation::segmentDerivative(size_t k, double t) const
+{
+    const double h = m_x[k + 1] - m_x[k];
+    const double t2 = t * t;
+
+    const double dh00 = 6. * t2 - 6. * t;
+    const double dh10 = 3. * t2 - 4. * t + 1.;
+    const double dh01 = -6. * t2 + 6. * t;
+    const double dh11 = 3. * t2 - 2. * t;
+
+    return (dh00 * m_y[k] + dh01 * m_y[k + 1]) / h + dh10 * m_slopes[k] + dh11 * m_slopes[k + 1];
+}
+
+double MonotoneCubicInterpolation::Value(double x) const
+{
+    if (x < m_x.front()) {
+        return m_y.front() + (x - m_x.front()) * m_slopes.front();
+    }
+    if (x > m_x.back()) {
+        return m_y.back() + (x - m_x.back()) * m_slopes.back();
+    }
+
+    size_t k = segment(m_x, x);
+    return segmentValue(k, (x - m_x[k]) / (m_x[k + 1] - m_x[k]));
+}
+
+double MonotoneCubicInterpolation::Derivative(double x) const
+{
+    if (x < m_x.front()) {
+        return m_slopes.front();
+    }
+    if (x > m_x.back()) {
+        return m_slopes.back();
+    }
+
+    size_t k = segment(m_x, x);
+    return segmentDerivative(k, (x - m_x[k]) / (m_x[k + 1] - m_x[k]));
+}
+
+double MonotoneCubicInterpolation::Inverse(double y) const
+{
+    if (!m_strictlyAscending) {
+        throw error("MonotoneCubicInterpolation can only be inverted for strictly ascending values", MATH_ERROR);
+    }
+
+    if (y < m_y.front() || y > m_y.back()) {
+        // the linear extrapolation is inverted directly
+        bool before = y < m_y.front();
+        double slope = before ? m_slopes.front() : m_slopes.back();
+        if (slope <= 0.) {
+            throw error("MonotoneCubicInterpolation cannot be inverted outside of its range", MATH_ERROR);
+        }
+        return before ? m_x.front() + (y - m_y.front()) / slope
+                      : m_x.back() + (y - m_y.back()) / slope;
+    }
+
+    const size_t k = segment(m_y, y);
+    const double h = m_x[k + 1] - m_x[k];
+
+    // The cubic is monotone on [0, 1]. Newton's method is safeguarded
+    // by bisection, which guarantees convergence inside the bracket.
+    double lo = 0., hi = 1.;
+    double t = (y - m_y[k]) / (m_y[k + 1] - m_y[k]);
+    for (int iter = 0; iter < 100; ++iter) {
+        const double f = segmentValue(k, t) - y;
+        if (std::abs(f) <= 1e-15 * std::max(1., std::abs(y))) {
+            break;
+        }
+
+        if (f < 0.) {
+            lo = t;
+        }
+        else {
+            hi = t;
+        }
+
+        const double df = segmentDerivative(k, t) * h;
+        double tNew = df > 0. ? t - f / df : -1.;
+        if (tNew <= lo || tNew >= hi) {
+            tNew = 0.5 * (lo + hi);
+        }
+
+        if (std::abs(tNew - t) < 1e-16) {
+            t = tNew;
+            break;
+        }
+        t = tNew;
+    }
+
+    return m_x[k] + t * h;
+}
+
+} // namespace occ_gordon_internal
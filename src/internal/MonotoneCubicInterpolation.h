@@ -0,0 +1,59 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+#ifndef MONOTONECUBICINTERPOLATION_H
+#define MONOTONECUBICINTERPOLATION_H
+
+#include <cstddef>
+#include <vector>
+
+namespace occ_gordon_internal
+{
+
+/**
+ * @brief Monotone piecewise cubic Hermite interpolation of a scalar function
+ *
+ * The inner slopes are the weighted harmonic means of the neighboring secants
+ * (Fritsch-Butland, as in PCHIP), such that the interpolant is monotone and free
+ * of overshoots, if the data are monotone. The interpolant is only C1 continuous.
+ * In contrast to a 2D B-spline curve, evaluation and inversion are done in closed
+ * form on a single cubic segment and don't need any allocation.
+ *
+ * Outside of the nodes, the function is extrapolated linearly.
+ */
+class MonotoneCubicInterpolation
+{
+public:
+    /**
+     * @param x Strictly ascending nodes, at least two
+     * @param y Ascending function values at the nodes
+     */
+    MonotoneCubicInterpolation(const std::vector<double>& x, const std::vector<double>& y);
+
+    double Value(double x) const;
+
+    double Derivative(double x) const;
+
+    /**
+     * @brief Returns x with Value(x) == y
+     *
+     * Requires strictly ascending function values.
+     */
+    double Inverse(double y) const;
+
+private:
+    // Index k of the segment [x_k, x_k+1] containing x
+    size_t segment(const std::vector<double>& nodes, double x) const;
+
+    double segmentValue(size_t k, double t) const;
+    double segmentDerivative(size_t k, double t) const;
+
+    std::vector<double> m_x, m_y, m_slopes;
+    bool m_strictlyAscending;
+};
+
+} // namespace occ_gordon_internal
+
+#endif // MONOTONECUBICINTERPOLATION_H
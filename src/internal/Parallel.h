@@ -0,0 +1,139 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "occ_gordon_internal.h"
+
+#include <Standard_Version.hxx>
+#include <OSD_Parallel.hxx>
+#if OCC_VERSION_HEX >= VERSION_HEX_CODE(7,4,0)
+#include <OSD_ThreadPool.hxx>
+#endif
+
+#include <exception>
+#include <mutex>
+
+namespace occ_gordon_internal
+{
+
+namespace detail
+{
+
+/// Stores the first exception thrown by any of the worker threads
+class ExceptionCollector
+{
+public:
+    template <typename Func>
+    void Run(Func& func, int index)
+    {
+        try {
+            func(index);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_exception) {
+                m_exception = std::current_exception();
+            }
+        }
+    }
+
+    void Rethrow() const
+    {
+        if (m_exception) {
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+private:
+    std::mutex m_mutex;
+    std::exception_ptr m_exception;
+};
+
+/// Thread limit of the calling thread, see ScopedThreadLimit
+inline int& threadLimit()
+{
+    thread_local int limit = -1;
+    return limit;
+}
+
+} // namespace detail
+
+/**
+ * @brief Limits the number of threads used by ParallelFor in the calling thread
+ *
+ * The limit applies while the object is in scope and is passed on to the worker
+ * threads of nested ParallelFor calls. A value <= 0 removes the limit.
+ */
+class ScopedThreadLimit
+{
+public:
+    explicit ScopedThreadLimit(int nThreads)
+        : m_previous(detail::threadLimit())
+    {
+        detail::threadLimit() = nThreads;
+    }
+
+    ~ScopedThreadLimit()
+    {
+        detail::threadLimit() = m_previous;
+    }
+
+    ScopedThreadLimit(const ScopedThreadLimit&) = delete;
+    ScopedThreadLimit& operator=(const ScopedThreadLimit&) = delete;
+
+private:
+    int m_previous;
+};
+
+/**
+ * @brief Calls func(i) for all i in [begin, end) using the OCCT thread pool
+ *
+ * @param nThreads Maximum number of threads. A value <= 0 uses all
+ *                 available threads, 1 runs serially in the calling thread.
+ *                 In both cases, the number of threads is further limited by
+ *                 an active ScopedThreadLimit.
+ *
+ * Exceptions thrown by func are rethrown in the calling thread
+ * after all iterations are finished.
+ */
+template <typename Func>
+void ParallelFor(int begin, int end, Func func, int nThreads = -1)
+{
+    const int limit = detail::threadLimit();
+    if (limit > 0 && (nThreads <= 0 || nThreads > limit)) {
+        nThreads = limit;
+    }
+
+    if (end - begin <= 1 || nThreads == 1) {
+        for (int i = begin; i < end; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    detail::ExceptionCollector collector;
+
+#if OCC_VERSION_HEX >= VERSION_HEX_CODE(7,4,0)
+    const Handle(OSD_ThreadPool)& pool = OSD_ThreadPool::DefaultPool();
+    OSD_ThreadPool::Launcher launcher(*pool, nThreads > 0 ? nThreads : -1);
+    launcher.Perform(begin, end, [&](int /* threadIndex */, int index) {
+        ScopedThreadLimit workerLimit(limit);
+        collector.Run(func, index);
+    });
+#else
+    OSD_Parallel::For(begin, end, [&](int index) {
+        ScopedThreadLimit workerLimit(limit);
+        collector.Run(func, index);
+    });
+#endif
+
+    collector.Rethrow();
+}
+
+} // namespace occ_gordon_internal
+
+#endif // PARALLEL_H
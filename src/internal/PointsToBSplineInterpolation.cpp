@@ -9,9 +9,9 @@
 
 #include "internal/Error.h"
 #include "BSplineAlgorithms.h"
+#include "LinearAlgebra.h"
 
 #include <BSplCLib.hxx>
-#include <math_Gauss.hxx>
 #include <GeomConvert.hxx>
 #include <Geom_TrimmedCurve.hxx>
 
@@ -124,37 +124,22 @@ Handle(Geom_BSplineCurve) PointsToBSplineInterpolation::Curve() const
         }
     }
 
-    // right hand side
-    math_Vector rhsx(1, nParams, 0.);
-    math_Vector rhsy(1, nParams, 0.);
-    math_Vector rhsz(1, nParams, 0.);
+    // right hand side, one column per coordinate
+    math_Matrix rhs(1, nParams, 1, 3, 0.);
     for (int i = 1; i <= nParams; ++i) {
         const gp_Pnt& p = m_pnts->Value(i);
-        rhsx(i)         = p.X();
-        rhsy(i)         = p.Y();
-        rhsz(i)         = p.Z();
+        rhs(i, 1)       = p.X();
+        rhs(i, 2)       = p.Y();
+        rhs(i, 3)       = p.Z();
     }
 
-    math_Gauss solver(lhs);
-
-    math_Vector cp_x(1, nParams);
-    math_Vector cp_y(1, nParams);
-    math_Vector cp_z(1, nParams);
-
-    solver.Solve(rhsx, cp_x);
+    DenseLUSolver solver(lhs);
     if (!solver.IsDone()) {
         throw error("Singular Matrix", MATH_ERROR);
     }
 
-    solver.Solve(rhsy, cp_y);
-    if (!solver.IsDone()) {
-        throw error("Singular Matrix", MATH_ERROR);
-    }
-
-    solver.Solve(rhsz, cp_z);
-    if (!solver.IsDone()) {
-        throw error("Singular Matrix", MATH_ERROR);
-    }
+    math_Matrix cp(1, nParams, 1, 3);
+    solver.Solve(rhs, cp);
 
     int nCtrPnts = static_cast<int>(m_params.size());
     if (isClosed()) {
@@ -165,14 +150,14 @@ Handle(Geom_BSplineCurve) PointsToBSplineInterpolation::Curve() const
     }
     TColgp_Array1OfPnt poles(1, nCtrPnts);
     for (Standard_Integer icp = 1; icp <= nParams; ++icp) {
-        gp_Pnt pnt(cp_x.Value(icp), cp_y.Value(icp), cp_z.Value(icp));
+        gp_Pnt pnt(cp(icp, 1), cp(icp, 2), cp(icp, 3));
         poles.SetValue(icp, pnt);
     }
 
     if (isClosed()) {
         // wrap control points
         for (Standard_Integer icp = 1; icp <= degree; ++icp) {
-            gp_Pnt pnt(cp_x.Value(icp), cp_y.Value(icp), cp_z.Value(icp));
+            gp_Pnt pnt(cp(icp, 1), cp(icp, 2), cp(icp, 3));
             poles.SetValue(nParams + icp, pnt);
         }
     }
@@ -0,0 +1,521 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+#include "SurfaceCache.h"
+
+#include <Standard_Failure.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TColStd_Array2OfReal.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+const char kMagic[8] = {'O', 'C', 'C', 'G', 'C', 'A', 'C', 'H'};
+const std::uint32_t kFormatVersion = 1;
+const std::uint32_t kByteOrderMark = 0x01020304;
+const char* const kEntryExtension = ".gsurf";
+const char* const kTempExtension = ".tmp";
+
+// temporary files older than this are considered as left over by a crashed process
+const std::chrono::hours kStaleTempAge(1);
+
+std::uint64_t mix64(std::uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+std::uint64_t rotl(std::uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+std::string hex(std::uint64_t value)
+{
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+    return buffer;
+}
+
+class BinaryWriter
+{
+public:
+    template <typename T>
+    void Put(T value)
+    {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        m_buffer.insert(m_buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    void PutBytes(const char* bytes, size_t n)
+    {
+        m_buffer.insert(m_buffer.end(), bytes, bytes + n);
+    }
+
+    const std::vector<char>& Buffer() const
+    {
+        return m_buffer;
+    }
+
+private:
+    std::vector<char> m_buffer;
+};
+
+class BinaryReader
+{
+public:
+    explicit BinaryReader(const std::vector<char>& buffer)
+        : m_buffer(buffer)
+        , m_pos(0)
+    {}
+
+    template <typename T>
+    bool Get(T& value)
+    {
+        if (Remaining() < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, m_buffer.data() + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    bool GetBytes(char* bytes, size_t n)
+    {
+        if (Remaining() < n) {
+            return false;
+        }
+        std::memcpy(bytes, m_buffer.data() + m_pos, n);
+        m_pos += n;
+        return true;
+    }
+
+    size_t Remaining() const
+    {
+        return m_buffer.size() - m_pos;
+    }
+
+private:
+    const std::vector<char>& m_buffer;
+    size_t m_pos;
+};
+
+bool isRational(const Handle(Geom_BSplineSurface)& surface)
+{
+    return surface->IsURational() || surface->IsVRational();
+}
+
+void writeSurface(BinaryWriter& writer, const Handle(Geom_BSplineSurface)& surface)
+{
+    writer.Put<std::int32_t>(surface->UDegree());
+    writer.Put<std::int32_t>(surface->VDegree());
+    writer.Put<std::uint8_t>(surface->IsUPeriodic());
+    writer.Put<std::uint8_t>(surface->IsVPeriodic());
+    writer.Put<std::uint8_t>(isRational(surface));
+    writer.Put<std::int32_t>(surface->NbUKnots());
+    writer.Put<std::int32_t>(surface->NbVKnots());
+    writer.Put<std::int32_t>(surface->NbUPoles());
+    writer.Put<std::int32_t>(surface->NbVPoles());
+
+    for (int i = 1; i <= surface->NbUKnots(); ++i) {
+        writer.Put(surface->UKnot(i));
+        writer.Put<std::int32_t>(surface->UMultiplicity(i));
+    }
+    for (int i = 1; i <= surface->NbVKnots(); ++i) {
+        writer.Put(surface->VKnot(i));
+        writer.Put<std::int32_t>(surface->VMultiplicity(i));
+    }
+
+    for (int i = 1; i <= surface->NbUPoles(); ++i) {
+        for (int j = 1; j <= surface->NbVPoles(); ++j) {
+            const gp_Pnt& pole = surface->Pole(i, j);
+            writer.Put(pole.X());
+            writer.Put(pole.Y());
+            writer.Put(pole.Z());
+        }
+    }
+
+    if (isRational(surface)) {
+        for (int i = 1; i <= surface->NbUPoles(); ++i) {
+            for (int j = 1; j <= surface->NbVPoles(); ++j) {
+                writer.Put(surface->Weight(i, j));
+            }
+        }
+    }
+}
+
+bool readKnots(BinaryReader& reader, TColStd_Array1OfReal& knots, TColStd_Array1OfInteger& mults)
+{
+    for (int i = knots.Lower(); i <= knots.Upper(); ++i) {
+        std::int32_t mult = 0;
+        if (!reader.Get(knots.ChangeValue(i)) || !reader.Get(mult) || mult < 1) {
+            return false;
+        }
+        mults.SetValue(i, mult);
+    }
+    return true;
+}
+
+Handle(Geom_BSplineSurface) readSurface(BinaryReader& reader)
+{
+    std::int32_t uDegree = 0, vDegree = 0, nUKnots = 0, nVKnots = 0, nUPoles = 0, nVPoles = 0;
+    std::uint8_t uPeriodic = 0, vPeriodic = 0, rational = 0;
+    if (!reader.Get(uDegree) || !reader.Get(vDegree) ||
+        !reader.Get(uPeriodic) || !reader.Get(vPeriodic) || !reader.Get(rational) ||
+        !reader.Get(nUKnots) || !reader.Get(nVKnots) || !reader.Get(nUPoles) || !reader.Get(nVPoles)) {
+        return nullptr;
+    }
+
+    if (uDegree < 1 || vDegree < 1 || nUKnots < 2 || nVKnots < 2 || nUPoles < 2 || nVPoles < 2) {
+        return nullptr;
+    }
+
+    // reject sizes, that don't fit into the remaining data before allocating
+    const size_t nKnotBytes = (sizeof(double) + sizeof(std::int32_t)) * (static_cast<size_t>(nUKnots) + nVKnots);
+    const size_t nPoles = static_cast<size_t>(nUPoles) * static_cast<size_t>(nVPoles);
+    const size_t nPoleBytes = (rational ? 4 : 3) * sizeof(double) * nPoles;
+    if (nKnotBytes > reader.Remaining() || nPoleBytes > reader.Remaining() - nKnotBytes) {
+        return nullptr;
+    }
+
+    TColStd_Array1OfReal uKnots(1, nUKnots), vKnots(1, nVKnots);
+    TColStd_Array1OfInteger uMults(1, nUKnots), vMults(1, nVKnots);
+    if (!readKnots(reader, uKnots, uMults) || !readKnots(reader, vKnots, vMults)) {
+        return nullptr;
+    }
+
+    TColgp_Array2OfPnt poles(1, nUPoles, 1, nVPoles);
+    for (int i = 1; i <= nUPoles; ++i) {
+        for (int j = 1; j <= nVPoles; ++j) {
+            double x = 0., y = 0., z = 0.;
+            reader.Get(x);
+            reader.Get(y);
+            reader.Get(z);
+            poles.SetValue(i, j, gp_Pnt(x, y, z));
+        }
+    }
+
+    try {
+        if (!rational) {
+            return new Geom_BSplineSurface(poles, uKnots, vKnots, uMults, vMults, uDegree, vDegree,
+                                           uPeriodic != 0, vPeriodic != 0);
+        }
+
+        TColStd_Array2OfReal weights(1, nUPoles, 1, nVPoles);
+        for (int i = 1; i <= nUPoles; ++i) {
+            for (int j = 1; j <= nVPoles; ++j) {
+                reader.Get(weights.ChangeValue(i, j));
+            }
+        }
+        return new Geom_BSplineSurface(poles, weights, uKnots, vKnots, uMults, vMults, uDegree, vDegree,
+                                       uPeriodic != 0, vPeriodic != 0);
+    }
+    catch (Standard_Failure&) {
+        // inconsistent knots, multiplicities or degrees
+        return nullptr;
+    }
+}
+
+bool readFile(const fs::path& path, std::vector<char>& buffer)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    in.seekg(0, std::ios::end);
+    const std::streamoff size = in.tellg();
+    if (size <= 0) {
+        return false;
+    }
+    in.seekg(0, std::ios::beg);
+
+    buffer.resize(static_cast<size_t>(size));
+    in.read(buffer.data(), size);
+    return static_cast<bool>(in);
+}
+
+// Returns a file name suffix, that is unique among all threads and processes
+std::string uniqueSuffix()
+{
+    static std::atomic<std::uint64_t> counter(0);
+    std::random_device random;
+    const std::uint64_t value = (static_cast<std::uint64_t>(random()) << 32) ^ random() ^
+                                mix64(counter.fetch_add(1) + 1);
+    return "." + hex(value);
+}
+
+} // namespace
+
+namespace occ_gordon_internal
+{
+
+CacheKey::CacheKey()
+    : m_h1(0xcbf29ce484222325ULL)
+    , m_h2(0x9e3779b97f4a7c15ULL)
+{
+}
+
+void CacheKey::Add(std::uint64_t value)
+{
+    // FNV-1a over the bytes in little endian order
+    for (int i = 0; i < 8; ++i) {
+        m_h1 ^= (value >> (8 * i)) & 0xffu;
+        m_h1 *= 0x100000001b3ULL;
+    }
+
+    m_h2 = rotl(m_h2 ^ mix64(value), 29) * 0x9e3779b97f4a7c15ULL;
+}
+
+void CacheKey::Add(int value)
+{
+    Add(static_cast<std::uint64_t>(static_cast<std::int64_t>(value)));
+}
+
+void CacheKey::Add(bool value)
+{
+    Add(static_cast<std::uint64_t>(value ? 1 : 0));
+}
+
+void CacheKey::Add(double value)
+{
+    // 0. and -0. describe the same geometry
+    if (value == 0.) {
+        value = 0.;
+    }
+
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    Add(bits);
+}
+
+void CacheKey::Add(const std::string& value)
+{
+    Add(static_cast<std::uint64_t>(value.size()));
+    for (size_t i = 0; i < value.size(); i += 8) {
+        std::uint64_t word = 0;
+        for (size_t k = 0; k < 8 && i + k < value.size(); ++k) {
+            word |= static_cast<std::uint64_t>(static_cast<unsigned char>(value[i + k])) << (8 * k);
+        }
+        Add(word);
+    }
+}
+
+void CacheKey::Add(const Handle(Geom_BSplineCurve)& curve)
+{
+    if (curve.IsNull()) {
+        Add(std::string("null"));
+        return;
+    }
+
+    Add(std::string("bspline curve"));
+    Add(curve->Degree());
+    Add(static_cast<bool>(curve->IsPeriodic()));
+    Add(static_cast<bool>(curve->IsRational()));
+
+    Add(curve->NbKnots());
+    for (int i = 1; i <= curve->NbKnots(); ++i) {
+        Add(curve->Knot(i));
+        Add(curve->Multiplicity(i));
+    }
+
+    Add(curve->NbPoles());
+    for (int i = 1; i <= curve->NbPoles(); ++i) {
+        const gp_Pnt& pole = curve->Pole(i);
+        Add(pole.X());
+        Add(pole.Y());
+        Add(pole.Z());
+        if (curve->IsRational()) {
+            Add(curve->Weight(i));
+        }
+    }
+}
+
+std::string CacheKey::Hex() const
+{
+    return hex(mix64(m_h1)) + hex(mix64(m_h2));
+}
+
+SurfaceCache::SurfaceCache(const fs::path& directory, size_t maxBytes)
+    : m_directory(directory)
+    , m_maxBytes(maxBytes)
+{
+}
+
+fs::path SurfaceCache::EntryPath(const CacheKey& key) const
+{
+    return m_directory / (key.Hex() + kEntryExtension);
+}
+
+bool SurfaceCache::Load(const CacheKey& key, CacheEntry& entry) const
+{
+    const fs::path path = EntryPath(key);
+
+    std::vector<char> buffer;
+    if (!readFile(path, buffer)) {
+        return false;
+    }
+
+    BinaryReader reader(buffer);
+    char magic[sizeof(kMagic)];
+    std::uint32_t version = 0, byteOrder = 0;
+    std::string storedKey(32, ' ');
+    if (!reader.GetBytes(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+        !reader.Get(version) || version != kFormatVersion ||
+        !reader.Get(byteOrder) || byteOrder != kByteOrderMark ||
+        !reader.GetBytes(&storedKey[0], storedKey.size()) || storedKey != key.Hex()) {
+        return false;
+    }
+
+    CacheEntry result;
+    result.surface = readSurface(reader);
+    if (result.surface.IsNull() || reader.Remaining() != 0) {
+        return false;
+    }
+
+    // mark the entry as recently used
+    std::error_code ec;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+
+    entry = std::move(result);
+    return true;
+}
+
+bool SurfaceCache::Store(const CacheKey& key, const CacheEntry& entry)
+{
+    if (entry.surface.IsNull()) {
+        return false;
+    }
+
+    BinaryWriter writer;
+    writer.PutBytes(kMagic, sizeof(kMagic));
+    writer.Put(kFormatVersion);
+    writer.Put(kByteOrderMark);
+    const std::string keyString = key.Hex();
+    writer.PutBytes(keyString.data(), keyString.size());
+    writeSurface(writer, entry.surface);
+
+    const std::vector<char>& buffer = writer.Buffer();
+    if (m_maxBytes > 0 && buffer.size() > m_maxBytes) {
+        return false;
+    }
+
+    std::error_code ec;
+    fs::create_directories(m_directory, ec);
+    if (ec) {
+        return false;
+    }
+
+    // write to a temporary file first, such that other processes never see a partial entry
+    const fs::path path = EntryPath(key);
+    const fs::path tempPath = m_directory / (keyString + uniqueSuffix() + kTempExtension);
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        out.close();
+        if (!out) {
+            fs::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        // e.g. on windows, if another process has just written the same entry
+        fs::remove(tempPath, ec);
+        return fs::exists(path, ec);
+    }
+
+    EnforceSizeLimit(path);
+    return true;
+}
+
+void SurfaceCache::EnforceSizeLimit(const fs::path& keep) const
+{
+    if (m_maxBytes == 0) {
+        return;
+    }
+
+    struct FileInfo
+    {
+        fs::path path;
+        std::uintmax_t size;
+        fs::file_time_type time;
+    };
+
+    const fs::file_time_type staleTime = fs::file_time_type::clock::now() - kStaleTempAge;
+
+    std::vector<FileInfo> entries;
+    std::uintmax_t totalSize = 0;
+
+    // other processes may add or remove files concurrently, hence all errors are ignored
+    std::error_code ec;
+    for (fs::directory_iterator it(m_directory, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code fileEc;
+        if (!it->is_regular_file(fileEc)) {
+            continue;
+        }
+
+        const fs::path& path = it->path();
+        const fs::file_time_type time = it->last_write_time(fileEc);
+        if (fileEc) {
+            continue;
+        }
+
+        if (path.extension() == kTempExtension) {
+            if (time < staleTime) {
+                fs::remove(path, fileEc);
+            }
+        }
+        else if (path.extension() == kEntryExtension) {
+            const std::uintmax_t size = it->file_size(fileEc);
+            if (!fileEc) {
+                entries.push_back({path, size, time});
+                totalSize += size;
+            }
+        }
+    }
+
+    if (totalSize <= m_maxBytes) {
+        return;
+    }
+
+    // remove the least recently used entries first
+    std::sort(entries.begin(), entries.end(), [](const FileInfo& a, const FileInfo& b) {
+        return a.time < b.time;
+    });
+
+    for (const FileInfo& entry : entries) {
+        if (totalSize <= m_maxBytes) {
+            break;
+        }
+        if (entry.path == keep) {
+            continue;
+        }
+
+        std::error_code removeEc;
+        fs::remove(entry.path, removeEc);
+        totalSize -= entry.size;
+    }
+}
+
+} // namespace occ_gordon_internal
@@ -0,0 +1,100 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+#ifndef SURFACECACHE_H
+#define SURFACECACHE_H
+
+#include <Geom_BSplineCurve.hxx>
+#include <Geom_BSplineSurface.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace occ_gordon_internal
+{
+
+/**
+ * @brief Stable 128 bit hash of the inputs of a computation
+ *
+ * All values are hashed in a fixed byte order, such that the key
+ * does not depend on the platform or on the process, which computed it.
+ * Floating point values are hashed bitwise, i.e. any change of
+ * a curve gives a different key.
+ */
+class CacheKey
+{
+public:
+    CacheKey();
+
+    void Add(std::uint64_t value);
+    void Add(int value);
+    void Add(bool value);
+    void Add(double value);
+    void Add(const std::string& value);
+
+    /// Adds degree, knots, multiplicities, poles and weights of the curve
+    void Add(const Handle(Geom_BSplineCurve)& curve);
+
+    /// Returns the key as a string of 32 hexadecimal digits
+    std::string Hex() const;
+
+private:
+    std::uint64_t m_h1;
+    std::uint64_t m_h2;
+};
+
+/// Result of a curve network interpolation, as stored in the cache
+struct CacheEntry
+{
+    Handle(Geom_BSplineSurface) surface;
+};
+
+/**
+ * @brief Persistent cache of curve network interpolation results in a directory
+ *
+ * Each entry is stored in its own binary file, which is named after the key.
+ * Entries are written to a temporary file first, that is renamed afterwards.
+ * Hence, several processes can share the directory and never read partially
+ * written entries.
+ *
+ * If the total size of the entries exceeds the limit, the least recently used
+ * entries are removed. Reading an entry marks it as used.
+ *
+ * The cache never throws. Unreadable or invalid entries are treated as a miss,
+ * failed writes are ignored.
+ */
+class SurfaceCache
+{
+public:
+    /**
+     * @param directory The cache directory, it is created if required
+     * @param maxBytes Maximum total size of all entries. 0 means unlimited
+     */
+    SurfaceCache(const std::filesystem::path& directory, size_t maxBytes);
+
+    /// Reads the entry of the key. Returns false, if there is no valid entry
+    bool Load(const CacheKey& key, CacheEntry& entry) const;
+
+    /// Writes the entry of the key. Returns false, if the entry could not be written
+    bool Store(const CacheKey& key, const CacheEntry& entry);
+
+    const std::filesystem::path& Directory() const { return m_directory; }
+    size_t MaxBytes() const { return m_maxBytes; }
+
+    /// Returns the path of the entry file of the key
+    std::filesystem::path EntryPath(const CacheKey& key) const;
+
+private:
+    void EnforceSizeLimit(const std::filesystem::path& keep) const;
+
+    std::filesystem::path m_directory;
+    size_t m_maxBytes;
+};
+
+} // namespace occ_gordon_internal
+
+#endif // SURFACECACHE_H
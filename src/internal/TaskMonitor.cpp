@@ -0,0 +1,72 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+#include "TaskMonitor.h"
+
+#include "Error.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace occ_gordon_internal
+{
+
+TaskMonitor::TaskMonitor(ProgressCallback progress, CancelCheck isCancelled)
+    : m_progress(std::move(progress))
+    , m_isCancelled(std::move(isCancelled))
+    , m_stageBegin(0.)
+    , m_stageWeight(0.)
+    , m_reported(-1.)
+{
+}
+
+void TaskMonitor::BeginStage(const std::string& name, double weight)
+{
+    CheckCancelled();
+
+    m_stageBegin = std::min(1., m_stageBegin + m_stageWeight);
+    m_stageWeight = std::max(0., std::min(weight, 1. - m_stageBegin));
+    m_stage = name;
+    Report(m_stageBegin);
+}
+
+void TaskMonitor::SetStageProgress(double fraction)
+{
+    CheckCancelled();
+
+    fraction = std::max(0., std::min(fraction, 1.));
+    Report(m_stageBegin + fraction * m_stageWeight);
+}
+
+void TaskMonitor::CheckCancelled() const
+{
+    if (m_isCancelled && m_isCancelled()) {
+        throw error("The computation has been cancelled.", CANCELLED);
+    }
+}
+
+void TaskMonitor::Finish()
+{
+    m_stageBegin = 1.;
+    m_stageWeight = 0.;
+    Report(1.);
+}
+
+void TaskMonitor::Report(double progress)
+{
+    // the progress never decreases, e.g. if a stage is repeated.
+    // The begin of a new stage is always reported, such that its duration can be measured.
+    if (progress <= m_reported && m_stage == m_reportedStage) {
+        return;
+    }
+
+    m_reported = std::max(progress, m_reported);
+    m_reportedStage = m_stage;
+    if (m_progress) {
+        m_progress(m_reported, m_stage);
+    }
+}
+
+} // namespace occ_gordon_internal
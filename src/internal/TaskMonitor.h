@@ -0,0 +1,71 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+#ifndef TASKMONITOR_H
+#define TASKMONITOR_H
+
+#include <functional>
+#include <string>
+
+namespace occ_gordon_internal
+{
+
+/**
+ * @brief Reports the progress of a long running computation and allows to cancel it
+ *
+ * The computation is divided into consecutive stages, each covering a fixed
+ * fraction of the total progress. Inside a stage, the algorithms report the progress
+ * of their loops with SetStageProgress, which also checks for cancellation.
+ * The reported total progress never decreases. The begin of each stage is reported,
+ * even if the progress did not change.
+ *
+ * The monitor must only be used by the thread running the computation.
+ * The cancel check however is typically triggered from another thread.
+ * Parallel loops may call CheckCancelled from their worker threads, hence the
+ * cancel check must be thread-safe.
+ */
+class TaskMonitor
+{
+public:
+    /// Receives the total progress in [0, 1] and the name of the current stage
+    using ProgressCallback = std::function<void(double progress, const std::string& stage)>;
+
+    /// Returns true, if the computation should stop
+    using CancelCheck = std::function<bool()>;
+
+    explicit TaskMonitor(ProgressCallback progress = ProgressCallback(),
+                         CancelCheck isCancelled = CancelCheck());
+
+    /// Starts the next stage, which covers the given fraction of the total progress
+    void BeginStage(const std::string& name, double weight);
+
+    /**
+     * @brief Sets the progress inside the current stage
+     * @param fraction Completed fraction of the stage in [0, 1]
+     * @throws error with code CANCELLED, if the computation has been cancelled
+     */
+    void SetStageProgress(double fraction);
+
+    /// Throws an error with code CANCELLED, if the computation has been cancelled
+    void CheckCancelled() const;
+
+    /// Reports the completion of the computation
+    void Finish();
+
+private:
+    void Report(double progress);
+
+    ProgressCallback m_progress;
+    CancelCheck m_isCancelled;
+    std::string m_stage;
+    double m_stageBegin;
+    double m_stageWeight;
+    double m_reported;
+    std::string m_reportedStage;
+};
+
+} // namespace occ_gordon_internal
+
+#endif // TASKMONITOR_H
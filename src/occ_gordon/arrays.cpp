@@ -0,0 +1,124 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+*/
+/**
+* @file
+* @brief Conversion of B-splines from and to flat arrays
+*/
+
+#include "arrays.h"
+#include "io.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace occ_gordon
+{
+
+std::vector<Handle(Geom_BSplineCurve)> to_bspline_curves(const BSplineCurveArrays& arrays)
+{
+    if (arrays.n_curves > 0 && (!arrays.degrees || !arrays.n_knots || !arrays.n_poles ||
+                                !arrays.knots || !arrays.multiplicities || !arrays.poles)) {
+        throw std::runtime_error("The curve arrays are incomplete");
+    }
+
+    std::vector<Handle(Geom_BSplineCurve)> curves;
+    curves.reserve(arrays.n_curves);
+
+    size_t knotOffset = 0;
+    size_t poleOffset = 0;
+    for (size_t i = 0; i < arrays.n_curves; ++i) {
+        if (arrays.n_knots[i] < 2 || arrays.n_poles[i] < 2) {
+            throw std::runtime_error("Curve " + std::to_string(i) + " has too few knots or poles");
+        }
+
+        BSplineCurveView view;
+        view.degree = arrays.degrees[i];
+        view.periodic = arrays.periodic && arrays.periodic[i] != 0;
+        view.rational = arrays.weights != nullptr;
+        view.n_knots = static_cast<size_t>(arrays.n_knots[i]);
+        view.knots = arrays.knots + knotOffset;
+        view.multiplicities = arrays.multiplicities + knotOffset;
+        view.n_poles = static_cast<size_t>(arrays.n_poles[i]);
+        view.poles = arrays.poles + 3 * poleOffset;
+        view.weights = arrays.weights ? arrays.weights + poleOffset : nullptr;
+
+        try {
+            curves.push_back(to_bspline_curve(view));
+        }
+        catch (const std::runtime_error& err) {
+            throw std::runtime_error("Curve " + std::to_string(i) + ": " + err.what());
+        }
+
+        knotOffset += view.n_knots;
+        poleOffset += view.n_poles;
+    }
+
+    return curves;
+}
+
+BSplineSurfaceArraySizes surface_array_sizes(const Handle(Geom_BSplineSurface)& surface)
+{
+    if (surface.IsNull()) {
+        throw std::runtime_error("The surface is null");
+    }
+
+    BSplineSurfaceArraySizes sizes;
+    sizes.u_degree = surface->UDegree();
+    sizes.v_degree = surface->VDegree();
+    sizes.u_periodic = surface->IsUPeriodic();
+    sizes.v_periodic = surface->IsVPeriodic();
+    sizes.rational = surface->IsURational() || surface->IsVRational();
+    sizes.n_u_knots = static_cast<size_t>(surface->NbUKnots());
+    sizes.n_v_knots = static_cast<size_t>(surface->NbVKnots());
+    sizes.n_u_poles = static_cast<size_t>(surface->NbUPoles());
+    sizes.n_v_poles = static_cast<size_t>(surface->NbVPoles());
+    return sizes;
+}
+
+void copy_surface_arrays(const Handle(Geom_BSplineSurface)& surface,
+                         double* u_knots, std::int32_t* u_multiplicities,
+                         double* v_knots, std::int32_t* v_multiplicities,
+                         double* poles, double* weights)
+{
+    if (surface.IsNull()) {
+        throw std::runtime_error("The surface is null");
+    }
+
+    for (int i = 1; i <= surface->NbUKnots(); ++i) {
+        if (u_knots) {
+            u_knots[i - 1] = surface->UKnot(i);
+        }
+        if (u_multiplicities) {
+            u_multiplicities[i - 1] = surface->UMultiplicity(i);
+        }
+    }
+
+    for (int i = 1; i <= surface->NbVKnots(); ++i) {
+        if (v_knots) {
+            v_knots[i - 1] = surface->VKnot(i);
+        }
+        if (v_multiplicities) {
+            v_multiplicities[i - 1] = surface->VMultiplicity(i);
+        }
+    }
+
+    const int nVPoles = surface->NbVPoles();
+    for (int i = 1; i <= surface->NbUPoles(); ++i) {
+        for (int j = 1; j <= nVPoles; ++j) {
+            const size_t index = static_cast<size_t>(i - 1) * nVPoles + (j - 1);
+            if (poles) {
+                const gp_Pnt& pole = surface->Pole(i, j);
+                poles[3 * index] = pole.X();
+                poles[3 * index + 1] = pole.Y();
+                poles[3 * index + 2] = pole.Z();
+            }
+            if (weights) {
+                weights[index] = surface->Weight(i, j);
+            }
+        }
+    }
+}
+
+} // namespace occ_gordon
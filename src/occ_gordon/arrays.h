@@ -0,0 +1,102 @@
+#pragma once
+
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ */
+
+#include <occ_gordon/exports.h>
+
+#include <Geom_BSplineCurve.hxx>
+#include <Geom_BSplineSurface.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Conversion of B-spline curves and surfaces from and to flat arrays.
+ *
+ * This allows to pass the curve network and the resulting surface between occ_gordon
+ * and array based code (e.g. NumPy) without creating individual OpenCASCADE objects
+ * on the caller side.
+ */
+
+namespace occ_gordon
+{
+
+/**
+ * @brief Several B-spline curves, stored back to back in flat arrays
+ *
+ * The arrays are not owned and must be valid while they are used.
+ * The knots, multiplicities, poles and weights of curve k follow directly
+ * after those of curve k - 1.
+ */
+struct BSplineCurveArrays
+{
+    size_t n_curves = 0;
+
+    /// Degree of each curve, n_curves values
+    const std::int32_t* degrees = nullptr;
+
+    /// Number of knots of each curve, n_curves values
+    const std::int32_t* n_knots = nullptr;
+
+    /// Number of poles of each curve, n_curves values
+    const std::int32_t* n_poles = nullptr;
+
+    /// Knots without repetition, sum(n_knots) values
+    const double* knots = nullptr;
+
+    /// Multiplicities of the knots, sum(n_knots) values
+    const std::int32_t* multiplicities = nullptr;
+
+    /// Poles as x, y, z triples, 3 * sum(n_poles) values
+    const double* poles = nullptr;
+
+    /// Weights of the poles, sum(n_poles) values. nullptr, if all curves are non-rational
+    const double* weights = nullptr;
+
+    /// Periodicity flag of each curve, n_curves values. nullptr, if no curve is periodic
+    const std::uint8_t* periodic = nullptr;
+};
+
+/**
+ * @brief Creates the curves stored in the arrays
+ * @throws std::runtime_error, if a curve is not a valid B-spline
+ */
+OCC_GORDON_EXPORT std::vector<Handle(Geom_BSplineCurve)> to_bspline_curves(const BSplineCurveArrays& arrays);
+
+/// Degrees and array sizes of a B-spline surface
+struct BSplineSurfaceArraySizes
+{
+    int u_degree = 0;
+    int v_degree = 0;
+    bool u_periodic = false;
+    bool v_periodic = false;
+    bool rational = false;
+
+    size_t n_u_knots = 0;
+    size_t n_v_knots = 0;
+    size_t n_u_poles = 0;
+    size_t n_v_poles = 0;
+};
+
+/// Returns the degrees and array sizes of the surface
+OCC_GORDON_EXPORT BSplineSurfaceArraySizes surface_array_sizes(const Handle(Geom_BSplineSurface)& surface);
+
+/**
+ * @brief Copies knots, multiplicities, poles and weights of the surface into the given arrays
+ *
+ * The sizes of the arrays are given by surface_array_sizes. The poles are stored as x, y, z
+ * triples, pole (i, j) starts at index 3 * (i * n_v_poles + j). The weights use the same order.
+ * Any of the arrays may be nullptr, if it is not needed.
+ */
+OCC_GORDON_EXPORT void copy_surface_arrays(const Handle(Geom_BSplineSurface)& surface,
+                                           double* u_knots, std::int32_t* u_multiplicities,
+                                           double* v_knots, std::int32_t* v_multiplicities,
+                                           double* poles, double* weights);
+
+} // namespace occ_gordon
@@ -0,0 +1,99 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+*/
+/**
+* @file
+* @brief Evaluation of surfaces on parameter grids
+*/
+
+#include "evaluator.h"
+
+#include "internal/BSplineSurfaceEvaluator.h"
+#include "internal/Error.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+void copyPoints(const std::vector<gp_XYZ>& points, double* result)
+{
+    for (size_t i = 0; i < points.size(); ++i) {
+        result[3 * i] = points[i].X();
+        result[3 * i + 1] = points[i].Y();
+        result[3 * i + 2] = points[i].Z();
+    }
+}
+
+} // namespace
+
+namespace occ_gordon
+{
+
+struct SurfaceEvaluator::Impl
+{
+    explicit Impl(const Handle(Geom_BSplineSurface)& surface)
+        : evaluator(surface)
+    {
+    }
+
+    occ_gordon_internal::BSplineSurfaceEvaluator evaluator;
+};
+
+SurfaceEvaluator::SurfaceEvaluator(const Handle(Geom_BSplineSurface)& surface)
+{
+    try {
+        m_impl = std::make_unique<Impl>(surface);
+    }
+    catch (occ_gordon_internal::error& err) {
+        throw std::runtime_error(std::string("Cannot create surface evaluator: ") + err.what());
+    }
+}
+
+SurfaceEvaluator::~SurfaceEvaluator() = default;
+
+void SurfaceEvaluator::evaluate_grid(const double* u, size_t n_u, const double* v, size_t n_v,
+                                     double* points, double* du, double* dv, int threads) const
+{
+    const size_t n = n_u * n_v;
+    std::vector<gp_XYZ> p(n), pu(du ? n : 0), pv(dv ? n : 0);
+    try {
+        m_impl->evaluator.EvaluateGrid(u, n_u, v, n_v, p.data(), du ? pu.data() : nullptr, dv ? pv.data() : nullptr, threads);
+    }
+    catch (occ_gordon_internal::error& err) {
+        throw std::runtime_error(std::string("Error evaluating the surface: ") + err.what());
+    }
+
+    copyPoints(p, points);
+    if (du) {
+        copyPoints(pu, du);
+    }
+    if (dv) {
+        copyPoints(pv, dv);
+    }
+}
+
+void SurfaceEvaluator::evaluate_points(const double* u, const double* v, size_t n,
+                                       double* points, double* du, double* dv, int threads) const
+{
+    std::vector<gp_XYZ> p(n), pu(du ? n : 0), pv(dv ? n : 0);
+    try {
+        m_impl->evaluator.EvaluatePoints(u, v, n, p.data(), du ? pu.data() : nullptr, dv ? pv.data() : nullptr, threads);
+    }
+    catch (occ_gordon_internal::error& err) {
+        throw std::runtime_error(std::string("Error evaluating the surface: ") + err.what());
+    }
+
+    copyPoints(p, points);
+    if (du) {
+        copyPoints(pu, du);
+    }
+    if (dv) {
+        copyPoints(pv, dv);
+    }
+}
+
+} // namespace occ_gordon
@@ -0,0 +1,74 @@
+#pragma once
+
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ */
+
+#include <occ_gordon/exports.h>
+
+#include <Geom_BSplineSurface.hxx>
+
+#include <cstddef>
+#include <memory>
+
+/**
+ * @file
+ *
+ * Fast evaluation of the resulting surface on many parameters, e.g. for meshing or surface grids.
+ */
+
+namespace occ_gordon
+{
+
+/**
+ * @brief Evaluates a B-spline surface and its first derivatives on parameter grids and batches
+ *
+ * Compared to calling Geom_BSplineSurface::D1 per point, the basis functions are
+ * computed only once per grid line and the evaluation runs in parallel.
+ *
+ * Points and derivatives are written as x, y, z triples into caller provided arrays.
+ * The evaluator copies the surface, later modifications of the surface are not seen.
+ * It can be used concurrently from several threads.
+ */
+class OCC_GORDON_EXPORT SurfaceEvaluator
+{
+public:
+    /// @throws std::runtime_error, if the surface is null
+    explicit SurfaceEvaluator(const Handle(Geom_BSplineSurface)& surface);
+    ~SurfaceEvaluator();
+
+    SurfaceEvaluator(const SurfaceEvaluator&) = delete;
+    SurfaceEvaluator& operator=(const SurfaceEvaluator&) = delete;
+
+    /**
+     * @brief Evaluates the surface on the tensor grid u x v
+     *
+     * The point (u[i], v[j]) starts at index 3 * (i * n_v + j). Ascending parameters
+     * are evaluated fastest.
+     *
+     * @param points Array of size 3 * n_u * n_v
+     * @param du Optional array of size 3 * n_u * n_v for the derivatives in u direction, may be nullptr
+     * @param dv Optional array of size 3 * n_u * n_v for the derivatives in v direction, may be nullptr
+     * @param threads Maximum number of threads. A value <= 0 uses all available threads
+     */
+    void evaluate_grid(const double* u, size_t n_u, const double* v, size_t n_v,
+                       double* points, double* du = nullptr, double* dv = nullptr, int threads = 0) const;
+
+    /**
+     * @brief Evaluates the surface at the scattered parameters (u[i], v[i])
+     *
+     * @param points Array of size 3 * n
+     * @param du Optional array of size 3 * n for the derivatives in u direction, may be nullptr
+     * @param dv Optional array of size 3 * n for the derivatives in v direction, may be nullptr
+     * @param threads Maximum number of threads. A value <= 0 uses all available threads
+     */
+    void evaluate_points(const double* u, const double* v, size_t n,
+                         double* points, double* du = nullptr, double* dv = nullptr, int threads = 0) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace occ_gordon
@@ -0,0 +1,664 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+*/
+/**
+* @file
+* @brief Reading and writing of BRep files and of the binary geometry format
+*/
+
+#include "io.h"
+
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepTools.hxx>
+#include <Geom_TrimmedCurve.hxx>
+#include <GeomConvert.hxx>
+#include <Precision.hxx>
+#include <Standard_Failure.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TColStd_Array2OfReal.hxx>
+#include <TColgp_Array1OfPnt.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Edge.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+const char kMagic[8] = {'O', 'C', 'C', 'G', 'B', 'I', 'N', '\0'};
+const std::uint32_t kVersion = 1;
+const std::uint32_t kByteOrderMark = 0x01020304;
+
+enum RecordType : std::uint32_t
+{
+    RECORD_CURVE = 1,
+    RECORD_SURFACE = 2
+};
+
+enum CurveRole : std::uint32_t
+{
+    ROLE_NONE = 0,
+    ROLE_PROFILE = 1,
+    ROLE_GUIDE = 2
+};
+
+enum RecordFlags : std::uint32_t
+{
+    U_PERIODIC = 1,
+    V_PERIODIC = 2,
+    RATIONAL = 4
+};
+
+struct FileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint64_t nRecords;
+    std::uint64_t recordsOffset;
+    std::uint64_t fileSize;
+    std::uint8_t reserved[24];
+};
+static_assert(sizeof(FileHeader) == 64, "The header must have 64 bytes");
+
+// Curves only use the first entry of the u/v arrays
+struct Record
+{
+    std::uint32_t type;
+    std::uint32_t role;
+    std::uint32_t flags;
+    std::int32_t degree[2];
+    std::int32_t nKnots[2];
+    std::int32_t nPoles[2];
+    std::uint32_t reserved0;
+    std::uint64_t knotsOffset[2];
+    std::uint64_t multsOffset[2];
+    std::uint64_t polesOffset;
+    std::uint64_t weightsOffset;
+    std::uint64_t reserved1;
+};
+static_assert(sizeof(Record) == 96, "A record must have 96 bytes");
+
+class BinaryGeometryWriter
+{
+public:
+    void AddCurve(const Handle(Geom_BSplineCurve)& curve, CurveRole role)
+    {
+        if (curve.IsNull()) {
+            throw std::runtime_error("Cannot write a null curve");
+        }
+        m_curves.push_back({curve, role});
+    }
+
+    void AddSurface(const Handle(Geom_BSplineSurface)& surface)
+    {
+        if (surface.IsNull()) {
+            throw std::runtime_error("Cannot write a null surface");
+        }
+        m_surfaces.push_back(surface);
+    }
+
+    void Write(const std::string& path)
+    {
+        const size_t nRecords = m_curves.size() + m_surfaces.size();
+        std::vector<Record> records;
+        records.reserve(nRecords);
+
+        m_buffer.assign(sizeof(FileHeader) + nRecords * sizeof(Record), 0);
+
+        for (const auto& curve : m_curves) {
+            records.push_back(CurveRecord(curve.first, curve.second));
+        }
+        for (const auto& surface : m_surfaces) {
+            records.push_back(SurfaceRecord(surface));
+        }
+
+        FileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.byteOrder = kByteOrderMark;
+        header.nRecords = nRecords;
+        header.recordsOffset = sizeof(FileHeader);
+        header.fileSize = m_buffer.size();
+
+        std::memcpy(m_buffer.data(), &header, sizeof(header));
+        if (nRecords > 0) {
+            std::memcpy(m_buffer.data() + sizeof(FileHeader), records.data(), nRecords * sizeof(Record));
+        }
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        out.close();
+        if (!out) {
+            throw std::runtime_error("Cannot write binary geometry file " + path);
+        }
+    }
+
+private:
+    // Appends the values 8 byte aligned and returns their offset
+    template <typename T>
+    std::uint64_t Append(const std::vector<T>& values)
+    {
+        m_buffer.resize((m_buffer.size() + 7) / 8 * 8, 0);
+        const std::uint64_t offset = m_buffer.size();
+        const char* bytes = reinterpret_cast<const char*>(values.data());
+        m_buffer.insert(m_buffer.end(), bytes, bytes + values.size() * sizeof(T));
+        return offset;
+    }
+
+    Record CurveRecord(const Handle(Geom_BSplineCurve)& curve, CurveRole role)
+    {
+        Record record;
+        std::memset(&record, 0, sizeof(record));
+        record.type = RECORD_CURVE;
+        record.role = role;
+        record.flags = (curve->IsPeriodic() ? U_PERIODIC : 0) | (curve->IsRational() ? RATIONAL : 0);
+        record.degree[0] = curve->Degree();
+        record.nKnots[0] = curve->NbKnots();
+        record.nPoles[0] = curve->NbPoles();
+
+        std::vector<double> knots, poles, weights;
+        std::vector<std::int32_t> mults;
+        for (int i = 1; i <= curve->NbKnots(); ++i) {
+            knots.push_back(curve->Knot(i));
+            mults.push_back(curve->Multiplicity(i));
+        }
+        for (int i = 1; i <= curve->NbPoles(); ++i) {
+            const gp_Pnt& pole = curve->Pole(i);
+            poles.insert(poles.end(), {pole.X(), pole.Y(), pole.Z()});
+            weights.push_back(curve->Weight(i));
+        }
+
+        record.knotsOffset[0] = Append(knots);
+        record.multsOffset[0] = Append(mults);
+        record.polesOffset = Append(poles);
+        if (curve->IsRational()) {
+            record.weightsOffset = Append(weights);
+        }
+        return record;
+    }
+
+    Record SurfaceRecord(const Handle(Geom_BSplineSurface)& surface)
+    {
+        const bool rational = surface->IsURational() || surface->IsVRational();
+
+        Record record;
+        std::memset(&record, 0, sizeof(record));
+        record.type = RECORD_SURFACE;
+        record.role = ROLE_NONE;
+        record.flags = (surface->IsUPeriodic() ? U_PERIODIC : 0) | (surface->IsVPeriodic() ? V_PERIODIC : 0) |
+                       (rational ? RATIONAL : 0);
+        record.degree[0] = surface->UDegree();
+        record.degree[1] = surface->VDegree();
+        record.nKnots[0] = surface->NbUKnots();
+        record.nKnots[1] = surface->NbVKnots();
+        record.nPoles[0] = surface->NbUPoles();
+        record.nPoles[1] = surface->NbVPoles();
+
+        std::vector<double> uKnots, vKnots, poles, weights;
+        std::vector<std::int32_t> uMults, vMults;
+        for (int i = 1; i <= surface->NbUKnots(); ++i) {
+            uKnots.push_back(surface->UKnot(i));
+            uMults.push_back(surface->UMultiplicity(i));
+        }
+        for (int i = 1; i <= surface->NbVKnots(); ++i) {
+            vKnots.push_back(surface->VKnot(i));
+            vMults.push_back(surface->VMultiplicity(i));
+        }
+        for (int i = 1; i <= surface->NbUPoles(); ++i) {
+            for (int j = 1; j <= surface->NbVPoles(); ++j) {
+                const gp_Pnt& pole = surface->Pole(i, j);
+                poles.insert(poles.end(), {pole.X(), pole.Y(), pole.Z()});
+                weights.push_back(surface->Weight(i, j));
+            }
+        }
+
+        record.knotsOffset[0] = Append(uKnots);
+        record.knotsOffset[1] = Append(vKnots);
+        record.multsOffset[0] = Append(uMults);
+        record.multsOffset[1] = Append(vMults);
+        record.polesOffset = Append(poles);
+        if (rational) {
+            record.weightsOffset = Append(weights);
+        }
+        return record;
+    }
+
+    std::vector<std::pair<Handle(Geom_BSplineCurve), CurveRole>> m_curves;
+    std::vector<Handle(Geom_BSplineSurface)> m_surfaces;
+    std::vector<char> m_buffer;
+};
+
+} // namespace
+
+namespace occ_gordon
+{
+
+struct MappedGeometryFile::Impl
+{
+    explicit Impl(const std::string& filename)
+        : path(filename)
+    {
+        Map();
+        try {
+            Parse();
+        }
+        catch (...) {
+            Unmap();
+            throw;
+        }
+    }
+
+    ~Impl()
+    {
+        Unmap();
+    }
+
+    void Map()
+    {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Cannot open binary geometry file " + path);
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(FileHeader))) {
+            Unmap();
+            throw std::runtime_error("Invalid binary geometry file " + path + ": file too small");
+        }
+        size = static_cast<size_t>(fileSize.QuadPart);
+
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) {
+            data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+#else
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open binary geometry file " + path);
+        }
+
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0 || fileStat.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+            close(fd);
+            throw std::runtime_error("Invalid binary geometry file " + path + ": file too small");
+        }
+        size = static_cast<size_t>(fileStat.st_size);
+
+        void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (address != MAP_FAILED) {
+            data = static_cast<const char*>(address);
+        }
+#endif
+        if (!data) {
+            Unmap();
+            throw std::runtime_error("Cannot map binary geometry file " + path);
+        }
+    }
+
+    void Unmap()
+    {
+#ifdef _WIN32
+        if (data) {
+            UnmapViewOfFile(data);
+        }
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (data) {
+            munmap(const_cast<char*>(data), size);
+        }
+#endif
+        data = nullptr;
+    }
+
+    [[noreturn]] void Invalid(const std::string& reason) const
+    {
+        throw std::runtime_error("Invalid binary geometry file " + path + ": " + reason);
+    }
+
+    // Returns a pointer to n values at offset after checking the bounds and alignment
+    template <typename T>
+    const T* Array(std::uint64_t offset, size_t n) const
+    {
+        if (offset % 8 != 0 || offset > size || n > (size - offset) / sizeof(T)) {
+            Invalid("array out of bounds");
+        }
+        return reinterpret_cast<const T*>(data + offset);
+    }
+
+    void Parse()
+    {
+        FileHeader header;
+        std::memcpy(&header, data, sizeof(header));
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+            Invalid("not a binary geometry file");
+        }
+        if (header.byteOrder != kByteOrderMark) {
+            Invalid("the file has been written on a machine with another byte order");
+        }
+        if (header.version != kVersion) {
+            Invalid("unsupported version " + std::to_string(header.version));
+        }
+        if (header.fileSize != size) {
+            Invalid("file is truncated");
+        }
+        version = header.version;
+
+        const Record* records = Array<Record>(header.recordsOffset, static_cast<size_t>(header.nRecords));
+        for (size_t i = 0; i < header.nRecords; ++i) {
+            const Record& record = records[i];
+            const bool rational = (record.flags & RATIONAL) != 0;
+            const int nDirections = record.type == RECORD_SURFACE ? 2 : 1;
+            for (int dir = 0; dir < nDirections; ++dir) {
+                if (record.degree[dir] < 1 || record.nKnots[dir] < 2 || record.nPoles[dir] < 2) {
+                    Invalid("invalid degree or number of knots or poles");
+                }
+            }
+
+            if (record.type == RECORD_CURVE) {
+                BSplineCurveView curve;
+                curve.degree = record.degree[0];
+                curve.periodic = (record.flags & U_PERIODIC) != 0;
+                curve.rational = rational;
+                curve.n_knots = static_cast<size_t>(record.nKnots[0]);
+                curve.knots = Array<double>(record.knotsOffset[0], curve.n_knots);
+                curve.multiplicities = Array<std::int32_t>(record.multsOffset[0], curve.n_knots);
+                curve.n_poles = static_cast<size_t>(record.nPoles[0]);
+                curve.poles = Array<double>(record.polesOffset, 3 * curve.n_poles);
+                curve.weights = rational ? Array<double>(record.weightsOffset, curve.n_poles) : nullptr;
+
+                if (record.role == ROLE_PROFILE) {
+                    profiles.push_back(curve);
+                }
+                else if (record.role == ROLE_GUIDE) {
+                    guides.push_back(curve);
+                }
+                else {
+                    Invalid("curve without role");
+                }
+            }
+            else if (record.type == RECORD_SURFACE) {
+                BSplineSurfaceView surface;
+                surface.u_degree = record.degree[0];
+                surface.v_degree = record.degree[1];
+                surface.u_periodic = (record.flags & U_PERIODIC) != 0;
+                surface.v_periodic = (record.flags & V_PERIODIC) != 0;
+                surface.rational = rational;
+                surface.n_u_knots = static_cast<size_t>(record.nKnots[0]);
+                surface.n_v_knots = static_cast<size_t>(record.nKnots[1]);
+                surface.u_knots = Array<double>(record.knotsOffset[0], surface.n_u_knots);
+                surface.v_knots = Array<double>(record.knotsOffset[1], surface.n_v_knots);
+                surface.u_multiplicities = Array<std::int32_t>(record.multsOffset[0], surface.n_u_knots);
+                surface.v_multiplicities = Array<std::int32_t>(record.multsOffset[1], surface.n_v_knots);
+                surface.n_u_poles = static_cast<size_t>(record.nPoles[0]);
+                surface.n_v_poles = static_cast<size_t>(record.nPoles[1]);
+                const size_t nPoles = surface.n_u_poles * surface.n_v_poles;
+                surface.poles = Array<double>(record.polesOffset, 3 * nPoles);
+                surface.weights = rational ? Array<double>(record.weightsOffset, nPoles) : nullptr;
+                surfaces.push_back(surface);
+            }
+            else {
+                Invalid("unknown record type " + std::to_string(record.type));
+            }
+        }
+    }
+
+    std::string path;
+    const char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+    std::uint32_t version = 0;
+    std::vector<BSplineCurveView> profiles;
+    std::vector<BSplineCurveView> guides;
+    std::vector<BSplineSurfaceView> surfaces;
+};
+
+MappedGeometryFile::MappedGeometryFile(const std::string& path)
+    : m_impl(std::make_unique<Impl>(path))
+{
+}
+
+MappedGeometryFile::~MappedGeometryFile() = default;
+
+std::uint32_t MappedGeometryFile::version() const
+{
+    return m_impl->version;
+}
+
+const std::vector<BSplineCurveView>& MappedGeometryFile::profiles() const
+{
+    return m_impl->profiles;
+}
+
+const std::vector<BSplineCurveView>& MappedGeometryFile::guides() const
+{
+    return m_impl->guides;
+}
+
+const std::vector<BSplineSurfaceView>& MappedGeometryFile::surfaces() const
+{
+    return m_impl->surfaces;
+}
+
+std::uint32_t binary_format_version()
+{
+    return kVersion;
+}
+
+Handle(Geom_BSplineCurve) to_bspline_curve(const BSplineCurveView& view)
+{
+    if (view.n_knots < 2 || view.n_poles < 2) {
+        throw std::runtime_error("Invalid B-spline curve: too few knots or poles");
+    }
+
+    const int nKnots = static_cast<int>(view.n_knots);
+    const int nPoles = static_cast<int>(view.n_poles);
+
+    TColStd_Array1OfReal knots(1, nKnots);
+    TColStd_Array1OfInteger mults(1, nKnots);
+    for (int i = 0; i < nKnots; ++i) {
+        knots.SetValue(i + 1, view.knots[i]);
+        mults.SetValue(i + 1, view.multiplicities[i]);
+    }
+
+    TColgp_Array1OfPnt poles(1, nPoles);
+    for (int i = 0; i < nPoles; ++i) {
+        poles.SetValue(i + 1, gp_Pnt(view.poles[3 * i], view.poles[3 * i + 1], view.poles[3 * i + 2]));
+    }
+
+    try {
+        if (!view.weights) {
+            return new Geom_BSplineCurve(poles, knots, mults, view.degree, view.periodic);
+        }
+
+        TColStd_Array1OfReal weights(1, nPoles);
+        for (int i = 0; i < nPoles; ++i) {
+            weights.SetValue(i + 1, view.weights[i]);
+        }
+        return new Geom_BSplineCurve(poles, weights, knots, mults, view.degree, view.periodic);
+    }
+    catch (Standard_Failure& err) {
+        throw std::runtime_error(std::string("Invalid B-spline curve: ") + err.GetMessageString());
+    }
+}
+
+Handle(Geom_BSplineSurface) to_bspline_surface(const BSplineSurfaceView& view)
+{
+    if (view.n_u_knots < 2 || view.n_v_knots < 2 || view.n_u_poles < 2 || view.n_v_poles < 2) {
+        throw std::runtime_error("Invalid B-spline surface: too few knots or poles");
+    }
+
+    const int nUKnots = static_cast<int>(view.n_u_knots);
+    const int nVKnots = static_cast<int>(view.n_v_knots);
+    const int nUPoles = static_cast<int>(view.n_u_poles);
+    const int nVPoles = static_cast<int>(view.n_v_poles);
+
+    TColStd_Array1OfReal uKnots(1, nUKnots), vKnots(1, nVKnots);
+    TColStd_Array1OfInteger uMults(1, nUKnots), vMults(1, nVKnots);
+    for (int i = 0; i < nUKnots; ++i) {
+        uKnots.SetValue(i + 1, view.u_knots[i]);
+        uMults.SetValue(i + 1, view.u_multiplicities[i]);
+    }
+    for (int i = 0; i < nVKnots; ++i) {
+        vKnots.SetValue(i + 1, view.v_knots[i]);
+        vMults.SetValue(i + 1, view.v_multiplicities[i]);
+    }
+
+    TColgp_Array2OfPnt poles(1, nUPoles, 1, nVPoles);
+    for (int i = 0; i < nUPoles; ++i) {
+        for (int j = 0; j < nVPoles; ++j) {
+            const double* p = view.poles + 3 * (static_cast<size_t>(i) * nVPoles + j);
+            poles.SetValue(i + 1, j + 1, gp_Pnt(p[0], p[1], p[2]));
+        }
+    }
+
+    try {
+        if (!view.weights) {
+            return new Geom_BSplineSurface(poles, uKnots, vKnots, uMults, vMults, view.u_degree, view.v_degree,
+                                           view.u_periodic, view.v_periodic);
+        }
+
+        TColStd_Array2OfReal weights(1, nUPoles, 1, nVPoles);
+        for (int i = 0; i < nUPoles; ++i) {
+            for (int j = 0; j < nVPoles; ++j) {
+                weights.SetValue(i + 1, j + 1, view.weights[static_cast<size_t>(i) * nVPoles + j]);
+            }
+        }
+        return new Geom_BSplineSurface(poles, weights, uKnots, vKnots, uMults, vMults, view.u_degree, view.v_degree,
+                                       view.u_periodic, view.v_periodic);
+    }
+    catch (Standard_Failure& err) {
+        throw std::runtime_error(std::string("Invalid B-spline surface: ") + err.GetMessageString());
+    }
+}
+
+std::vector<Handle(Geom_BSplineCurve)> read_brep_curves(const std::string& path)
+{
+    TopoDS_Shape shape;
+    BRep_Builder builder;
+    if (!BRepTools::Read(shape, path.c_str(), builder)) {
+        throw std::runtime_error("Cannot read BRep file " + path);
+    }
+
+    std::vector<Handle(Geom_BSplineCurve)> curves;
+    try {
+        for (TopExp_Explorer explorer(shape, TopAbs_EDGE); explorer.More(); explorer.Next()) {
+            const TopoDS_Edge& edge = TopoDS::Edge(explorer.Current());
+            double first = 0.;
+            double last = 1.;
+            Handle(Geom_Curve) curve = BRep_Tool::Curve(edge, first, last);
+            if (curve.IsNull()) {
+                continue;
+            }
+
+            // edges may only use a part of their curve
+            if (std::abs(first - curve->FirstParameter()) > Precision::PConfusion() ||
+                std::abs(last - curve->LastParameter()) > Precision::PConfusion()) {
+                curve = new Geom_TrimmedCurve(curve, first, last);
+            }
+            curves.push_back(GeomConvert::CurveToBSplineCurve(curve));
+        }
+    }
+    catch (Standard_Failure& err) {
+        throw std::runtime_error("Cannot convert the curves of " + path + ": " + err.GetMessageString());
+    }
+
+    return curves;
+}
+
+CurveNetwork read_curve_network(const std::string& profilesPath, const std::string& guidesPath)
+{
+    auto guides = std::async(std::launch::async, [&guidesPath]() {
+        return read_brep_curves(guidesPath);
+    });
+
+    CurveNetwork network;
+    network.profiles = read_brep_curves(profilesPath);
+    network.guides = guides.get();
+    return network;
+}
+
+void write_binary_curve_network(const std::string& path,
+                                const std::vector<Handle(Geom_BSplineCurve)>& profiles,
+                                const std::vector<Handle(Geom_BSplineCurve)>& guides)
+{
+    BinaryGeometryWriter writer;
+    for (const Handle(Geom_BSplineCurve)& curve : profiles) {
+        writer.AddCurve(curve, ROLE_PROFILE);
+    }
+    for (const Handle(Geom_BSplineCurve)& curve : guides) {
+        writer.AddCurve(curve, ROLE_GUIDE);
+    }
+    writer.Write(path);
+}
+
+CurveNetwork read_binary_curve_network(const std::string& path)
+{
+    MappedGeometryFile file(path);
+
+    CurveNetwork network;
+    for (const BSplineCurveView& view : file.profiles()) {
+        network.profiles.push_back(to_bspline_curve(view));
+    }
+    for (const BSplineCurveView& view : file.guides()) {
+        network.guides.push_back(to_bspline_curve(view));
+    }
+    return network;
+}
+
+void write_binary_surface(const std::string& path, const Handle(Geom_BSplineSurface)& surface)
+{
+    BinaryGeometryWriter writer;
+    writer.AddSurface(surface);
+    writer.Write(path);
+}
+
+Handle(Geom_BSplineSurface) read_binary_surface(const std::string& path)
+{
+    MappedGeometryFile file(path);
+    if (file.surfaces().empty()) {
+        throw std::runtime_error("The binary geometry file " + path + " contains no surface");
+    }
+    return to_bspline_surface(file.surfaces().front());
+}
+
+} // namespace occ_gordon
@@ -0,0 +1,187 @@
+#pragma once
+
+/**
+ * SPDX-License-Identifier: Apache-2.0
+ * SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+ */
+
+#include <occ_gordon/exports.h>
+#include <occ_gordon/occ_gordon.h>
+
+#include <Geom_BSplineCurve.hxx>
+#include <Geom_BSplineSurface.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ *
+ * Reading and writing of curve networks and surfaces in the BRep and the binary format.
+ *
+ * __Binary format:__ The binary files store B-spline curves and surfaces as contiguous arrays,
+ * such that they can be used directly from a memory mapped file (see MappedGeometryFile).
+ * All numbers are stored in the byte order of the writing machine, which is recorded in the header.
+ * Files with a foreign byte order are rejected. A file consists of
+ *
+ *  - a header of 64 bytes: the magic "OCCGBIN\0", the format version (uint32),
+ *    the byte order mark 0x01020304 (uint32), the number of records (uint64),
+ *    the offset of the record table (uint64) and the file size (uint64),
+ *  - a table with one record of 96 bytes per curve or surface. A record holds the type
+ *    (1 = curve, 2 = surface), the role of a curve (1 = profile, 2 = guide), the periodicity
+ *    and rationality flags, degrees, number of knots and poles and the offsets of the arrays,
+ *  - the arrays. Knots and weights are doubles, multiplicities int32 values, poles are
+ *    stored as x, y, z doubles. The poles of surfaces are ordered by u index first, i.e.
+ *    pole (i, j) starts at index 3 * (i * n_v_poles + j). All arrays are aligned to 8 bytes.
+ */
+
+namespace occ_gordon
+{
+
+/**
+ * @brief Reads a curve network from two BRep files
+ *
+ * The files are read in parallel. The curves of all edges are trimmed to the edge
+ * parameter range and converted into B-splines.
+ *
+ * @throws std::runtime_error, if a file cannot be read or contains a curve, that cannot be converted
+ *
+ * @param profilesPath BRep file with the profiles
+ * @param guidesPath BRep file with the guides
+ */
+OCC_GORDON_EXPORT CurveNetwork read_curve_network(const std::string& profilesPath, const std::string& guidesPath);
+
+/**
+ * @brief Reads the curves of all edges of a BRep file
+ *
+ * @see read_curve_network
+ * @throws std::runtime_error, if the file cannot be read
+ */
+OCC_GORDON_EXPORT std::vector<Handle(Geom_BSplineCurve)> read_brep_curves(const std::string& path);
+
+/**
+ * @brief Read-only view of a B-spline curve inside a MappedGeometryFile
+ *
+ * The pointers refer to the mapped file and are valid as long as the file is open.
+ */
+struct BSplineCurveView
+{
+    int degree = 0;
+    bool periodic = false;
+    bool rational = false;
+
+    size_t n_knots = 0;
+    const double* knots = nullptr;
+    const std::int32_t* multiplicities = nullptr;
+
+    /// Poles as n_poles consecutive x, y, z triples
+    size_t n_poles = 0;
+    const double* poles = nullptr;
+
+    /// Weights of the poles, nullptr if the curve is not rational
+    const double* weights = nullptr;
+};
+
+/**
+ * @brief Read-only view of a B-spline surface inside a MappedGeometryFile
+ *
+ * The pointers refer to the mapped file and are valid as long as the file is open.
+ */
+struct BSplineSurfaceView
+{
+    int u_degree = 0;
+    int v_degree = 0;
+    bool u_periodic = false;
+    bool v_periodic = false;
+    bool rational = false;
+
+    size_t n_u_knots = 0;
+    const double* u_knots = nullptr;
+    const std::int32_t* u_multiplicities = nullptr;
+
+    size_t n_v_knots = 0;
+    const double* v_knots = nullptr;
+    const std::int32_t* v_multiplicities = nullptr;
+
+    /// Poles as x, y, z triples. Pole (i, j) starts at index 3 * (i * n_v_poles + j)
+    size_t n_u_poles = 0;
+    size_t n_v_poles = 0;
+    const double* poles = nullptr;
+
+    /// Weights of the poles in the same order, nullptr if the surface is not rational
+    const double* weights = nullptr;
+};
+
+/**
+ * @brief A binary geometry file mapped into memory
+ *
+ * The curves and surfaces are accessed without copying the file contents.
+ * The file is validated when opened, all views point into the mapped file.
+ */
+class OCC_GORDON_EXPORT MappedGeometryFile
+{
+public:
+    /// @throws std::runtime_error, if the file cannot be mapped or is not a valid binary geometry file
+    explicit MappedGeometryFile(const std::string& path);
+    ~MappedGeometryFile();
+
+    MappedGeometryFile(const MappedGeometryFile&) = delete;
+    MappedGeometryFile& operator=(const MappedGeometryFile&) = delete;
+
+    /// Format version of the file
+    std::uint32_t version() const;
+
+    const std::vector<BSplineCurveView>& profiles() const;
+    const std::vector<BSplineCurveView>& guides() const;
+    const std::vector<BSplineSurfaceView>& surfaces() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/// Current version of the binary format
+OCC_GORDON_EXPORT std::uint32_t binary_format_version();
+
+/**
+ * @brief Creates an OpenCASCADE curve from a view
+ * @throws std::runtime_error, if the view does not describe a valid B-spline
+ */
+OCC_GORDON_EXPORT Handle(Geom_BSplineCurve) to_bspline_curve(const BSplineCurveView& view);
+
+/**
+ * @brief Creates an OpenCASCADE surface from a view
+ * @throws std::runtime_error, if the view does not describe a valid B-spline
+ */
+OCC_GORDON_EXPORT Handle(Geom_BSplineSurface) to_bspline_surface(const BSplineSurfaceView& view);
+
+/**
+ * @brief Writes the curve network to a binary file
+ * @throws std::runtime_error, if the file cannot be written
+ */
+OCC_GORDON_EXPORT void write_binary_curve_network(const std::string& path,
+                                                  const std::vector<Handle(Geom_BSplineCurve)>& profiles,
+                                                  const std::vector<Handle(Geom_BSplineCurve)>& guides);
+
+/**
+ * @brief Reads a curve network from a binary file
+ * @throws std::runtime_error, if the file cannot be read
+ */
+OCC_GORDON_EXPORT CurveNetwork read_binary_curve_network(const std::string& path);
+
+/**
+ * @brief Writes the surface to a binary file
+ * @throws std::runtime_error, if the file cannot be written
+ */
+OCC_GORDON_EXPORT void write_binary_surface(const std::string& path, const Handle(Geom_BSplineSurface)& surface);
+
+/**
+ * @brief Reads the first surface of a binary file
+ * @throws std::runtime_error, if the file cannot be read or contains no surface
+ */
+OCC_GORDON_EXPORT Handle(Geom_BSplineSurface) read_binary_surface(const std::string& path);
+
+} // namespace occ_gordon
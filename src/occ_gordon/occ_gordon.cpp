@@ -17,6 +17,186 @@
 #include "internal/Error.h"
 
 #include "internal/BSplineAlgorithms.h"
+#include "internal/CurveNetworkClassifier.h"
+#include "internal/Parallel.h"
+#include "internal/SurfaceCache.h"
+#include "internal/TaskMonitor.h"
+
+#ifndef OCC_GORDON_VERSION
+#define OCC_GORDON_VERSION "unknown"
+#endif
+
+namespace
+{
+
+void configure(occ_gordon_internal::InterpolateCurveNetwork& interpolator, const occ_gordon::InterpolateCurveNetworkOptions& options)
+{
+    interpolator.SetControlPointLimits(options.min_control_points, options.max_control_points);
+    interpolator.SetMinReparametrizationSamples(options.min_reparametrization_samples);
+    interpolator.SetParameterOptimizationIterations(options.parameter_optimization_iterations);
+    interpolator.SetReparametrizationTolerance(options.reparametrization_tolerance);
+    interpolator.SetReparametrizationMode(options.exact_reparametrization
+                                              ? occ_gordon_internal::ReparametrizationMode::ExactComposition
+                                              : occ_gordon_internal::ReparametrizationMode::Approximation);
+    interpolator.SetKnotRemovalTolerance(options.knot_removal_tolerance);
+
+    occ_gordon_internal::IntersectBSplinesOptions intersectionOptions;
+    intersectionOptions.maxFlatness = options.intersection_flatness;
+    intersectionOptions.optimizerTolerance = options.intersection_optimizer_tolerance;
+    intersectionOptions.optimizerMaxIterations = options.intersection_optimizer_iterations;
+    interpolator.SetIntersectionOptions(intersectionOptions);
+
+    interpolator.SetNumberOfThreads(options.threads);
+
+    if (options.block_size > 0) {
+        interpolator.SetBlockDecomposition(options.block_size, options.block_overlap);
+    }
+}
+
+std::vector<occ_gordon::CurveDeviation> toCurveDeviations(const std::vector<occ_gordon_internal::CurveDeviation>& deviations)
+{
+    std::vector<occ_gordon::CurveDeviation> result;
+    result.reserve(deviations.size());
+    for (const occ_gordon_internal::CurveDeviation& deviation : deviations) {
+        occ_gordon::CurveDeviation item;
+        item.index = deviation.inputIndex;
+        item.parameter = deviation.parameter;
+        item.max_deviation = deviation.maxDeviation;
+        item.rms_deviation = deviation.rmsDeviation;
+        result.push_back(item);
+    }
+    return result;
+}
+
+// Hashes everything, that influences the resulting surface
+occ_gordon_internal::CacheKey cacheKey(const std::vector<Handle (Geom_BSplineCurve)> &ucurves,
+                                       const std::vector<Handle (Geom_BSplineCurve)> &vcurves,
+                                       double tolerance,
+                                       const occ_gordon::InterpolateCurveNetworkOptions& options)
+{
+    occ_gordon_internal::CacheKey key;
+    key.Add(std::string("occ_gordon " OCC_GORDON_VERSION));
+
+    key.Add(static_cast<std::uint64_t>(ucurves.size()));
+    for (const Handle(Geom_BSplineCurve)& curve : ucurves) {
+        key.Add(curve);
+    }
+    key.Add(static_cast<std::uint64_t>(vcurves.size()));
+    for (const Handle(Geom_BSplineCurve)& curve : vcurves) {
+        key.Add(curve);
+    }
+    key.Add(tolerance);
+
+    // the number of threads and the cache settings don't change the result
+    key.Add(static_cast<std::uint64_t>(options.min_control_points));
+    key.Add(static_cast<std::uint64_t>(options.max_control_points));
+    key.Add(static_cast<std::uint64_t>(options.min_reparametrization_samples));
+    key.Add(options.parameter_optimization_iterations);
+    key.Add(options.reparametrization_tolerance);
+    key.Add(options.exact_reparametrization);
+    key.Add(options.knot_removal_tolerance);
+    key.Add(options.intersection_flatness);
+    key.Add(options.intersection_optimizer_tolerance);
+    key.Add(options.intersection_optimizer_iterations);
+    key.Add(static_cast<std::uint64_t>(options.block_size));
+    key.Add(static_cast<std::uint64_t>(options.block_size > 0 ? options.block_overlap : 0));
+
+    return key;
+}
+
+Handle(Geom_BSplineSurface) interpolate(const std::vector<Handle (Geom_BSplineCurve)> &ucurves,
+                                        const std::vector<Handle (Geom_BSplineCurve)> &vcurves,
+                                        double tolerance,
+                                        const occ_gordon::InterpolateCurveNetworkOptions& options,
+                                        occ_gordon_internal::TaskMonitor* monitor,
+                                        occ_gordon::CurveNetworkDeviations* deviations = nullptr,
+                                        occ_gordon::SurfacePatches* patches = nullptr)
+{
+    try {
+        // only the surface is stored. The deviations require the reparametrization and the patches are not cached
+        std::unique_ptr<occ_gordon_internal::SurfaceCache> cache;
+        occ_gordon_internal::CacheKey key;
+        if (!options.cache_directory.empty() && !deviations && !patches) {
+            cache = std::make_unique<occ_gordon_internal::SurfaceCache>(options.cache_directory, options.cache_max_bytes);
+            key = cacheKey(ucurves, vcurves, tolerance, options);
+
+            occ_gordon_internal::CacheEntry entry;
+            if (cache->Load(key, entry)) {
+                if (monitor) {
+                    monitor->Finish();
+                }
+                return entry.surface;
+            }
+        }
+
+        occ_gordon_internal::InterpolateCurveNetwork interpolator(ucurves, vcurves, tolerance);
+        configure(interpolator, options);
+        interpolator.SetTaskMonitor(monitor);
+
+        Handle(Geom_BSplineSurface) surface = interpolator.Surface();
+
+        if (deviations) {
+            deviations->profiles = toCurveDeviations(interpolator.DeviationsProfiles(options.deviation_samples));
+            deviations->guides = toCurveDeviations(interpolator.DeviationsGuides(options.deviation_samples));
+        }
+
+        if (patches) {
+            patches->n_u = interpolator.NumberOfPatchesU();
+            patches->n_v = interpolator.NumberOfPatchesV();
+            patches->patches = interpolator.Patches();
+            patches->continuity_u = interpolator.SeamContinuityU();
+            patches->continuity_v = interpolator.SeamContinuityV();
+        }
+
+        if (cache) {
+            occ_gordon_internal::CacheEntry entry;
+            entry.surface = surface;
+            cache->Store(key, entry);
+        }
+
+        return surface;
+    }
+    catch(occ_gordon_internal::error& err) {
+        if (err.get_code() == occ_gordon_internal::CANCELLED) {
+            throw occ_gordon::cancelled_error(err.what());
+        }
+        throw std::runtime_error(std::string("Error creating gordon surface: ") + err.what());
+    }
+}
+
+occ_gordon::CurveNetwork classify(const std::vector<Handle(Geom_Curve)>& curves, double tolerance,
+                                  const occ_gordon_internal::IntersectBSplinesOptions& intersectionOptions)
+{
+    try {
+        std::vector<Handle(Geom_BSplineCurve)> bsplines = occ_gordon_internal::BSplineAlgorithms::toBSplines(curves);
+        occ_gordon_internal::CurveNetworkClassifier classifier(bsplines, tolerance, intersectionOptions);
+        classifier.Perform();
+
+        occ_gordon::CurveNetwork network;
+        for (size_t idx : classifier.ProfileIndices()) {
+            network.profiles.push_back(bsplines[idx]);
+        }
+        for (size_t idx : classifier.GuideIndices()) {
+            network.guides.push_back(bsplines[idx]);
+        }
+        return network;
+    }
+    catch(occ_gordon_internal::error& err) {
+        throw std::runtime_error(std::string("Error classifying the curve network: ") + err.what());
+    }
+}
+
+std::vector<Handle(Geom_BSplineCurve)> copyCurves(const std::vector<Handle(Geom_BSplineCurve)>& curves)
+{
+    std::vector<Handle(Geom_BSplineCurve)> copies;
+    copies.reserve(curves.size());
+    for (const Handle(Geom_BSplineCurve)& curve : curves) {
+        copies.push_back(curve.IsNull() ? curve : Handle(Geom_BSplineCurve)::DownCast(curve->Copy()));
+    }
+    return copies;
+}
+
+} // namespace
 
 namespace occ_gordon
 {
@@ -24,10 +204,25 @@ namespace occ_gordon
 Handle(Geom_BSplineSurface) interpolate_curve_network(const std::vector<Handle (Geom_Curve)>& ucurves,
                                                       const std::vector<Handle (Geom_Curve)>& vcurves,
                                                       double tolerance)
+{
+    return interpolate_curve_network(ucurves, vcurves, tolerance, InterpolateCurveNetworkOptions());
+}
+
+Handle(Geom_BSplineSurface) interpolate_curve_network(const std::vector<Handle (Geom_BSplineCurve)> &ucurves,
+                                                      const std::vector<Handle (Geom_BSplineCurve)> &vcurves,
+                                                      double tolerance)
+{
+    return interpolate_curve_network(ucurves, vcurves, tolerance, InterpolateCurveNetworkOptions());
+}
+
+Handle(Geom_BSplineSurface) interpolate_curve_network(const std::vector<Handle (Geom_Curve)>& ucurves,
+                                                      const std::vector<Handle (Geom_Curve)>& vcurves,
+                                                      double tolerance,
+                                                      const InterpolateCurveNetworkOptions& options)
 {
     try {
         return interpolate_curve_network(occ_gordon_internal::BSplineAlgorithms::toBSplines(ucurves),
-                                         occ_gordon_internal::BSplineAlgorithms::toBSplines(vcurves), tolerance);
+                                         occ_gordon_internal::BSplineAlgorithms::toBSplines(vcurves), tolerance, options);
     }
     catch(occ_gordon_internal::error& err) {
         throw std::runtime_error(std::string("Error creating gordon surface: ") + err.what());
@@ -36,15 +231,130 @@ Handle(Geom_BSplineSurface) interpolate_curve_network(const std::vector<Handle (
 
 Handle(Geom_BSplineSurface) interpolate_curve_network(const std::vector<Handle (Geom_BSplineCurve)> &ucurves,
                                                       const std::vector<Handle (Geom_BSplineCurve)> &vcurves,
-                                                      double tolerance)
+                                                      double tolerance,
+                                                      const InterpolateCurveNetworkOptions& options)
+{
+    return interpolate(ucurves, vcurves, tolerance, options, nullptr);
+}
+
+Handle(Geom_BSplineSurface) interpolate_curve_network(const std::vector<Handle (Geom_BSplineCurve)> &ucurves,
+                                                      const std::vector<Handle (Geom_BSplineCurve)> &vcurves,
+                                                      double tolerance,
+                                                      const InterpolateCurveNetworkOptions& options,
+                                                      CurveNetworkDeviations& deviations)
+{
+    return interpolate(ucurves, vcurves, tolerance, options, nullptr, &deviations);
+}
+
+Handle(Geom_BSplineSurface) interpolate_curve_network(const std::vector<Handle (Geom_Curve)>& ucurves,
+                                                      const std::vector<Handle (Geom_Curve)>& vcurves,
+                                                      double tolerance,
+                                                      const InterpolateCurveNetworkOptions& options,
+                                                      CurveNetworkDeviations& deviations)
 {
     try {
-        occ_gordon_internal::InterpolateCurveNetwork interpolator(ucurves, vcurves, tolerance);
-        return interpolator.Surface();
+        return interpolate_curve_network(occ_gordon_internal::BSplineAlgorithms::toBSplines(ucurves),
+                                         occ_gordon_internal::BSplineAlgorithms::toBSplines(vcurves), tolerance, options,
+                                         deviations);
     }
     catch(occ_gordon_internal::error& err) {
         throw std::runtime_error(std::string("Error creating gordon surface: ") + err.what());
     }
 }
 
+SurfacePatches interpolate_curve_network_patches(const std::vector<Handle (Geom_BSplineCurve)> &ucurves,
+                                                 const std::vector<Handle (Geom_BSplineCurve)> &vcurves,
+                                                 double tolerance,
+                                                 const InterpolateCurveNetworkOptions& options)
+{
+    SurfacePatches patches;
+    interpolate(ucurves, vcurves, tolerance, options, nullptr, nullptr, &patches);
+    return patches;
+}
+
+SurfacePatches interpolate_curve_network_patches(const std::vector<Handle (Geom_Curve)>& ucurves,
+                                                 const std::vector<Handle (Geom_Curve)>& vcurves,
+                                                 double tolerance,
+                                                 const InterpolateCurveNetworkOptions& options)
+{
+    try {
+        return interpolate_curve_network_patches(occ_gordon_internal::BSplineAlgorithms::toBSplines(ucurves),
+                                                 occ_gordon_internal::BSplineAlgorithms::toBSplines(vcurves), tolerance, options);
+    }
+    catch(occ_gordon_internal::error& err) {
+        throw std::runtime_error(std::string("Error creating gordon surface: ") + err.what());
+    }
+}
+
+Handle(Geom_BSplineSurface) interpolate_curve_network(const std::vector<Handle (Geom_BSplineCurve)> &ucurves,
+                                                      const std::vector<Handle (Geom_BSplineCurve)> &vcurves,
+                                                      double tolerance,
+                                                      const InterpolateCurveNetworkOptions& options,
+                                                      ProgressCallback progress,
+                                                      CancellationToken cancellation)
+{
+    occ_gordon_internal::TaskMonitor monitor(progress, [cancellation]() {
+        return cancellation.is_cancelled();
+    });
+    return interpolate(ucurves, vcurves, tolerance, options, &monitor);
+}
+
+std::future<Handle(Geom_BSplineSurface)> interpolate_curve_network_async(const std::vector<Handle(Geom_Curve)>& ucurves,
+                                                                         const std::vector<Handle(Geom_Curve)>& vcurves,
+                                                                         double tolerance,
+                                                                         const InterpolateCurveNetworkOptions& options,
+                                                                         ProgressCallback progress,
+                                                                         CancellationToken cancellation)
+{
+    try {
+        return interpolate_curve_network_async(occ_gordon_internal::BSplineAlgorithms::toBSplines(ucurves),
+                                               occ_gordon_internal::BSplineAlgorithms::toBSplines(vcurves),
+                                               tolerance, options, std::move(progress), std::move(cancellation));
+    }
+    catch(occ_gordon_internal::error& err) {
+        throw std::runtime_error(std::string("Error creating gordon surface: ") + err.what());
+    }
+}
+
+std::future<Handle(Geom_BSplineSurface)> interpolate_curve_network_async(const std::vector<Handle(Geom_BSplineCurve)>& ucurves,
+                                                                         const std::vector<Handle(Geom_BSplineCurve)>& vcurves,
+                                                                         double tolerance,
+                                                                         const InterpolateCurveNetworkOptions& options,
+                                                                         ProgressCallback progress,
+                                                                         CancellationToken cancellation)
+{
+    // the caller may modify its curves, while the surface is computed
+    std::vector<Handle(Geom_BSplineCurve)> ucopies = copyCurves(ucurves);
+    std::vector<Handle(Geom_BSplineCurve)> vcopies = copyCurves(vcurves);
+
+    return std::async(std::launch::async, [ucopies, vcopies, tolerance, options, progress, cancellation]() {
+        occ_gordon_internal::TaskMonitor monitor(progress, [cancellation]() {
+            return cancellation.is_cancelled();
+        });
+        return interpolate(ucopies, vcopies, tolerance, options, &monitor);
+    });
+}
+
+CurveNetwork classify_curve_network(const std::vector<Handle(Geom_Curve)>& curves, double tolerance)
+{
+    return classify(curves, tolerance, occ_gordon_internal::IntersectBSplinesOptions());
+}
+
+Handle(Geom_BSplineSurface) interpolate_mixed_curve_network(const std::vector<Handle(Geom_Curve)>& curves,
+                                                            double tolerance,
+                                                            const InterpolateCurveNetworkOptions& options)
+{
+    occ_gordon_internal::IntersectBSplinesOptions intersectionOptions;
+    intersectionOptions.maxFlatness = options.intersection_flatness;
+    intersectionOptions.optimizerTolerance = options.intersection_optimizer_tolerance;
+    intersectionOptions.optimizerMaxIterations = options.intersection_optimizer_iterations;
+
+    CurveNetwork network;
+    {
+        occ_gordon_internal::ScopedThreadLimit threadLimit(options.threads);
+        network = classify(curves, tolerance, intersectionOptions);
+    }
+    return interpolate_curve_network(network.profiles, network.guides, tolerance, options);
+}
+
 } // end namespace occ_gordon
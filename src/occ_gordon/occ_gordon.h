@@ -11,11 +11,229 @@
 #include <Geom_Curve.hxx>
 #include <Geom_BSplineCurve.hxx>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
+/**
+ * @file
+ *
+ * __Thread safety:__ All functions of occ_gordon are reentrant and can be called
+ * concurrently from multiple threads, also with shared input curves. The input curves
+ * are only read and never modified. The library keeps no global state, apart from the
+ * thread pool of OpenCASCADE, which is shared by all calls.
+ */
+
 namespace occ_gordon
 {
 
+/**
+ * @brief Settings of the curve network interpolation
+ *
+ * The defaults reproduce the results of interpolate_curve_network without options.
+ * Most settings trade computation time against the accuracy of the surface.
+ */
+struct InterpolateCurveNetworkOptions
+{
+    /// Minimum number of control points of the reparametrized curves
+    size_t min_control_points = 10;
+
+    /// Maximum number of control points of the reparametrized curves
+    size_t max_control_points = 80;
+
+    /// Minimum number of points sampled from each curve for the reparametrization
+    size_t min_reparametrization_samples = 101;
+
+    /// Number of iterations of the parameter optimization in the reparametrization
+    int parameter_optimization_iterations = 1;
+
+    /**
+     * If positive, the number of control points of the reparametrized curves is chosen
+     * adaptively, such that the curves are approximated within this tolerance.
+     * The search is bounded by min_control_points and max_control_points.
+     */
+    double reparametrization_tolerance = 0.;
+
+    /**
+     * Reparametrize the curves exactly by composition instead of approximating them.
+     * This keeps the curve geometry up to the knot reduction at the intersections,
+     * which is done within the tolerance, but creates more knots.
+     * It cannot be combined with block_size.
+     */
+    bool exact_reparametrization = false;
+
+    /// If positive, knots are removed from the final surface within this tolerance
+    double knot_removal_tolerance = 0.;
+
+    /// Curves are subdivided for the intersection, until their control polygon is flatter than this ratio
+    double intersection_flatness = 1.0005;
+
+    /// Tolerance of the local optimization of the curve intersections
+    double intersection_optimizer_tolerance = 1e-10;
+
+    /// Maximum number of iterations of the local optimization of the curve intersections
+    int intersection_optimizer_iterations = 200;
+
+    /// Maximum number of threads. A value <= 0 uses all available threads
+    int threads = 0;
+
+    /**
+     * If not empty, the surfaces are cached in this directory. Interpolating the same curves
+     * with the same tolerance and options again reads the surface instead of computing it.
+     * The directory can be shared by several processes.
+     */
+    std::string cache_directory;
+
+    /// Maximum total size of the cache directory in bytes. The least recently used surfaces are removed first. 0 means unlimited
+    size_t cache_max_bytes = 512 * 1024 * 1024;
+
+    /// Number of points per curve, at which the deviations of the input curves from the surface are computed
+    size_t deviation_samples = 101;
+
+    /**
+     * If positive, networks with more profiles or guides are split into overlapping blocks of at most
+     * this number of curves per direction. The blocks are interpolated in parallel and their patches
+     * are joined with C1 continuity, or C0 where the C1 join would move the surface further than the
+     * tolerance from the curves. The continuity of each seam is reported by
+     * interpolate_curve_network_patches in SurfacePatches. This is much faster for very large networks, but the surface
+     * differs slightly from the surface of the whole network. Only the reparametrization and the
+     * gordon surfaces are decomposed, the intersections and the sorting of the curves are still
+     * computed for the whole network. Closed networks and exact_reparametrization are not supported.
+     */
+    size_t block_size = 0;
+
+    /// Number of curves, by which each block is extended beyond its patch on each side (at least 1)
+    size_t block_overlap = 2;
+};
+
+/// Deviation of an input curve from the corresponding iso-curve of the interpolation surface
+struct CurveDeviation
+{
+    /// Index of the curve in the input list
+    size_t index = 0;
+
+    /// Parameter of the iso-curve, i.e. v for profiles and u for guides
+    double parameter = 0.;
+
+    /// Maximum distance of the sampled points
+    double max_deviation = 0.;
+
+    /// Root mean square of the distances of the sampled points
+    double rms_deviation = 0.;
+};
+
+/**
+ * @brief Deviations of all curves of a network from the interpolation surface
+ *
+ * The curves are ordered as the iso-curves of the surface. For closed networks,
+ * the first curve is repeated at the end.
+ */
+struct CurveNetworkDeviations
+{
+    std::vector<CurveDeviation> profiles;
+    std::vector<CurveDeviation> guides;
+
+    /// Maximum deviation of all profiles and guides
+    double max_deviation() const
+    {
+        double result = 0.;
+        for (const CurveDeviation& deviation : profiles) {
+            result = std::max(result, deviation.max_deviation);
+        }
+        for (const CurveDeviation& deviation : guides) {
+            result = std::max(result, deviation.max_deviation);
+        }
+        return result;
+    }
+};
+
+/**
+ * @brief Patches of a block decomposed curve network interpolation
+ *
+ * @see InterpolateCurveNetworkOptions::block_size
+ */
+struct SurfacePatches
+{
+    /// Number of patches in u direction
+    size_t n_u = 0;
+
+    /// Number of patches in v direction
+    size_t n_v = 0;
+
+    /// Patch (i, j) is stored at index i * n_v + j
+    std::vector<Handle(Geom_BSplineSurface)> patches;
+
+    /**
+     * Continuity (0 or 1) of the n_u - 1 seams between the patch columns, i.e. seam i joins
+     * the patches (i, j) and (i + 1, j). A seam is only C0, if the C1 join would move the
+     * surface further than the tolerance from the curves.
+     */
+    std::vector<int> continuity_u;
+
+    /// Continuity (0 or 1) of the n_v - 1 seams between the patch rows, see continuity_u
+    std::vector<int> continuity_v;
+};
+
+/**
+ * @brief Receives the progress of the curve network interpolation
+ *
+ * The progress is in [0, 1] and never decreases. The stage names the current step,
+ * e.g. "intersections", "profile reparametrization" or "profile skinning".
+ * The callback is called at the begin of each stage, also if the progress did not change.
+ * The callback is called from the thread computing the surface.
+ */
+using ProgressCallback = std::function<void(double progress, const std::string& stage)>;
+
+/**
+ * @brief Cancels a running curve network interpolation
+ *
+ * All copies of a token share the same state. Cancel may be called from any thread.
+ * The interpolation stops at the next intersection pair, curve, skinning column or block
+ * and throws a occ_gordon::cancelled_error.
+ */
+class CancellationToken
+{
+public:
+    CancellationToken()
+        : m_cancelled(std::make_shared<std::atomic<bool>>(false))
+    {}
+
+    void cancel()
+    {
+        m_cancelled->store(true);
+    }
+
+    bool is_cancelled() const
+    {
+        return m_cancelled->load();
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+/// Thrown, if the interpolation has been cancelled via a CancellationToken
+class cancelled_error : public std::runtime_error
+{
+public:
+    explicit cancelled_error(const std::string& what)
+        : std::runtime_error(what)
+    {}
+};
+
+/// Profiles and guides of a curve network
+struct CurveNetwork
+{
+    std::vector<Handle(Geom_BSplineCurve)> profiles;
+    std::vector<Handle(Geom_BSplineCurve)> guides;
+};
+
 /**
  * @brief Interpolates the curve network by a B-spline surface
  *
@@ -37,6 +255,19 @@ OCC_GORDON_EXPORT Handle(Geom_BSplineSurface)
                               const std::vector<Handle(Geom_Curve)>& vcurves,
                               double tolerance);
 
+/**
+ * @brief Interpolates the curve network by a B-spline surface using the given settings
+ *
+ * @see interpolate_curve_network(const std::vector<Handle(Geom_Curve)>&, const std::vector<Handle(Geom_Curve)>&, double)
+ *
+ * @param options Settings to trade computation time against accuracy
+ */
+OCC_GORDON_EXPORT Handle(Geom_BSplineSurface)
+    interpolate_curve_network(const std::vector<Handle(Geom_Curve)>& ucurves,
+                              const std::vector<Handle(Geom_Curve)>& vcurves,
+                              double tolerance,
+                              const InterpolateCurveNetworkOptions& options);
+
 /**
  * @brief Interpolates the curve network by a B-spline surface
  *
@@ -58,4 +289,166 @@ OCC_GORDON_EXPORT Handle(Geom_BSplineSurface)
                               const std::vector<Handle(Geom_BSplineCurve)>& vcurves,
                               double tolerance);
 
+/**
+ * @brief Interpolates the curve network by a B-spline surface using the given settings
+ *
+ * @see interpolate_curve_network(const std::vector<Handle(Geom_BSplineCurve)>&, const std::vector<Handle(Geom_BSplineCurve)>&, double)
+ *
+ * @param options Settings to trade computation time against accuracy
+ */
+OCC_GORDON_EXPORT Handle(Geom_BSplineSurface)
+    interpolate_curve_network(const std::vector<Handle(Geom_BSplineCurve)>& ucurves,
+                              const std::vector<Handle(Geom_BSplineCurve)>& vcurves,
+                              double tolerance,
+                              const InterpolateCurveNetworkOptions& options);
+
+/**
+ * @brief Interpolates the curve network and computes the deviations of the input curves from the surface
+ *
+ * Each profile lies on an iso-curve v = const and each guide on an iso-curve u = const of the surface.
+ * As the reparametrization maps the curve parameters onto the surface parameters, the input curves
+ * and the surface are evaluated at options.deviation_samples corresponding points per curve without
+ * any point projection. The cache directory of the options is not used by this function.
+ *
+ * @see interpolate_curve_network(const std::vector<Handle(Geom_BSplineCurve)>&, const std::vector<Handle(Geom_BSplineCurve)>&, double)
+ *
+ * @param deviations Receives the maximum and root mean square deviation of each curve
+ */
+OCC_GORDON_EXPORT Handle(Geom_BSplineSurface)
+    interpolate_curve_network(const std::vector<Handle(Geom_BSplineCurve)>& ucurves,
+                              const std::vector<Handle(Geom_BSplineCurve)>& vcurves,
+                              double tolerance,
+                              const InterpolateCurveNetworkOptions& options,
+                              CurveNetworkDeviations& deviations);
+
+/**
+ * @brief Interpolates the curve network and computes the deviations of the input curves from the surface
+ *
+ * @see interpolate_curve_network(const std::vector<Handle(Geom_BSplineCurve)>&, const std::vector<Handle(Geom_BSplineCurve)>&, double, const InterpolateCurveNetworkOptions&, CurveNetworkDeviations&)
+ */
+OCC_GORDON_EXPORT Handle(Geom_BSplineSurface)
+    interpolate_curve_network(const std::vector<Handle(Geom_Curve)>& ucurves,
+                              const std::vector<Handle(Geom_Curve)>& vcurves,
+                              double tolerance,
+                              const InterpolateCurveNetworkOptions& options,
+                              CurveNetworkDeviations& deviations);
+
+/**
+ * @brief Interpolates the curve network by a grid of patches
+ *
+ * The network is split into blocks as configured by options.block_size. The patches
+ * join with C1 continuity, if this keeps them within the tolerance, and are returned
+ * without merging them into a single surface.
+ * Without a block decomposition, the result is a single patch.
+ * The cache directory of the options is not used by this function.
+ *
+ * @throws std::runtime_error in case the surface cannot be built
+ *
+ * @see interpolate_curve_network(const std::vector<Handle(Geom_BSplineCurve)>&, const std::vector<Handle(Geom_BSplineCurve)>&, double)
+ */
+OCC_GORDON_EXPORT SurfacePatches
+    interpolate_curve_network_patches(const std::vector<Handle(Geom_BSplineCurve)>& ucurves,
+                                      const std::vector<Handle(Geom_BSplineCurve)>& vcurves,
+                                      double tolerance,
+                                      const InterpolateCurveNetworkOptions& options);
+
+/**
+ * @brief Interpolates the curve network by a grid of patches
+ *
+ * @see interpolate_curve_network_patches(const std::vector<Handle(Geom_BSplineCurve)>&, const std::vector<Handle(Geom_BSplineCurve)>&, double, const InterpolateCurveNetworkOptions&)
+ */
+OCC_GORDON_EXPORT SurfacePatches
+    interpolate_curve_network_patches(const std::vector<Handle(Geom_Curve)>& ucurves,
+                                      const std::vector<Handle(Geom_Curve)>& vcurves,
+                                      double tolerance,
+                                      const InterpolateCurveNetworkOptions& options);
+
+/**
+ * @brief Interpolates the curve network in the calling thread and reports its progress
+ *
+ * The progress callback is called from the calling thread. Unlike interpolate_curve_network_async,
+ * no additional thread is started and the input curves are not copied.
+ *
+ * @throws std::runtime_error in case the surface cannot be built
+ * @throws cancelled_error, if the computation has been cancelled
+ *
+ * @see interpolate_curve_network(const std::vector<Handle(Geom_BSplineCurve)>&, const std::vector<Handle(Geom_BSplineCurve)>&, double)
+ *
+ * @param progress Callback receiving the progress of the computation
+ * @param cancellation Token to stop the computation from another thread
+ */
+OCC_GORDON_EXPORT Handle(Geom_BSplineSurface)
+    interpolate_curve_network(const std::vector<Handle(Geom_BSplineCurve)>& ucurves,
+                              const std::vector<Handle(Geom_BSplineCurve)>& vcurves,
+                              double tolerance,
+                              const InterpolateCurveNetworkOptions& options,
+                              ProgressCallback progress,
+                              CancellationToken cancellation);
+
+/**
+ * @brief Interpolates the curve network asynchronously in a separate thread
+ *
+ * The input curves are copied, the caller may modify them after this call.
+ * The returned future throws a std::runtime_error, if the surface cannot be built,
+ * or a cancelled_error, if the computation has been cancelled.
+ *
+ * @param progress Optional callback receiving the progress of the computation
+ * @param cancellation Token to stop the computation from another thread
+ */
+OCC_GORDON_EXPORT std::future<Handle(Geom_BSplineSurface)>
+    interpolate_curve_network_async(const std::vector<Handle(Geom_Curve)>& ucurves,
+                                    const std::vector<Handle(Geom_Curve)>& vcurves,
+                                    double tolerance,
+                                    const InterpolateCurveNetworkOptions& options = InterpolateCurveNetworkOptions(),
+                                    ProgressCallback progress = ProgressCallback(),
+                                    CancellationToken cancellation = CancellationToken());
+
+/**
+ * @brief Interpolates the curve network asynchronously in a separate thread
+ *
+ * @see interpolate_curve_network_async(const std::vector<Handle(Geom_Curve)>&, const std::vector<Handle(Geom_Curve)>&, double, const InterpolateCurveNetworkOptions&, ProgressCallback, CancellationToken)
+ */
+OCC_GORDON_EXPORT std::future<Handle(Geom_BSplineSurface)>
+    interpolate_curve_network_async(const std::vector<Handle(Geom_BSplineCurve)>& ucurves,
+                                    const std::vector<Handle(Geom_BSplineCurve)>& vcurves,
+                                    double tolerance,
+                                    const InterpolateCurveNetworkOptions& options = InterpolateCurveNetworkOptions(),
+                                    ProgressCallback progress = ProgressCallback(),
+                                    CancellationToken cancellation = CancellationToken());
+
+/**
+ * @brief Splits a list of curves into the profiles and guides of a curve network
+ *
+ * Curves of the same family must not intersect, each profile must intersect the guides
+ * and vice versa. The intersection candidates are found with a spatial hash over the
+ * bounding boxes of the curves. Each curve is colored by its first intersection and only
+ * the curves of the same family with overlapping boxes are tested again. In a regular network,
+ * the number of intersection tests thus grows with the number of curves, not with the number
+ * of their intersections. The family of the first curve is returned as the profiles.
+ *
+ * @throws std::runtime_error, if the curves don't form a connected network of two families
+ *
+ * @param curves Profiles and guides in arbitrary order
+ * @param tolerance Tolerance, in which profiles and guides need to intersect each other,
+ *                  relative to the curve sizes as in interpolate_curve_network
+ */
+OCC_GORDON_EXPORT CurveNetwork classify_curve_network(const std::vector<Handle(Geom_Curve)>& curves, double tolerance);
+
+/**
+ * @brief Interpolates a curve network, whose profiles and guides are given in a single list
+ *
+ * The curves are split into profiles and guides by classify_curve_network and then
+ * interpolated as by interpolate_curve_network.
+ *
+ * @throws std::runtime_error in case the curves cannot be classified or the surface cannot be built
+ *
+ * @param curves Profiles and guides in arbitrary order
+ * @param tolerance Tolerance, in which profiles and guides need to intersect each other
+ * @param options Settings to trade computation time against accuracy
+ */
+OCC_GORDON_EXPORT Handle(Geom_BSplineSurface)
+    interpolate_mixed_curve_network(const std::vector<Handle(Geom_Curve)>& curves,
+                                    double tolerance,
+                                    const InterpolateCurveNetworkOptions& options = InterpolateCurveNetworkOptions());
+
 } // namespace geoml
@@ -0,0 +1,22 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+*/
+
+#ifndef APITESTUTILS_H
+#define APITESTUTILS_H
+
+#include <Geom_Curve.hxx>
+
+#include <string>
+#include <vector>
+
+namespace apitests
+{
+
+/// Reads all edge curves of a brep file
+std::vector<Handle(Geom_Curve)> read_curves(const std::string& brepFile, bool& ok);
+
+} // namespace apitests
+
+#endif // APITESTUTILS_H
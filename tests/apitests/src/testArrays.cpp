@@ -0,0 +1,119 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+*/
+
+#include <occ_gordon/arrays.h>
+#include <occ_gordon/occ_gordon.h>
+#include "apitestUtils.h"
+#include <gtest/gtest.h>
+
+#include <GeomConvert.hxx>
+
+namespace
+{
+
+// Flat arrays of several curves, as an array based application would store them
+struct FlatCurves
+{
+    std::vector<std::int32_t> degrees, nKnots, nPoles, mults;
+    std::vector<double> knots, poles, weights;
+
+    occ_gordon::BSplineCurveArrays arrays() const
+    {
+        occ_gordon::BSplineCurveArrays result;
+        result.n_curves = degrees.size();
+        result.degrees = degrees.data();
+        result.n_knots = nKnots.data();
+        result.n_poles = nPoles.data();
+        result.knots = knots.data();
+        result.multiplicities = mults.data();
+        result.poles = poles.data();
+        result.weights = weights.data();
+        return result;
+    }
+};
+
+FlatCurves flatten(const std::vector<Handle(Geom_Curve)>& curves)
+{
+    FlatCurves flat;
+    for (const Handle(Geom_Curve)& curve : curves) {
+        Handle(Geom_BSplineCurve) bspline = GeomConvert::CurveToBSplineCurve(curve);
+        flat.degrees.push_back(bspline->Degree());
+        flat.nKnots.push_back(bspline->NbKnots());
+        flat.nPoles.push_back(bspline->NbPoles());
+        for (int i = 1; i <= bspline->NbKnots(); ++i) {
+            flat.knots.push_back(bspline->Knot(i));
+            flat.mults.push_back(bspline->Multiplicity(i));
+        }
+        for (int i = 1; i <= bspline->NbPoles(); ++i) {
+            flat.poles.insert(flat.poles.end(), {bspline->Pole(i).X(), bspline->Pole(i).Y(), bspline->Pole(i).Z()});
+            flat.weights.push_back(bspline->Weight(i));
+        }
+    }
+    return flat;
+}
+
+} // namespace
+
+class arrays : public ::testing::TestWithParam<std::string>
+{
+protected:
+    void SetUp() override
+    {
+        const std::string path = "../unittests/TestData/CurveNetworks/" + GetParam();
+
+        bool ok = false;
+        ucurves = apitests::read_curves(path + "/profiles.brep", ok);
+        ASSERT_TRUE(ok);
+        vcurves = apitests::read_curves(path + "/guides.brep", ok);
+        ASSERT_TRUE(ok);
+    }
+
+    std::vector<Handle(Geom_Curve)> ucurves, vcurves;
+};
+
+TEST_P(arrays, interpolateFromArrays)
+{
+    auto reference = occ_gordon::interpolate_curve_network(ucurves, vcurves, 3e-4);
+
+    const FlatCurves profiles = flatten(ucurves);
+    const FlatCurves guides = flatten(vcurves);
+    auto surface = occ_gordon::interpolate_curve_network(occ_gordon::to_bspline_curves(profiles.arrays()),
+                                                         occ_gordon::to_bspline_curves(guides.arrays()), 3e-4);
+
+    const occ_gordon::BSplineSurfaceArraySizes sizes = occ_gordon::surface_array_sizes(surface);
+    ASSERT_EQ(static_cast<size_t>(reference->NbUPoles()), sizes.n_u_poles);
+    ASSERT_EQ(static_cast<size_t>(reference->NbVPoles()), sizes.n_v_poles);
+    EXPECT_EQ(reference->UDegree(), sizes.u_degree);
+    EXPECT_EQ(reference->VDegree(), sizes.v_degree);
+
+    std::vector<double> uKnots(sizes.n_u_knots), vKnots(sizes.n_v_knots);
+    std::vector<std::int32_t> uMults(sizes.n_u_knots), vMults(sizes.n_v_knots);
+    std::vector<double> poles(3 * sizes.n_u_poles * sizes.n_v_poles);
+    occ_gordon::copy_surface_arrays(surface, uKnots.data(), uMults.data(), vKnots.data(), vMults.data(),
+                                    poles.data(), nullptr);
+
+    EXPECT_EQ(reference->UKnot(2), uKnots[1]);
+    EXPECT_EQ(reference->VMultiplicity(1), vMults[0]);
+    for (size_t i = 0; i < sizes.n_u_poles; ++i) {
+        for (size_t j = 0; j < sizes.n_v_poles; ++j) {
+            const double* p = &poles[3 * (i * sizes.n_v_poles + j)];
+            gp_Pnt expected = reference->Pole(static_cast<int>(i) + 1, static_cast<int>(j) + 1);
+            EXPECT_NEAR(0., expected.Distance(gp_Pnt(p[0], p[1], p[2])), 1e-10);
+        }
+    }
+}
+
+TEST_P(arrays, invalidCurve)
+{
+    FlatCurves profiles = flatten(ucurves);
+    profiles.mults[0] = 0;
+    EXPECT_THROW(occ_gordon::to_bspline_curves(profiles.arrays()), std::runtime_error);
+}
+
+INSTANTIATE_TEST_SUITE_P(Arrays, arrays, ::testing::Values(
+   "nacelle",
+   "wing2",
+   "fuselage1"
+));
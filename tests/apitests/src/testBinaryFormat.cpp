@@ -0,0 +1,164 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+*/
+
+#include <occ_gordon/io.h>
+#include <occ_gordon/occ_gordon.h>
+#include "apitestUtils.h"
+#include <gtest/gtest.h>
+
+#include <GeomAPI_ProjectPointOnCurve.hxx>
+#include <GeomConvert.hxx>
+
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+
+std::vector<Handle(Geom_BSplineCurve)> read_bsplines(const std::string& brepFile)
+{
+    bool ok = false;
+    std::vector<Handle(Geom_BSplineCurve)> result;
+    for (const Handle(Geom_Curve)& curve : apitests::read_curves(brepFile, ok)) {
+        result.push_back(GeomConvert::CurveToBSplineCurve(curve));
+    }
+    EXPECT_TRUE(ok);
+    return result;
+}
+
+void expect_equal(const Handle(Geom_BSplineCurve)& expected, const Handle(Geom_BSplineCurve)& actual)
+{
+    ASSERT_EQ(expected->Degree(), actual->Degree());
+    ASSERT_EQ(expected->NbKnots(), actual->NbKnots());
+    ASSERT_EQ(expected->NbPoles(), actual->NbPoles());
+    EXPECT_EQ(expected->IsPeriodic(), actual->IsPeriodic());
+    EXPECT_EQ(expected->IsRational(), actual->IsRational());
+    for (int i = 1; i <= expected->NbKnots(); ++i) {
+        EXPECT_EQ(expected->Knot(i), actual->Knot(i));
+        EXPECT_EQ(expected->Multiplicity(i), actual->Multiplicity(i));
+    }
+    for (int i = 1; i <= expected->NbPoles(); ++i) {
+        EXPECT_EQ(0., expected->Pole(i).Distance(actual->Pole(i)));
+        EXPECT_EQ(expected->Weight(i), actual->Weight(i));
+    }
+}
+
+} // namespace
+
+class binary_format : public ::testing::TestWithParam<std::string>
+{
+protected:
+    void SetUp() override
+    {
+        const std::string path = "../unittests/TestData/CurveNetworks/" + GetParam();
+        profiles = read_bsplines(path + "/profiles.brep");
+        guides = read_bsplines(path + "/guides.brep");
+
+        std::filesystem::path output_dir("TestData/CurveNetworks/" + GetParam());
+        std::filesystem::create_directories(output_dir);
+        path_network = (output_dir / "network.ogb").string();
+        path_surface = (output_dir / "result_gordon.ogb").string();
+    }
+
+    std::vector<Handle(Geom_BSplineCurve)> profiles, guides;
+    std::string path_network, path_surface;
+};
+
+TEST_P(binary_format, curveNetworkRoundtrip)
+{
+    occ_gordon::write_binary_curve_network(path_network, profiles, guides);
+
+    occ_gordon::CurveNetwork network = occ_gordon::read_binary_curve_network(path_network);
+    ASSERT_EQ(profiles.size(), network.profiles.size());
+    ASSERT_EQ(guides.size(), network.guides.size());
+    for (size_t i = 0; i < profiles.size(); ++i) {
+        expect_equal(profiles[i], network.profiles[i]);
+    }
+    for (size_t i = 0; i < guides.size(); ++i) {
+        expect_equal(guides[i], network.guides[i]);
+    }
+
+    // the views point directly into the mapped file
+    occ_gordon::MappedGeometryFile file(path_network);
+    EXPECT_EQ(occ_gordon::binary_format_version(), file.version());
+    ASSERT_EQ(profiles.size(), file.profiles().size());
+    const occ_gordon::BSplineCurveView& view = file.profiles().front();
+    EXPECT_EQ(profiles.front()->Degree(), view.degree);
+    ASSERT_EQ(static_cast<size_t>(profiles.front()->NbPoles()), view.n_poles);
+    EXPECT_EQ(profiles.front()->Pole(2).Y(), view.poles[4]);
+    EXPECT_TRUE(file.surfaces().empty());
+}
+
+TEST_P(binary_format, surfaceRoundtrip)
+{
+    auto surface = occ_gordon::interpolate_curve_network(profiles, guides, 3e-4);
+    occ_gordon::write_binary_surface(path_surface, surface);
+
+    auto result = occ_gordon::read_binary_surface(path_surface);
+    ASSERT_EQ(surface->NbUPoles(), result->NbUPoles());
+    ASSERT_EQ(surface->NbVPoles(), result->NbVPoles());
+    ASSERT_EQ(surface->NbUKnots(), result->NbUKnots());
+    ASSERT_EQ(surface->NbVKnots(), result->NbVKnots());
+    for (int i = 1; i <= surface->NbUPoles(); ++i) {
+        for (int j = 1; j <= surface->NbVPoles(); ++j) {
+            EXPECT_EQ(0., surface->Pole(i, j).Distance(result->Pole(i, j)));
+        }
+    }
+    EXPECT_EQ(0., surface->Value(0.3, 0.7).Distance(result->Value(0.3, 0.7)));
+
+    // a file without curves
+    EXPECT_TRUE(occ_gordon::read_binary_curve_network(path_surface).profiles.empty());
+}
+
+TEST_P(binary_format, readBRepNetwork)
+{
+    const std::string path = "../unittests/TestData/CurveNetworks/" + GetParam();
+    occ_gordon::CurveNetwork network = occ_gordon::read_curve_network(path + "/profiles.brep", path + "/guides.brep");
+    ASSERT_EQ(profiles.size(), network.profiles.size());
+    ASSERT_EQ(guides.size(), network.guides.size());
+
+    // the curves are trimmed to the edges, which lie on the original curves
+    auto expect_on_curve = [](const Handle(Geom_BSplineCurve)& expected, const Handle(Geom_BSplineCurve)& actual) {
+        for (double t : {0., 0.5, 1.}) {
+            gp_Pnt p = actual->Value(actual->FirstParameter() + t * (actual->LastParameter() - actual->FirstParameter()));
+            GeomAPI_ProjectPointOnCurve projection(p, expected);
+            ASSERT_GT(projection.NbPoints(), 0);
+            EXPECT_NEAR(0., projection.LowerDistance(), 1e-8);
+        }
+    };
+    for (size_t i = 0; i < profiles.size(); ++i) {
+        expect_on_curve(profiles[i], network.profiles[i]);
+    }
+    for (size_t i = 0; i < guides.size(); ++i) {
+        expect_on_curve(guides[i], network.guides[i]);
+    }
+
+    EXPECT_THROW(occ_gordon::read_curve_network(path + "/profiles.brep", path + "/missing.brep"), std::runtime_error);
+}
+
+TEST_P(binary_format, invalidFiles)
+{
+    occ_gordon::write_binary_curve_network(path_network, profiles, guides);
+
+    // truncated file
+    const std::string path_truncated = path_network + ".truncated";
+    std::filesystem::copy_file(path_network, path_truncated, std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::resize_file(path_truncated, std::filesystem::file_size(path_network) - 8);
+    EXPECT_THROW(occ_gordon::MappedGeometryFile file(path_truncated), std::runtime_error);
+
+    // brep file
+    EXPECT_THROW(occ_gordon::MappedGeometryFile file("../unittests/TestData/CurveNetworks/" + GetParam() + "/profiles.brep"),
+                 std::runtime_error);
+
+    EXPECT_THROW(occ_gordon::MappedGeometryFile file(path_network + ".missing"), std::runtime_error);
+    EXPECT_THROW(occ_gordon::read_binary_surface(path_network), std::runtime_error);
+}
+
+INSTANTIATE_TEST_SUITE_P(BinaryFormat, binary_format, ::testing::Values(
+   "nacelle",
+   "wing2",
+   "spiralwing",
+   "fuselage1"
+));
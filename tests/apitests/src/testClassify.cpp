@@ -0,0 +1,65 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+*/
+
+#include <occ_gordon/occ_gordon.h>
+#include "apitestUtils.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+class classify : public ::testing::TestWithParam<std::string>
+{
+protected:
+    void SetUp() override
+    {
+        const std::string path = "../unittests/TestData/CurveNetworks/" + GetParam();
+
+        bool ok = false;
+        ucurves = apitests::read_curves(path + "/profiles.brep", ok);
+        ASSERT_TRUE(ok);
+        vcurves = apitests::read_curves(path + "/guides.brep", ok);
+        ASSERT_TRUE(ok);
+
+        // the first profile first, all other curves shuffled
+        curves = ucurves;
+        curves.insert(curves.end(), vcurves.begin(), vcurves.end());
+        std::shuffle(curves.begin() + 1, curves.end(), std::mt19937(42));
+    }
+
+    std::vector<Handle(Geom_Curve)> ucurves, vcurves, curves;
+};
+
+TEST_P(classify, families)
+{
+    occ_gordon::CurveNetwork network = occ_gordon::classify_curve_network(curves, 3e-4);
+    ASSERT_EQ(ucurves.size(), network.profiles.size());
+    ASSERT_EQ(vcurves.size(), network.guides.size());
+
+    // each guide must be one of the input guides
+    for (const Handle(Geom_BSplineCurve)& guide : network.guides) {
+        auto found = std::find_if(vcurves.begin(), vcurves.end(), [&guide](const Handle(Geom_Curve)& curve) {
+            return curve->Value(curve->FirstParameter()).Distance(guide->Value(guide->FirstParameter())) < 1e-10 &&
+                   curve->Value(curve->LastParameter()).Distance(guide->Value(guide->LastParameter())) < 1e-10;
+        });
+        EXPECT_TRUE(found != vcurves.end());
+    }
+}
+
+TEST_P(classify, interpolate)
+{
+    auto reference = occ_gordon::interpolate_curve_network(ucurves, vcurves, 3e-4);
+    auto surface = occ_gordon::interpolate_mixed_curve_network(curves, 3e-4);
+
+    EXPECT_EQ(reference->NbUPoles(), surface->NbUPoles());
+    EXPECT_EQ(reference->NbVPoles(), surface->NbVPoles());
+    EXPECT_NEAR(0., reference->Value(0.5, 0.5).Distance(surface->Value(0.5, 0.5)), 1e-8);
+}
+
+INSTANTIATE_TEST_SUITE_P(Classify, classify, ::testing::Values(
+   "nacelle",
+   "wing2",
+   "fuselage1"
+));
@@ -0,0 +1,166 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+*/
+
+#include <occ_gordon/occ_gordon.h>
+
+#include "apitestUtils.h"
+
+#include <gtest/gtest.h>
+
+#include <GeomConvert.hxx>
+#include <Geom_BSplineCurve.hxx>
+#include <Geom_BSplineSurface.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct CurveNetwork
+{
+    std::string name;
+    std::vector<Handle(Geom_BSplineCurve)> ucurves, vcurves;
+    Handle(Geom_BSplineSurface) reference;
+};
+
+// Knots, multiplicities, poles and weights of a curve to detect any modification
+std::vector<double> snapshot(const Handle(Geom_BSplineCurve)& curve)
+{
+    std::vector<double> data = {static_cast<double>(curve->Degree()), curve->IsPeriodic() ? 1. : 0.};
+    for (int i = 1; i <= curve->NbKnots(); ++i) {
+        data.push_back(curve->Knot(i));
+        data.push_back(curve->Multiplicity(i));
+    }
+    for (int i = 1; i <= curve->NbPoles(); ++i) {
+        data.push_back(curve->Pole(i).X());
+        data.push_back(curve->Pole(i).Y());
+        data.push_back(curve->Pole(i).Z());
+        data.push_back(curve->Weight(i));
+    }
+    return data;
+}
+
+std::vector<Handle(Geom_BSplineCurve)> toBSplines(const std::vector<Handle(Geom_Curve)>& curves)
+{
+    std::vector<Handle(Geom_BSplineCurve)> result;
+    for (const Handle(Geom_Curve)& curve : curves) {
+        result.push_back(GeomConvert::CurveToBSplineCurve(curve));
+    }
+    return result;
+}
+
+// Returns the largest distance of the poles or -1, if the surfaces differ in their structure
+double maxPoleDistance(const Handle(Geom_BSplineSurface)& s1, const Handle(Geom_BSplineSurface)& s2)
+{
+    if (s1.IsNull() || s2.IsNull() ||
+        s1->NbUPoles() != s2->NbUPoles() || s1->NbVPoles() != s2->NbVPoles() ||
+        s1->NbUKnots() != s2->NbUKnots() || s1->NbVKnots() != s2->NbVKnots()) {
+        return -1.;
+    }
+
+    double maxDist = 0.;
+    for (int i = 1; i <= s1->NbUPoles(); ++i) {
+        for (int j = 1; j <= s1->NbVPoles(); ++j) {
+            maxDist = std::max(maxDist, s1->Pole(i, j).Distance(s2->Pole(i, j)));
+        }
+    }
+    return maxDist;
+}
+
+} // namespace
+
+/*
+ * Interpolates the same networks from many threads at once. All threads share the input curves.
+ * The results must be identical to the serial computation and the input curves must not change.
+ */
+TEST(Concurrency, sharedNetworksFromManyThreads)
+{
+    std::vector<CurveNetwork> networks;
+    for (std::string name : {"wing2", "spiralwing", "test_surface4", "fuselage1", "nacelle", "ffd"}) {
+        CurveNetwork network;
+        network.name = name;
+
+        bool ok = false;
+        std::vector<Handle(Geom_Curve)> ucurves = apitests::read_curves("../unittests/TestData/CurveNetworks/" + name + "/profiles.brep", ok);
+        ASSERT_TRUE(ok) << name;
+        std::vector<Handle(Geom_Curve)> vcurves = apitests::read_curves("../unittests/TestData/CurveNetworks/" + name + "/guides.brep", ok);
+        ASSERT_TRUE(ok) << name;
+
+        // the B-spline overload works on the shared curves directly, without a conversion
+        network.ucurves = toBSplines(ucurves);
+        network.vcurves = toBSplines(vcurves);
+        network.reference = occ_gordon::interpolate_curve_network(network.ucurves, network.vcurves, 3e-4);
+        networks.push_back(network);
+    }
+
+    // the complete definition of the inputs to detect any modification
+    std::vector<std::vector<double>> snapshots;
+    for (const CurveNetwork& network : networks) {
+        for (const auto* curves : {&network.ucurves, &network.vcurves}) {
+            for (const Handle(Geom_BSplineCurve)& curve : *curves) {
+                snapshots.push_back(snapshot(curve));
+            }
+        }
+    }
+
+    const int nThreads = std::min(8, std::max(4, static_cast<int>(std::thread::hardware_concurrency())));
+    const size_t nRuns = 2;
+
+    std::vector<std::vector<double>> deviations(static_cast<size_t>(nThreads));
+    std::atomic<int> nErrors(0);
+
+    std::vector<std::thread> threads;
+    for (int ithread = 0; ithread < nThreads; ++ithread) {
+        threads.emplace_back([&, ithread]() {
+            for (size_t irun = 0; irun < nRuns; ++irun) {
+                for (size_t i = 0; i < networks.size(); ++i) {
+                    // each thread starts with a different network
+                    const CurveNetwork& network = networks[(i + static_cast<size_t>(ithread)) % networks.size()];
+                    try {
+                        // use the internal thread pool in every other thread
+                        occ_gordon::InterpolateCurveNetworkOptions options;
+                        options.threads = ithread % 2 == 0 ? 1 : 0;
+
+                        auto surface = occ_gordon::interpolate_curve_network(network.ucurves, network.vcurves, 3e-4, options);
+                        deviations[static_cast<size_t>(ithread)].push_back(maxPoleDistance(network.reference, surface));
+                    }
+                    catch (...) {
+                        nErrors++;
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(0, nErrors.load());
+    for (const std::vector<double>& threadDeviations : deviations) {
+        EXPECT_EQ(networks.size() * nRuns, threadDeviations.size());
+        for (double deviation : threadDeviations) {
+            EXPECT_GE(deviation, 0.);
+            EXPECT_LE(deviation, 1e-12);
+        }
+    }
+
+    size_t icurve = 0;
+    for (const CurveNetwork& network : networks) {
+        for (const auto* curves : {&network.ucurves, &network.vcurves}) {
+            for (const Handle(Geom_BSplineCurve)& curve : *curves) {
+                const std::vector<double> data = snapshot(curve);
+                ASSERT_EQ(snapshots[icurve].size(), data.size()) << network.name;
+                for (size_t i = 0; i < data.size(); ++i) {
+                    EXPECT_EQ(snapshots[icurve][i], data[i]) << network.name;
+                }
+                ++icurve;
+            }
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+*/
+
+#include <occ_gordon/evaluator.h>
+#include <occ_gordon/occ_gordon.h>
+#include "apitestUtils.h"
+#include <gtest/gtest.h>
+
+#include <vector>
+
+class evaluator : public ::testing::TestWithParam<std::string>
+{
+protected:
+    void SetUp() override
+    {
+        const std::string path = "../unittests/TestData/CurveNetworks/" + GetParam();
+
+        bool ok = false;
+        auto ucurves = apitests::read_curves(path + "/profiles.brep", ok);
+        ASSERT_TRUE(ok);
+        auto vcurves = apitests::read_curves(path + "/guides.brep", ok);
+        ASSERT_TRUE(ok);
+
+        surface = occ_gordon::interpolate_curve_network(ucurves, vcurves, 3e-4);
+    }
+
+    Handle(Geom_BSplineSurface) surface;
+};
+
+TEST_P(evaluator, grid)
+{
+    double u0, u1, v0, v1;
+    surface->Bounds(u0, u1, v0, v1);
+
+    std::vector<double> u, v;
+    for (int i = 0; i <= 40; ++i) {
+        u.push_back(u0 + (u1 - u0) * i / 40.);
+    }
+    for (int j = 0; j <= 30; ++j) {
+        v.push_back(v0 + (v1 - v0) * j / 30.);
+    }
+
+    const size_t n = u.size() * v.size();
+    std::vector<double> points(3 * n), du(3 * n), dv(3 * n);
+    occ_gordon::SurfaceEvaluator evaluator(surface);
+    evaluator.evaluate_grid(u.data(), u.size(), v.data(), v.size(), points.data(), du.data(), dv.data());
+
+    for (size_t i = 0; i < u.size(); ++i) {
+        for (size_t j = 0; j < v.size(); ++j) {
+            gp_Pnt p;
+            gp_Vec pu, pv;
+            surface->D1(u[i], v[j], p, pu, pv);
+
+            const size_t idx = 3 * (i * v.size() + j);
+            EXPECT_NEAR(0., p.Distance(gp_Pnt(points[idx], points[idx + 1], points[idx + 2])), 1e-10);
+            EXPECT_NEAR(0., (pu - gp_Vec(du[idx], du[idx + 1], du[idx + 2])).Magnitude(), 1e-8 * (1. + pu.Magnitude()));
+            EXPECT_NEAR(0., (pv - gp_Vec(dv[idx], dv[idx + 1], dv[idx + 2])).Magnitude(), 1e-8 * (1. + pv.Magnitude()));
+        }
+    }
+}
+
+TEST_P(evaluator, scattered)
+{
+    double u0, u1, v0, v1;
+    surface->Bounds(u0, u1, v0, v1);
+
+    std::vector<double> u, v;
+    for (int i = 0; i < 1000; ++i) {
+        u.push_back(u0 + (u1 - u0) * ((i * 37) % 1000) / 999.);
+        v.push_back(v0 + (v1 - v0) * ((i * 91) % 1000) / 999.);
+    }
+
+    std::vector<double> points(3 * u.size());
+    occ_gordon::SurfaceEvaluator evaluator(surface);
+    evaluator.evaluate_points(u.data(), v.data(), u.size(), points.data(), nullptr, nullptr, 2);
+
+    for (size_t i = 0; i < u.size(); ++i) {
+        gp_Pnt p = surface->Value(u[i], v[i]);
+        EXPECT_NEAR(0., p.Distance(gp_Pnt(points[3 * i], points[3 * i + 1], points[3 * i + 2])), 1e-10);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Evaluator, evaluator, ::testing::Values(
+   "nacelle",
+   "wing2"
+));
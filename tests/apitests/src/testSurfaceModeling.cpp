@@ -6,6 +6,8 @@
 
 #include <occ_gordon/occ_gordon.h>
 
+#include "apitestUtils.h"
+
 #include <gtest/gtest.h>
 
 #include <GeomConvert.hxx>
@@ -23,7 +25,9 @@
 #include <gp_Pnt.hxx>
 #include <gp_Vec.hxx>
 
+#include <algorithm>
 #include <filesystem>
+#include <iterator>
 
 namespace apitests
 {
@@ -92,6 +96,144 @@ TEST_P(interpolate_curve_network, testFromBRep)
     BRepTools::Write(BRepBuilderAPI_MakeFace(gordonSurface, Precision::Confusion()), path_output.c_str());
 }
 
+TEST_P(interpolate_curve_network, testDefaultOptions)
+{
+    auto reference = occ_gordon::interpolate_curve_network(ucurves, vcurves, 3e-4);
+
+    // the default options must reproduce the result, also when running serially
+    occ_gordon::InterpolateCurveNetworkOptions options;
+    options.threads = 1;
+    auto surface = occ_gordon::interpolate_curve_network(ucurves, vcurves, 3e-4, options);
+
+    ASSERT_EQ(reference->NbUPoles(), surface->NbUPoles());
+    ASSERT_EQ(reference->NbVPoles(), surface->NbVPoles());
+    for (int i = 1; i <= surface->NbUPoles(); ++i) {
+        for (int j = 1; j <= surface->NbVPoles(); ++j) {
+            EXPECT_NEAR(0., reference->Pole(i, j).Distance(surface->Pole(i, j)), 1e-10);
+        }
+    }
+}
+
+TEST_P(interpolate_curve_network, testAsync)
+{
+    auto reference = occ_gordon::interpolate_curve_network(ucurves, vcurves, 3e-4);
+
+    std::vector<double> progress;
+    auto future = occ_gordon::interpolate_curve_network_async(ucurves, vcurves, 3e-4, occ_gordon::InterpolateCurveNetworkOptions(),
+                                                              [&progress](double p, const std::string&) {
+                                                                  progress.push_back(p);
+                                                              });
+    auto surface = future.get();
+
+    ASSERT_EQ(reference->NbUPoles(), surface->NbUPoles());
+    ASSERT_EQ(reference->NbVPoles(), surface->NbVPoles());
+    EXPECT_NEAR(0., reference->Value(0.5, 0.5).Distance(surface->Value(0.5, 0.5)), 1e-10);
+
+    // the progress increases up to 1
+    ASSERT_FALSE(progress.empty());
+    EXPECT_TRUE(std::is_sorted(progress.begin(), progress.end()));
+    EXPECT_DOUBLE_EQ(1., progress.back());
+}
+
+TEST_P(interpolate_curve_network, testAsyncCancel)
+{
+    occ_gordon::CancellationToken token;
+    token.cancel();
+
+    auto future = occ_gordon::interpolate_curve_network_async(ucurves, vcurves, 3e-4, occ_gordon::InterpolateCurveNetworkOptions(),
+                                                              occ_gordon::ProgressCallback(), token);
+    EXPECT_THROW(future.get(), occ_gordon::cancelled_error);
+}
+
+TEST_P(interpolate_curve_network, testCancelDuringKnotRemoval)
+{
+    occ_gordon::InterpolateCurveNetworkOptions options;
+    options.knot_removal_tolerance = 1e-4;
+
+    // the last stage must still check for the cancellation
+    occ_gordon::CancellationToken token;
+    bool reachedKnotRemoval = false;
+    auto progress = [&](double, const std::string& stage) {
+        if (stage == "knot removal") {
+            reachedKnotRemoval = true;
+            token.cancel();
+        }
+    };
+
+    auto future = occ_gordon::interpolate_curve_network_async(ucurves, vcurves, 3e-4, options, progress, token);
+    EXPECT_THROW(future.get(), occ_gordon::cancelled_error);
+    EXPECT_TRUE(reachedKnotRemoval);
+}
+
+TEST_P(interpolate_curve_network, testCache)
+{
+    occ_gordon::InterpolateCurveNetworkOptions options;
+    options.cache_directory = "TestData/CurveNetworks/" + GetParam() + "/cache";
+    std::filesystem::remove_all(options.cache_directory);
+
+    // the first call computes the surface, the second one reads it from the cache
+    auto computed = occ_gordon::interpolate_curve_network(ucurves, vcurves, 3e-4, options);
+    ASSERT_EQ(1, std::distance(std::filesystem::directory_iterator(options.cache_directory),
+                               std::filesystem::directory_iterator()));
+    auto cached = occ_gordon::interpolate_curve_network(ucurves, vcurves, 3e-4, options);
+
+    ASSERT_EQ(computed->NbUPoles(), cached->NbUPoles());
+    ASSERT_EQ(computed->NbVPoles(), cached->NbVPoles());
+    for (int i = 1; i <= cached->NbUPoles(); ++i) {
+        for (int j = 1; j <= cached->NbVPoles(); ++j) {
+            EXPECT_EQ(0., computed->Pole(i, j).Distance(cached->Pole(i, j)));
+        }
+    }
+
+    // other settings give another entry
+    options.max_control_points = 60;
+    occ_gordon::interpolate_curve_network(ucurves, vcurves, 3e-4, options);
+    EXPECT_EQ(2, std::distance(std::filesystem::directory_iterator(options.cache_directory),
+                               std::filesystem::directory_iterator()));
+
+    std::filesystem::remove_all(options.cache_directory);
+}
+
+TEST_P(interpolate_curve_network, testDeviations)
+{
+    auto reference = occ_gordon::interpolate_curve_network(ucurves, vcurves, 3e-4);
+
+    occ_gordon::InterpolateCurveNetworkOptions options;
+    options.deviation_samples = 51;
+    occ_gordon::CurveNetworkDeviations deviations;
+    auto surface = occ_gordon::interpolate_curve_network(ucurves, vcurves, 3e-4, options, deviations);
+
+    // computing the deviations does not change the surface
+    ASSERT_EQ(reference->NbUPoles(), surface->NbUPoles());
+    ASSERT_EQ(reference->NbVPoles(), surface->NbVPoles());
+    EXPECT_NEAR(0., reference->Value(0.5, 0.5).Distance(surface->Value(0.5, 0.5)), 1e-10);
+
+    double u1 = 0., u2 = 0., v1 = 0., v2 = 0.;
+    surface->Bounds(u1, u2, v1, v2);
+
+    ASSERT_GE(deviations.profiles.size(), 2u);
+    ASSERT_GE(deviations.guides.size(), 2u);
+    for (const occ_gordon::CurveDeviation& deviation : deviations.profiles) {
+        EXPECT_LT(deviation.index, ucurves.size());
+        EXPECT_LE(deviation.rms_deviation, deviation.max_deviation);
+        EXPECT_LE(deviation.max_deviation, deviations.max_deviation());
+
+        // the profiles are iso-curves v = const
+        EXPECT_GE(deviation.parameter, v1);
+        EXPECT_LE(deviation.parameter, v2);
+    }
+    for (const occ_gordon::CurveDeviation& deviation : deviations.guides) {
+        EXPECT_LT(deviation.index, vcurves.size());
+        EXPECT_LE(deviation.rms_deviation, deviation.max_deviation);
+        EXPECT_GE(deviation.parameter, u1);
+        EXPECT_LE(deviation.parameter, u2);
+    }
+
+    // the parameters are ascending along the surface
+    EXPECT_LT(deviations.profiles.front().parameter, deviations.profiles.back().parameter);
+    EXPECT_LT(deviations.guides.front().parameter, deviations.guides.back().parameter);
+}
+
 INSTANTIATE_TEST_SUITE_P(SurfaceModeling, interpolate_curve_network, ::testing::Values(
    "nacelle",
    "full_nacelle",
@@ -106,3 +248,68 @@ INSTANTIATE_TEST_SUITE_P(SurfaceModeling, interpolate_curve_network, ::testing::
    "fuselage2",
    "ffd"
 ));
+
+// Real networks, which are large enough for a block decomposition
+class interpolate_curve_network_blocks: public interpolate_curve_network
+{
+};
+
+TEST_P(interpolate_curve_network_blocks, testPatches)
+{
+    occ_gordon::InterpolateCurveNetworkOptions options;
+    options.block_size = 3;
+    options.block_overlap = 1;
+    occ_gordon::SurfacePatches result = occ_gordon::interpolate_curve_network_patches(ucurves, vcurves, 3e-4, options);
+    ASSERT_GT(result.n_u * result.n_v, 1u);
+    ASSERT_EQ(result.n_u * result.n_v, result.patches.size());
+    ASSERT_EQ(result.n_u - 1, result.continuity_u.size());
+    ASSERT_EQ(result.n_v - 1, result.continuity_v.size());
+
+    occ_gordon::CurveNetworkDeviations deviations;
+    auto surface = occ_gordon::interpolate_curve_network(ucurves, vcurves, 3e-4, options, deviations);
+    EXPECT_EQ(ucurves.size(), deviations.profiles.size());
+    EXPECT_EQ(vcurves.size(), deviations.guides.size());
+
+    // coarse check relative to the size of the network, the unit tests bound the deviation of each curve
+    double u1 = 0., u2 = 0., v1 = 0., v2 = 0.;
+    surface->Bounds(u1, u2, v1, v2);
+    const double size = surface->Value(u1, v1).Distance(surface->Value(u2, v2));
+    EXPECT_LT(deviations.max_deviation(), 1e-2 * size);
+
+    // neighboring patches share their seams, the merged surface passes through all patches
+    for (size_t i = 0; i < result.n_u; ++i) {
+        for (size_t j = 0; j < result.n_v; ++j) {
+            const Handle(Geom_BSplineSurface)& patch = result.patches[i * result.n_v + j];
+            patch->Bounds(u1, u2, v1, v2);
+            EXPECT_NEAR(0., patch->Value(u1, v1).Distance(surface->Value(u1, v1)), 3e-4);
+
+            if (i + 1 < result.n_u) {
+                const Handle(Geom_BSplineSurface)& next = result.patches[(i + 1) * result.n_v + j];
+                EXPECT_NEAR(0., patch->Value(u2, 0.5 * (v1 + v2)).Distance(next->Value(u2, 0.5 * (v1 + v2))), 1e-10);
+            }
+            if (j + 1 < result.n_v) {
+                const Handle(Geom_BSplineSurface)& next = result.patches[i * result.n_v + j + 1];
+                EXPECT_NEAR(0., patch->Value(0.5 * (u1 + u2), v2).Distance(next->Value(0.5 * (u1 + u2), v2)), 1e-10);
+            }
+        }
+    }
+
+    // small networks are not decomposed
+    options.block_size = 20;
+    result = occ_gordon::interpolate_curve_network_patches(ucurves, vcurves, 3e-4, options);
+    EXPECT_EQ(1u, result.n_u);
+    EXPECT_EQ(1u, result.n_v);
+    EXPECT_TRUE(result.continuity_u.empty());
+    EXPECT_TRUE(result.continuity_v.empty());
+
+    options.block_size = 1;
+    EXPECT_THROW(occ_gordon::interpolate_curve_network(ucurves, vcurves, 3e-4, options), std::runtime_error);
+
+    options.block_size = 3;
+    options.exact_reparametrization = true;
+    EXPECT_THROW(occ_gordon::interpolate_curve_network(ucurves, vcurves, 3e-4, options), std::runtime_error);
+}
+
+INSTANTIATE_TEST_SUITE_P(SurfaceModeling, interpolate_curve_network_blocks, ::testing::Values(
+   "wing2"
+));
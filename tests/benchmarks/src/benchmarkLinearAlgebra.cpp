@@ -0,0 +1,95 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+/*
+ * Compares the dense linear algebra backends.
+ *
+ * The backend is chosen at configure time (OCC_GORDON_USE_EIGEN). To compare both,
+ * build twice and run this benchmark in each build directory:
+ *
+ *     occ_gordon-benchmark-linalg [path/to/CurveNetworks] [repetitions]
+ */
+
+#include "benchmarkUtils.h"
+
+#include "internal/LinearAlgebra.h"
+
+#include <occ_gordon/occ_gordon.h>
+
+#include <math_Matrix.hxx>
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace
+{
+
+// Creates a banded, diagonally dominant matrix similar to the
+// normal equations of a cubic B-spline least squares fit
+math_Matrix createBandedSystem(int n, int bandwidth)
+{
+    math_Matrix m(1, n, 1, n, 0.);
+    for (int i = 1; i <= n; ++i) {
+        for (int j = std::max(1, i - bandwidth); j <= std::min(n, i + bandwidth); ++j) {
+            m(i, j) = 1. / (1. + std::abs(i - j));
+        }
+        m(i, i) += static_cast<double>(bandwidth);
+    }
+    return m;
+}
+
+void benchmarkDenseSolve(int nRepeat)
+{
+    std::cout << "Dense LU solve with 3 right hand sides" << std::endl;
+    for (int n : {50, 100, 200, 400}) {
+        math_Matrix lhs = createBandedSystem(n, 3);
+        math_Matrix rhs(1, n, 1, 3, 1.);
+        math_Matrix x(1, n, 1, 3);
+
+        double ms = benchmarks::minTimeMs(nRepeat, [&]() {
+            occ_gordon_internal::DenseLUSolver solver(lhs);
+            solver.Solve(rhs, x);
+        });
+        std::cout << "  n = " << std::setw(4) << n << ": " << std::fixed << std::setprecision(3) << ms << " ms" << std::endl;
+    }
+}
+
+void benchmarkNetworks(const std::string& dataDir, int nRepeat)
+{
+    std::cout << "Curve network interpolation" << std::endl;
+    for (const std::string& name : benchmarks::networkNames()) {
+        bool okProfiles = false, okGuides = false;
+        auto profiles = benchmarks::readCurves(dataDir + "/" + name + "/profiles.brep", okProfiles);
+        auto guides = benchmarks::readCurves(dataDir + "/" + name + "/guides.brep", okGuides);
+        if (!okProfiles || !okGuides) {
+            std::cout << "  " << std::setw(22) << std::left << name << std::right << ": cannot read network" << std::endl;
+            continue;
+        }
+
+        double ms = benchmarks::minTimeMs(nRepeat, [&]() {
+            occ_gordon::interpolate_curve_network(profiles, guides, 3e-4);
+        });
+        std::cout << "  " << std::setw(22) << std::left << name << std::right << ": "
+                  << std::fixed << std::setprecision(1) << ms << " ms" << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string dataDir = argc > 1 ? argv[1] : OCC_GORDON_BENCHMARK_DATA;
+    int nRepeat = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+
+    std::cout << "Linear algebra backend: " << occ_gordon_internal::LinearAlgebraBackendName() << std::endl;
+
+    benchmarkDenseSolve(10 * nRepeat);
+    benchmarkNetworks(dataDir, nRepeat);
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+/*
+ * Compares the reparametrization modes of the curve network interpolation.
+ *
+ * For each network, the runtime, the size of the resulting surface and the
+ * maximum distance of the input curves to the surface are printed:
+ *
+ *     occ_gordon-benchmark-reparam [path/to/CurveNetworks] [repetitions]
+ */
+
+#include "benchmarkUtils.h"
+
+#include "internal/InterpolateCurveNetwork.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace
+{
+
+using occ_gordon_internal::ReparametrizationMode;
+
+// The interpolation changes the parameter range of the input curves
+std::vector<Handle(Geom_Curve)> copyCurves(const std::vector<Handle(Geom_Curve)>& curves)
+{
+    std::vector<Handle(Geom_Curve)> result;
+    for (const Handle(Geom_Curve)& curve : curves) {
+        result.push_back(Handle(Geom_Curve)::DownCast(curve->Copy()));
+    }
+    return result;
+}
+
+double maxDeviation(const std::vector<occ_gordon_internal::CurveDeviation>& deviations)
+{
+    double maxDev = 0.;
+    for (const occ_gordon_internal::CurveDeviation& deviation : deviations) {
+        maxDev = std::max(maxDev, deviation.maxDeviation);
+    }
+    return maxDev;
+}
+
+void benchmarkNetwork(const std::string& name, const std::vector<Handle(Geom_Curve)>& profiles,
+                      const std::vector<Handle(Geom_Curve)>& guides, ReparametrizationMode mode, int nRepeat)
+{
+    std::unique_ptr<occ_gordon_internal::InterpolateCurveNetwork> interpolator;
+    Handle(Geom_BSplineSurface) surface;
+    double ms = benchmarks::minTimeMs(nRepeat, [&]() {
+        interpolator = std::make_unique<occ_gordon_internal::InterpolateCurveNetwork>(copyCurves(profiles), copyCurves(guides), 3e-4);
+        interpolator->SetReparametrizationMode(mode);
+        surface = interpolator->Surface();
+    });
+
+    // the input curves lie on known iso-curves of the surface, no projection is required
+    double dist = std::max(maxDeviation(interpolator->DeviationsProfiles()), maxDeviation(interpolator->DeviationsGuides()));
+
+    std::cout << "  " << std::setw(22) << std::left << name << std::right
+              << std::setw(13) << (mode == ReparametrizationMode::Approximation ? "approx" : "exact") << ": "
+              << std::fixed << std::setprecision(1) << std::setw(8) << ms << " ms, "
+              << std::setw(4) << surface->NbUPoles() << " x " << std::setw(4) << surface->NbVPoles() << " poles, "
+              << "max. curve distance " << std::scientific << std::setprecision(2) << dist << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string dataDir = argc > 1 ? argv[1] : OCC_GORDON_BENCHMARK_DATA;
+    int nRepeat = argc > 2 ? std::max(1, std::atoi(argv[2])) : 3;
+
+    std::cout << "Curve network interpolation by reparametrization mode" << std::endl;
+    for (const std::string& name : benchmarks::networkNames()) {
+        bool okProfiles = false, okGuides = false;
+        auto profiles = benchmarks::readCurves(dataDir + "/" + name + "/profiles.brep", okProfiles);
+        auto guides = benchmarks::readCurves(dataDir + "/" + name + "/guides.brep", okGuides);
+        if (!okProfiles || !okGuides) {
+            std::cout << "  " << std::setw(22) << std::left << name << std::right << ": cannot read network" << std::endl;
+            continue;
+        }
+
+        for (ReparametrizationMode mode : {ReparametrizationMode::Approximation, ReparametrizationMode::ExactComposition}) {
+            try {
+                benchmarkNetwork(name, profiles, guides, mode, nRepeat);
+            }
+            catch (const std::exception& err) {
+                std::cout << "  " << std::setw(22) << std::left << name << std::right << ": " << err.what() << std::endl;
+            }
+        }
+    }
+
+    return 0;
+}
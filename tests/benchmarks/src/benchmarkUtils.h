@@ -0,0 +1,68 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+#ifndef BENCHMARKUTILS_H
+#define BENCHMARKUTILS_H
+
+#include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
+#include <BRepTools.hxx>
+#include <Geom_Curve.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Edge.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace benchmarks
+{
+
+/// The curve networks of the unit tests
+inline std::vector<std::string> networkNames()
+{
+    return {"nacelle", "full_nacelle", "wing2", "spiralwing", "test_surface4_sorted", "test_surface4",
+            "wing3", "bellyfairing", "helibody", "fuselage1", "fuselage2", "ffd"};
+}
+
+inline std::vector<Handle(Geom_Curve)> readCurves(const std::string& brepFile, bool& ok)
+{
+    TopoDS_Shape shape;
+    BRep_Builder builder;
+
+    ok = BRepTools::Read(shape, brepFile.c_str(), builder);
+    if (!ok) return {};
+
+    std::vector<Handle(Geom_Curve)> curves;
+    for (TopExp_Explorer explorer(shape, TopAbs_EDGE); explorer.More(); explorer.Next()) {
+        const TopoDS_Edge& edge = TopoDS::Edge(explorer.Current());
+        double beginning = 0;
+        double end = 1;
+        curves.push_back(BRep_Tool::Curve(edge, beginning, end));
+    }
+    return curves;
+}
+
+/// Runs func nRepeat times and returns the minimum wall time in milliseconds
+template <typename Func>
+double minTimeMs(int nRepeat, Func&& func)
+{
+    double best = -1.;
+    for (int i = 0; i < nRepeat; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto stop = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+        best = best < 0. ? ms : std::min(best, ms);
+    }
+    return best;
+}
+
+} // namespace benchmarks
+
+#endif // BENCHMARKUTILS_H
@@ -14,7 +14,13 @@
 #include <Geom_BSplineCurve.hxx>
 #include <GeomAPI_ProjectPointOnCurve.hxx>
 #include <TColgp_Array1OfPnt.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+#include <TColStd_Array2OfReal.hxx>
 #include "internal/BSplineApproxInterp.h"
+#include "internal/ApproxSystemCache.h"
+#include "internal/BSplineCurveEvaluator.h"
+#include "internal/BSplineSurfaceEvaluator.h"
+#include "internal/MonotoneCubicInterpolation.h"
 
 #include <BRepTools.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
@@ -120,6 +126,154 @@ TEST(BSplines, bSplineMatDeriv1)
     EXPECT_NEAR(A.Value(4,3), 2., 1e-10);
 }
 
+// compares the span cached evaluator with the OCCT evaluation
+TEST(BSplines, curveEvaluator)
+{
+    TColgp_Array1OfPnt poles(1, 7);
+    TColStd_Array1OfReal weights(1, 7);
+    for (Standard_Integer i = 1; i <= 7; ++i) {
+        poles.SetValue(i, gp_Pnt(i, std::sin(1.3 * i), 0.1 * i * i));
+        weights.SetValue(i, 1. + 0.3 * std::cos(i));
+    }
+
+    TColStd_Array1OfReal knots(1, 4);
+    knots.SetValue(1, 0.);
+    knots.SetValue(2, 0.3);
+    knots.SetValue(3, 0.6);
+    knots.SetValue(4, 1.);
+    TColStd_Array1OfInteger mults(1, 4);
+    mults.SetValue(1, 4);
+    mults.SetValue(2, 1);
+    mults.SetValue(3, 2);
+    mults.SetValue(4, 4);
+
+    Handle(Geom_BSplineCurve) polynomial = new Geom_BSplineCurve(poles, knots, mults, 3);
+    Handle(Geom_BSplineCurve) rational = new Geom_BSplineCurve(poles, weights, knots, mults, 3);
+
+    for (const Handle(Geom_BSplineCurve)& curve : {polynomial, rational}) {
+        occ_gordon_internal::BSplineCurveEvaluator evaluator(curve);
+        EXPECT_EQ(3, evaluator.Degree());
+        EXPECT_NEAR(0., evaluator.FirstParameter(), 1e-15);
+        EXPECT_NEAR(1., evaluator.LastParameter(), 1e-15);
+
+        int spanHint = -1;
+        // the second derivative jumps at the double knot, hence we avoid the knots
+        for (int i = 0; i <= 100; ++i) {
+            double t = (i + 0.5) / 101.;
+            gp_XYZ ders[3];
+            evaluator.Derivatives(t, 2, ders, spanHint);
+            for (int k = 0; k <= 2; ++k) {
+                gp_Vec expected = k == 0 ? gp_Vec(curve->Value(t).XYZ()) : curve->DN(t, k);
+                EXPECT_NEAR(0., (expected.XYZ() - ders[k]).Modulus(), 1e-9 * (1. + expected.Magnitude()));
+            }
+        }
+    }
+}
+
+// compares the grid and batch evaluation of surfaces with the OCCT evaluation
+TEST(BSplines, surfaceEvaluator)
+{
+    TColgp_Array2OfPnt poles(1, 5, 1, 6);
+    TColStd_Array2OfReal weights(1, 5, 1, 6);
+    for (Standard_Integer i = 1; i <= 5; ++i) {
+        for (Standard_Integer j = 1; j <= 6; ++j) {
+            poles.SetValue(i, j, gp_Pnt(i, j, std::sin(0.7 * i) * std::cos(0.4 * j)));
+            weights.SetValue(i, j, 1. + 0.2 * std::cos(i + 2. * j));
+        }
+    }
+
+    TColStd_Array1OfReal uKnots(1, 3), vKnots(1, 4);
+    TColStd_Array1OfInteger uMults(1, 3), vMults(1, 4);
+    uKnots.SetValue(1, 0.); uKnots.SetValue(2, 0.4); uKnots.SetValue(3, 1.);
+    uMults.SetValue(1, 4); uMults.SetValue(2, 1); uMults.SetValue(3, 4);
+    vKnots.SetValue(1, 0.); vKnots.SetValue(2, 0.3); vKnots.SetValue(3, 0.5); vKnots.SetValue(4, 1.);
+    vMults.SetValue(1, 3); vMults.SetValue(2, 1); vMults.SetValue(3, 2); vMults.SetValue(4, 3);
+
+    Handle(Geom_BSplineSurface) polynomial = new Geom_BSplineSurface(poles, uKnots, vKnots, uMults, vMults, 3, 2);
+    Handle(Geom_BSplineSurface) rational = new Geom_BSplineSurface(poles, weights, uKnots, vKnots, uMults, vMults, 3, 2);
+
+    std::vector<double> u, v;
+    for (int i = 0; i <= 13; ++i) {
+        u.push_back(i / 13.);
+    }
+    for (int j = 0; j <= 17; ++j) {
+        v.push_back(j / 17.);
+    }
+
+    for (const Handle(Geom_BSplineSurface)& surface : {polynomial, rational}) {
+        occ_gordon_internal::BSplineSurfaceEvaluator evaluator(surface);
+        EXPECT_EQ(3, evaluator.UDegree());
+        EXPECT_EQ(2, evaluator.VDegree());
+        EXPECT_NEAR(1., evaluator.LastVParameter(), 1e-15);
+
+        const size_t n = u.size() * v.size();
+        std::vector<gp_XYZ> points(n), du(n), dv(n);
+        evaluator.EvaluateGrid(u.data(), u.size(), v.data(), v.size(), points.data(), du.data(), dv.data());
+
+        // the same points as scattered batch in reverse order
+        std::vector<double> uScattered, vScattered;
+        for (size_t i = u.size(); i-- > 0;) {
+            for (size_t j = v.size(); j-- > 0;) {
+                uScattered.push_back(u[i]);
+                vScattered.push_back(v[j]);
+            }
+        }
+        std::vector<gp_XYZ> scattered(n), scatteredDu(n), scatteredDv(n);
+        evaluator.EvaluatePoints(uScattered.data(), vScattered.data(), n, scattered.data(), scatteredDu.data(), scatteredDv.data());
+
+        for (size_t i = 0; i < u.size(); ++i) {
+            for (size_t j = 0; j < v.size(); ++j) {
+                gp_Pnt p;
+                gp_Vec pu, pv;
+                surface->D1(u[i], v[j], p, pu, pv);
+
+                const size_t idx = i * v.size() + j;
+                EXPECT_NEAR(0., (p.XYZ() - points[idx]).Modulus(), 1e-12);
+                EXPECT_NEAR(0., (pu.XYZ() - du[idx]).Modulus(), 1e-10 * (1. + pu.Magnitude()));
+                EXPECT_NEAR(0., (pv.XYZ() - dv[idx]).Modulus(), 1e-10 * (1. + pv.Magnitude()));
+
+                const size_t scatteredIdx = n - 1 - idx;
+                EXPECT_NEAR(0., (p.XYZ() - scattered[scatteredIdx]).Modulus(), 1e-12);
+                EXPECT_NEAR(0., (pu.XYZ() - scatteredDu[scatteredIdx]).Modulus(), 1e-10 * (1. + pu.Magnitude()));
+                EXPECT_NEAR(0., (pv.XYZ() - scatteredDv[scatteredIdx]).Modulus(), 1e-10 * (1. + pv.Magnitude()));
+            }
+        }
+
+        // points only
+        std::vector<gp_XYZ> pointsOnly(n);
+        evaluator.EvaluateGrid(u.data(), u.size(), v.data(), v.size(), pointsOnly.data());
+        EXPECT_NEAR(0., (pointsOnly[n / 2] - points[n / 2]).Modulus(), 1e-14);
+    }
+}
+
+TEST(BSplines, monotoneCubicInterpolation)
+{
+    std::vector<double> x = {0., 0.1, 0.2, 0.3, 0.7, 0.95, 1.};
+    std::vector<double> y = {0., 0.2, 0.4, 0.5, 0.6, 0.8, 1.};
+    occ_gordon_internal::MonotoneCubicInterpolation func(x, y);
+
+    for (size_t i = 0; i < x.size(); ++i) {
+        EXPECT_NEAR(y[i], func.Value(x[i]), 1e-14);
+    }
+
+    // the interpolant is monotone and can be inverted
+    double previous = func.Value(0.);
+    for (int i = 1; i <= 1000; ++i) {
+        double t = i / 1000.;
+        double value = func.Value(t);
+        EXPECT_GE(value, previous);
+        EXPECT_GE(func.Derivative(t), 0.);
+        EXPECT_NEAR(t, func.Inverse(value), 1e-12);
+        previous = value;
+    }
+
+    // linear extrapolation
+    EXPECT_NEAR(-0.1 * func.Derivative(0.), func.Value(-0.1), 1e-14);
+
+    EXPECT_THROW(occ_gordon_internal::MonotoneCubicInterpolation({0., 0.5, 0.4}, {0., 1., 2.}), occ_gordon_internal::error);
+    EXPECT_THROW(occ_gordon_internal::MonotoneCubicInterpolation({0., 0.5, 1.}, {0., 1., 0.5}), occ_gordon_internal::error);
+}
+
 class BSplineInterpolation : public ::testing::Test
 {
 protected:
@@ -182,6 +336,62 @@ TEST_F(BSplineInterpolation, approxAndInterpolate)
     StoreResult("TestData/analysis/BSplineInterpolation-approxAndInterpolate.brep", result.curve, pnts);
 }
 
+// curves with the same parameters share the factorized system, the result must not change
+TEST_F(BSplineInterpolation, approxSharedSystemCache)
+{
+    TColgp_Array1OfPnt pnts2(1, pnts.Length());
+    for (Standard_Integer i = pnts.Lower(); i <= pnts.Upper(); ++i) {
+        gp_Pnt p = pnts.Value(i);
+        pnts2.SetValue(i, gp_Pnt(2. * p.X() + 1., p.Y() - 0.5, 0.5 * p.Z()));
+    }
+
+    occ_gordon_internal::ApproxSystemCache cache;
+
+    occ_gordon_internal::BSplineApproxInterp app1(pnts, 30, 3);
+    occ_gordon_internal::BSplineApproxInterp app2(pnts2, 30, 3);
+    occ_gordon_internal::BSplineApproxInterp ref2(pnts2, 30, 3);
+    for (occ_gordon_internal::BSplineApproxInterp* app : {&app1, &app2, &ref2}) {
+        app->InterpolatePoint(0);
+        app->InterpolatePoint(50);
+        app->InterpolatePoint(100);
+    }
+    app1.SetSystemCache(&cache);
+    app2.SetSystemCache(&cache);
+
+    occ_gordon_internal::ApproxResult result1 = app1.FitCurve(parms);
+    EXPECT_NEAR(0.01317089, result1.error, 1e-5);
+    EXPECT_EQ(0, cache.Hits());
+    EXPECT_EQ(1, cache.Size());
+
+    occ_gordon_internal::ApproxResult result2 = app2.FitCurve(parms);
+    EXPECT_EQ(1, cache.Hits());
+    EXPECT_EQ(1, cache.Size());
+
+    occ_gordon_internal::ApproxResult reference = ref2.FitCurve(parms);
+    EXPECT_NEAR(reference.error, result2.error, 1e-10);
+    ASSERT_EQ(reference.curve->NbPoles(), result2.curve->NbPoles());
+    for (Standard_Integer i = 1; i <= reference.curve->NbPoles(); ++i) {
+        EXPECT_NEAR(0., reference.curve->Pole(i).Distance(result2.curve->Pole(i)), 1e-10);
+    }
+
+    // different interpolation constraints require a different system
+    occ_gordon_internal::BSplineApproxInterp app3(pnts, 30, 3);
+    app3.InterpolatePoint(0);
+    app3.InterpolatePoint(100);
+    app3.SetSystemCache(&cache);
+    app3.FitCurve(parms);
+    EXPECT_EQ(1, cache.Hits());
+    EXPECT_EQ(2, cache.Size());
+
+    // the systems of the optimized parameters are unique to each curve and are not cached
+    cache.Clear();
+    app1.FitCurveOptimal(parms);
+    EXPECT_EQ(1, cache.Size());
+    app2.FitCurveOptimal(parms);
+    EXPECT_EQ(1, cache.Hits());
+    EXPECT_EQ(1, cache.Size());
+}
+
 // tests whether the approximation of a given unit circle is C2 continuous at the closing without interpolating any points
 TEST_F(BSplineInterpolation, approxAndInterpolateContinuous1)
 {
@@ -203,3 +203,48 @@ TEST(CurveNetwork, unorderedCircular)
     EXPECT_NEAR(0.5, vs(1, 1), 1e-10);
     EXPECT_NEAR(1.0, vs(2, 1), 1e-10);
 }
+
+TEST(CurveNetwork, permutation)
+{
+    // the network of unorderedAndReversed
+    std::vector<Handle(Geom_Curve)> profiles(3);
+    std::vector<Handle(Geom_Curve)> guides(3);
+
+    math_Matrix u(0, 2, 0, 2);
+    math_Matrix v(0, 2, 0, 2);
+
+    u(0, 0) = 0.0; u(0, 1) = 0.4; u(0, 2) = 1.0;
+    u(1, 0) = 1.0; u(1, 1) = 0.2; u(1, 2) = 0.0;
+    u(2, 0) = 1.0; u(2, 1) = 0.7; u(2, 2) = 0.0;
+
+    v(0, 0) = 0.5; v(0, 1) = 0.4; v(0, 2) = 0.3;
+    v(1, 0) = 1.0; v(1, 1) = 0.0; v(1, 2) = 0.0;
+    v(2, 0) = 0.0; v(2, 1) = 1.0; v(2, 2) = 1.0;
+
+    occ_gordon_internal::CurveNetworkSorter sorter(profiles, guides, u, v);
+
+    // identity before sorting
+    EXPECT_EQ(std::vector<size_t>({0, 1, 2}), sorter.ProfilePermutation());
+    EXPECT_EQ(std::vector<bool>({false, false, false}), sorter.GuideReversed());
+
+    sorter.Perform();
+
+    EXPECT_EQ(std::vector<size_t>({1, 0, 2}), sorter.ProfilePermutation());
+    EXPECT_EQ(std::vector<bool>({false, true, false}), sorter.ProfileReversed());
+    EXPECT_EQ(std::vector<size_t>({2, 1, 0}), sorter.GuidePermutation());
+    EXPECT_EQ(std::vector<bool>({false, false, true}), sorter.GuideReversed());
+
+    // sorted parameters are the gathered and reversed input parameters
+    math_Matrix us = sorter.ProfileIntersectionParms();
+    math_Matrix vs = sorter.GuideIntersectionParms();
+    for (Standard_Integer k = 0; k < 3; ++k) {
+        for (Standard_Integer l = 0; l < 3; ++l) {
+            Standard_Integer i = static_cast<Standard_Integer>(sorter.ProfilePermutation()[k]);
+            Standard_Integer j = static_cast<Standard_Integer>(sorter.GuidePermutation()[l]);
+            double expectedU = sorter.ProfileReversed()[k] ? 1.0 - u(i, j) : u(i, j);
+            double expectedV = sorter.GuideReversed()[l] ? 1.0 - v(i, j) : v(i, j);
+            EXPECT_NEAR(expectedU, us(k, l), 1e-10);
+            EXPECT_NEAR(expectedV, vs(k, l), 1e-10);
+        }
+    }
+}
@@ -0,0 +1,130 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+*/
+
+#include <gtest/gtest.h>
+
+#include "internal/CurveNetworkClassifier.h"
+#include "internal/Error.h"
+
+#include <TColgp_Array1OfPnt.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+#include <TColStd_Array1OfReal.hxx>
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+// straight line from p1 to p2
+Handle(Geom_BSplineCurve) makeCurve(const gp_Pnt& p1, const gp_Pnt& p2)
+{
+    TColgp_Array1OfPnt poles(1, 3);
+    poles(1) = p1;
+    poles(2) = gp_Pnt(0.5 * (p1.XYZ() + p2.XYZ()));
+    poles(3) = p2;
+
+    TColStd_Array1OfReal knots(1, 2);
+    knots(1) = 0.;
+    knots(2) = 1.;
+    TColStd_Array1OfInteger mults(1, 2);
+    mults(1) = 3;
+    mults(2) = 3;
+
+    return new Geom_BSplineCurve(poles, knots, mults, 2);
+}
+
+// profiles y = i and guides x = j of a grid, scaled by size and the guides lifted by dz.
+// The profiles are at the even positions of the result
+std::vector<Handle(Geom_BSplineCurve)> makeGrid(int nProfiles, int nGuides, double size = 1., double dz = 0.)
+{
+    std::vector<Handle(Geom_BSplineCurve)> profiles, guides, curves;
+    for (int i = 0; i < nProfiles; ++i) {
+        profiles.push_back(makeCurve(gp_Pnt(-0.5 * size, i * size, 0.), gp_Pnt((nGuides - 0.5) * size, i * size, 0.)));
+    }
+    for (int j = 0; j < nGuides; ++j) {
+        guides.push_back(makeCurve(gp_Pnt(j * size, -0.5 * size, dz), gp_Pnt(j * size, (nProfiles - 0.5) * size, dz)));
+    }
+
+    // interleave the families
+    for (size_t k = 0; k < profiles.size() || k < guides.size(); ++k) {
+        if (k < profiles.size()) {
+            curves.push_back(profiles[k]);
+        }
+        if (k < guides.size()) {
+            curves.push_back(guides[k]);
+        }
+    }
+    return curves;
+}
+
+} // namespace
+
+TEST(CurveNetworkClassifier, grid)
+{
+    const int nProfiles = 12, nGuides = 9;
+    std::vector<Handle(Geom_BSplineCurve)> curves = makeGrid(nProfiles, nGuides);
+
+    occ_gordon_internal::CurveNetworkClassifier classifier(curves, 1e-5);
+    classifier.Perform();
+
+    ASSERT_EQ(nProfiles, classifier.ProfileIndices().size());
+    ASSERT_EQ(nGuides, classifier.GuideIndices().size());
+
+    // the first curve is a profile, the profiles are horizontal
+    EXPECT_EQ(0, classifier.ProfileIndices().front());
+    for (size_t idx : classifier.ProfileIndices()) {
+        EXPECT_NEAR(curves[idx]->Pole(1).Y(), curves[idx]->Pole(3).Y(), 1e-10);
+    }
+    for (size_t idx : classifier.GuideIndices()) {
+        EXPECT_NEAR(curves[idx]->Pole(1).X(), curves[idx]->Pole(3).X(), 1e-10);
+    }
+
+    // the boxes of the same family don't overlap, hence each curve except the first one is
+    // colored by a single test, far less than the nProfiles * nGuides intersecting pairs
+    EXPECT_EQ(nProfiles + nGuides - 1, classifier.NIntersectionTests());
+}
+
+TEST(CurveNetworkClassifier, relativeTolerance)
+{
+    // the gap of 0.01 between profiles and guides is small compared to the curve sizes of several 1e3
+    const double size = 1e3;
+    std::vector<Handle(Geom_BSplineCurve)> curves = makeGrid(4, 5, size, 0.01);
+
+    occ_gordon_internal::CurveNetworkClassifier classifier(curves, 1e-5);
+    classifier.Perform();
+    EXPECT_EQ(4, classifier.ProfileIndices().size());
+    EXPECT_EQ(5, classifier.GuideIndices().size());
+
+    // but not compared to the unit sized curves
+    std::vector<Handle(Geom_BSplineCurve)> small = makeGrid(4, 5, 1., 0.01);
+    occ_gordon_internal::CurveNetworkClassifier smallClassifier(small, 1e-5);
+    EXPECT_THROW(smallClassifier.Perform(), occ_gordon_internal::error);
+}
+
+TEST(CurveNetworkClassifier, mutuallyIntersecting)
+{
+    // the diagonal intersects the first profile and the first guide in their intersection,
+    // hence the three curves cannot be split into two families
+    std::vector<Handle(Geom_BSplineCurve)> curves = makeGrid(2, 2);
+    curves.push_back(makeCurve(gp_Pnt(-0.5, -0.5, 0.), gp_Pnt(1.5, 1.5, 0.)));
+
+    occ_gordon_internal::CurveNetworkClassifier classifier(curves, 1e-5);
+    EXPECT_THROW(classifier.Perform(), occ_gordon_internal::error);
+
+    // independent of the order, in which the curves are visited
+    std::reverse(curves.begin(), curves.end());
+    occ_gordon_internal::CurveNetworkClassifier reversed(curves, 1e-5);
+    EXPECT_THROW(reversed.Perform(), occ_gordon_internal::error);
+}
+
+TEST(CurveNetworkClassifier, disconnected)
+{
+    std::vector<Handle(Geom_BSplineCurve)> curves = makeGrid(3, 3);
+    curves.push_back(makeCurve(gp_Pnt(10., 10., 10.), gp_Pnt(11., 10., 10.)));
+
+    occ_gordon_internal::CurveNetworkClassifier classifier(curves, 1e-5);
+    EXPECT_THROW(classifier.Perform(), occ_gordon_internal::error);
+}
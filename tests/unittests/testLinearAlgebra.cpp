@@ -0,0 +1,71 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+#include <gtest/gtest.h>
+
+#include "internal/LinearAlgebra.h"
+
+#include <math_Matrix.hxx>
+#include <math_Vector.hxx>
+
+TEST(LinearAlgebra, solveMultipleRhs)
+{
+    math_Matrix lhs(1, 3, 1, 3);
+    lhs(1, 1) = 4.; lhs(1, 2) = 1.; lhs(1, 3) = 0.;
+    lhs(2, 1) = 1.; lhs(2, 2) = 3.; lhs(2, 3) = 1.;
+    lhs(3, 1) = 0.; lhs(3, 2) = 1.; lhs(3, 3) = 2.;
+
+    math_Matrix expected(1, 3, 1, 2);
+    expected(1, 1) = 1.; expected(1, 2) = -1.;
+    expected(2, 1) = 2.; expected(2, 2) = 0.5;
+    expected(3, 1) = 3.; expected(3, 2) = 2.;
+
+    math_Matrix rhs = lhs * expected;
+
+    occ_gordon_internal::DenseLUSolver solver(lhs);
+    ASSERT_TRUE(solver.IsDone());
+
+    math_Matrix x(1, 3, 1, 2);
+    solver.Solve(rhs, x);
+    for (int i = 1; i <= 3; ++i) {
+        EXPECT_NEAR(expected(i, 1), x(i, 1), 1e-12);
+        EXPECT_NEAR(expected(i, 2), x(i, 2), 1e-12);
+    }
+
+    math_Vector xv(1, 3);
+    solver.Solve(rhs.Col(2), xv);
+    for (int i = 1; i <= 3; ++i) {
+        EXPECT_NEAR(expected(i, 2), xv(i), 1e-12);
+    }
+}
+
+TEST(LinearAlgebra, singularMatrix)
+{
+    math_Matrix lhs(1, 2, 1, 2);
+    lhs(1, 1) = 1.; lhs(1, 2) = 2.;
+    lhs(2, 1) = 2.; lhs(2, 2) = 4.;
+
+    occ_gordon_internal::DenseLUSolver solver(lhs);
+    EXPECT_FALSE(solver.IsDone());
+}
+
+TEST(LinearAlgebra, transposeMultiply)
+{
+    math_Matrix a(1, 3, 1, 2);
+    a(1, 1) = 1.; a(1, 2) = 0.;
+    a(2, 1) = 2.; a(2, 2) = 1.;
+    a(3, 1) = 0.; a(3, 2) = 3.;
+
+    math_Matrix result = occ_gordon_internal::TransposeMultiply(a, a);
+    math_Matrix expected = a.Transposed() * a;
+
+    ASSERT_EQ(2, result.RowNumber());
+    ASSERT_EQ(2, result.ColNumber());
+    for (int i = 1; i <= 2; ++i) {
+        for (int j = 1; j <= 2; ++j) {
+            EXPECT_NEAR(expected(i, j), result(i, j), 1e-14);
+        }
+    }
+}
@@ -0,0 +1,221 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2018 German Aerospace Center (DLR)
+*/
+
+#include <gtest/gtest.h>
+
+#include "internal/SurfaceCache.h"
+
+#include <Geom_BSplineCurve.hxx>
+#include <Geom_BSplineSurface.hxx>
+#include <TColStd_Array1OfInteger.hxx>
+#include <TColStd_Array1OfReal.hxx>
+#include <TColStd_Array2OfReal.hxx>
+#include <TColgp_Array1OfPnt.hxx>
+#include <TColgp_Array2OfPnt.hxx>
+
+#include <chrono>
+#include <filesystem>
+
+namespace
+{
+
+Handle(Geom_BSplineCurve) makeCurve(double z)
+{
+    TColgp_Array1OfPnt poles(1, 4);
+    poles.SetValue(1, gp_Pnt(0., 0., z));
+    poles.SetValue(2, gp_Pnt(1., 2., z));
+    poles.SetValue(3, gp_Pnt(2., -1., z));
+    poles.SetValue(4, gp_Pnt(3., 0., z));
+
+    TColStd_Array1OfReal knots(1, 2);
+    knots.SetValue(1, 0.);
+    knots.SetValue(2, 1.);
+    TColStd_Array1OfInteger mults(1, 2);
+    mults.SetValue(1, 4);
+    mults.SetValue(2, 4);
+
+    return new Geom_BSplineCurve(poles, knots, mults, 3);
+}
+
+Handle(Geom_BSplineSurface) makeSurface(bool rational)
+{
+    TColgp_Array2OfPnt poles(1, 4, 1, 3);
+    TColStd_Array2OfReal weights(1, 4, 1, 3);
+    for (int i = 1; i <= 4; ++i) {
+        for (int j = 1; j <= 3; ++j) {
+            poles.SetValue(i, j, gp_Pnt(i, j, 0.1 * i * j));
+            weights.SetValue(i, j, 1. + 0.25 * ((i + j) % 2));
+        }
+    }
+
+    TColStd_Array1OfReal uKnots(1, 3), vKnots(1, 2);
+    uKnots.SetValue(1, 0.);
+    uKnots.SetValue(2, 0.3);
+    uKnots.SetValue(3, 1.);
+    vKnots.SetValue(1, 0.);
+    vKnots.SetValue(2, 2.);
+
+    TColStd_Array1OfInteger uMults(1, 3), vMults(1, 2);
+    uMults.SetValue(1, 3);
+    uMults.SetValue(2, 1);
+    uMults.SetValue(3, 3);
+    vMults.SetValue(1, 3);
+    vMults.SetValue(2, 3);
+
+    if (rational) {
+        return new Geom_BSplineSurface(poles, weights, uKnots, vKnots, uMults, vMults, 2, 2);
+    }
+    return new Geom_BSplineSurface(poles, uKnots, vKnots, uMults, vMults, 2, 2);
+}
+
+occ_gordon_internal::CacheKey makeKey(double z)
+{
+    occ_gordon_internal::CacheKey key;
+    key.Add(makeCurve(z));
+    key.Add(1e-4);
+    return key;
+}
+
+class SurfaceCacheTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        directory = std::filesystem::temp_directory_path() /
+                    ("occ_gordon_cache_test_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        std::filesystem::remove_all(directory);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(directory);
+    }
+
+    size_t NbFiles() const
+    {
+        size_t n = 0;
+        for (auto it = std::filesystem::directory_iterator(directory); it != std::filesystem::directory_iterator(); ++it) {
+            n++;
+        }
+        return n;
+    }
+
+    std::filesystem::path directory;
+};
+
+} // namespace
+
+TEST(CacheKey, stableAndSensitive)
+{
+    EXPECT_EQ(makeKey(1.).Hex(), makeKey(1.).Hex());
+    EXPECT_EQ(32u, makeKey(1.).Hex().size());
+
+    // a tiny change of a pole changes the key
+    EXPECT_NE(makeKey(1.).Hex(), makeKey(1. + 1e-15).Hex());
+
+    // the order of the inputs matters
+    occ_gordon_internal::CacheKey a, b;
+    a.Add(1);
+    a.Add(2);
+    b.Add(2);
+    b.Add(1);
+    EXPECT_NE(a.Hex(), b.Hex());
+}
+
+TEST_F(SurfaceCacheTest, storeAndLoad)
+{
+    for (bool rational : {false, true}) {
+        occ_gordon_internal::SurfaceCache cache(directory, 0);
+        const occ_gordon_internal::CacheKey key = makeKey(rational ? 2. : 3.);
+
+        occ_gordon_internal::CacheEntry entry;
+        EXPECT_FALSE(cache.Load(key, entry));
+
+        occ_gordon_internal::CacheEntry stored;
+        stored.surface = makeSurface(rational);
+        ASSERT_TRUE(cache.Store(key, stored));
+
+        ASSERT_TRUE(cache.Load(key, entry));
+        const Handle(Geom_BSplineSurface)& surface = entry.surface;
+        ASSERT_FALSE(surface.IsNull());
+        EXPECT_EQ(rational, surface->IsURational() || surface->IsVRational());
+        ASSERT_EQ(stored.surface->NbUPoles(), surface->NbUPoles());
+        ASSERT_EQ(stored.surface->NbVPoles(), surface->NbVPoles());
+        ASSERT_EQ(stored.surface->NbUKnots(), surface->NbUKnots());
+        EXPECT_EQ(stored.surface->UDegree(), surface->UDegree());
+        EXPECT_EQ(stored.surface->VDegree(), surface->VDegree());
+        EXPECT_EQ(stored.surface->UKnot(2), surface->UKnot(2));
+        EXPECT_EQ(stored.surface->VKnot(2), surface->VKnot(2));
+        for (int i = 1; i <= surface->NbUPoles(); ++i) {
+            for (int j = 1; j <= surface->NbVPoles(); ++j) {
+                EXPECT_EQ(0., stored.surface->Pole(i, j).Distance(surface->Pole(i, j)));
+                EXPECT_EQ(stored.surface->Weight(i, j), surface->Weight(i, j));
+            }
+        }
+    }
+
+    // no temporary files are left
+    EXPECT_EQ(2u, NbFiles());
+}
+
+TEST_F(SurfaceCacheTest, corruptEntryIsMiss)
+{
+    occ_gordon_internal::SurfaceCache cache(directory, 0);
+    const occ_gordon_internal::CacheKey key = makeKey(1.);
+
+    occ_gordon_internal::CacheEntry stored;
+    stored.surface = makeSurface(false);
+    ASSERT_TRUE(cache.Store(key, stored));
+
+    // truncate the entry
+    const std::filesystem::path path = cache.EntryPath(key);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+
+    occ_gordon_internal::CacheEntry entry;
+    EXPECT_FALSE(cache.Load(key, entry));
+
+    // an entry renamed to another key is rejected
+    ASSERT_TRUE(cache.Store(key, stored));
+    std::filesystem::copy_file(path, cache.EntryPath(makeKey(2.)));
+    EXPECT_FALSE(cache.Load(makeKey(2.), entry));
+    EXPECT_TRUE(cache.Load(key, entry));
+}
+
+TEST_F(SurfaceCacheTest, sizeLimit)
+{
+    occ_gordon_internal::CacheEntry stored;
+    stored.surface = makeSurface(true);
+
+    // determine the size of one entry
+    uintmax_t entrySize = 0;
+    {
+        occ_gordon_internal::SurfaceCache cache(directory, 0);
+        ASSERT_TRUE(cache.Store(makeKey(0.), stored));
+        entrySize = std::filesystem::file_size(cache.EntryPath(makeKey(0.)));
+        std::filesystem::remove_all(directory);
+    }
+
+    // room for three entries
+    occ_gordon_internal::SurfaceCache cache(directory, static_cast<size_t>(3 * entrySize));
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(cache.Store(makeKey(i), stored));
+
+        // make sure, that the write times differ
+        std::filesystem::last_write_time(cache.EntryPath(makeKey(i)),
+                                         std::filesystem::file_time_type::clock::now() + std::chrono::seconds(i));
+    }
+
+    EXPECT_EQ(3u, NbFiles());
+
+    // the oldest entries have been removed
+    occ_gordon_internal::CacheEntry entry;
+    EXPECT_FALSE(cache.Load(makeKey(0), entry));
+    EXPECT_FALSE(cache.Load(makeKey(1), entry));
+    EXPECT_TRUE(cache.Load(makeKey(4), entry));
+
+    // an entry larger than the limit is not stored
+    occ_gordon_internal::SurfaceCache tinyCache(directory / "tiny", 16);
+    EXPECT_FALSE(tinyCache.Store(makeKey(0.), stored));
+}
@@ -17,15 +17,18 @@
 #include <TColStd_Array1OfReal.hxx>
 #include <TColStd_HArray1OfReal.hxx>
 #include <TColgp_HArray1OfPnt.hxx>
+#include <atomic>
 #include <vector>
 #include <cmath>
 
 #include <internal/BSplineAlgorithms.h>
+#include <internal/BSplineCurveEvaluator.h>
 #include <internal/PointsToBSplineInterpolation.h>
 #include <internal/InterpolateCurveNetwork.h>
 #include <internal/GordonSurfaceBuilder.h>
 #include <internal/CurvesToSurface.h>
 #include <internal/occ_std_adapters.h>
+#include <internal/TaskMonitor.h>
 
 #include <BSplCLib.hxx>
 #include <BRepTools.hxx>
@@ -363,6 +366,48 @@ TEST(BSplineAlgorithms, testCreateCommonKnotsVectorToleranceBug)
     EXPECT_EQ(4, curves[1]->Multiplicity(4));
 }
 
+TEST(BSplineAlgorithms, testCreateCommonKnotsVectorManyCurves)
+{
+    // all curves are refined in one pass to the union of their knots,
+    // using the highest multiplicity of each knot
+    std::vector<Handle(Geom_BSplineCurve)> curves;
+    for (int icurve = 0; icurve < 16; ++icurve) {
+        std::vector<gp_Pnt> poles;
+        for (int ipole = 0; ipole < 5; ++ipole) {
+            poles.push_back(gp_Pnt(ipole, std::sin(ipole + 0.3 * icurve), 0.1 * icurve));
+        }
+        double knot = 0.05 + 0.05 * icurve;
+        curves.push_back(createBSpline(poles, {0., 0., 0., 0., knot, 1., 1., 1., 1.}, 3));
+    }
+    // a knot with a higher multiplicity
+    curves[3]->InsertKnot(0.2, 2);
+
+    std::vector<Handle(Geom_BSplineCurve)> result = BSplineAlgorithms::createCommonKnotsVectorCurve(curves, 1e-10);
+    ASSERT_EQ(curves.size(), result.size());
+
+    const Handle(Geom_BSplineCurve)& first = result.front();
+    ASSERT_EQ(18, first->NbKnots());
+    for (int iknot = 2; iknot < first->NbKnots(); ++iknot) {
+        EXPECT_NEAR(0.05 * (iknot - 1), first->Knot(iknot), 1e-14);
+        EXPECT_EQ(std::abs(first->Knot(iknot) - 0.2) < 1e-10 ? 3 : 1, first->Multiplicity(iknot));
+    }
+
+    for (size_t icurve = 0; icurve < result.size(); ++icurve) {
+        ASSERT_EQ(first->NbKnots(), result[icurve]->NbKnots());
+        ASSERT_EQ(first->NbPoles(), result[icurve]->NbPoles());
+        for (int iknot = 1; iknot <= first->NbKnots(); ++iknot) {
+            EXPECT_EQ(first->Knot(iknot), result[icurve]->Knot(iknot));
+            EXPECT_EQ(first->Multiplicity(iknot), result[icurve]->Multiplicity(iknot));
+        }
+
+        // the refinement keeps the geometry
+        for (int i = 0; i <= 20; ++i) {
+            double t = i / 20.;
+            EXPECT_NEAR(0., curves[icurve]->Value(t).Distance(result[icurve]->Value(t)), 1e-12);
+        }
+    }
+}
+
 TEST(BSplineAlgorithms, testCreateCommonKnotsVectorSurface)
 {
     // tests the method createCommonKnotsVectorSurface
@@ -665,6 +710,150 @@ TEST(BSplineAlgorithms, testReparametrizeBSplineContinuouslyApproxWithKink)
     EXPECT_EQ(3, splineRepar->Multiplicity(3));
 }
 
+TEST(BSplineAlgorithms, testReparametrizeBSplineExact)
+{
+    unsigned int degree = 3;
+
+    TColgp_Array1OfPnt controlPoints(1, 8);
+    controlPoints(1) = gp_Pnt(0., -1., 0.);
+    controlPoints(2) = gp_Pnt(2., 3., 1.);
+    controlPoints(3) = gp_Pnt(1., 5., -2.);
+    controlPoints(4) = gp_Pnt(2., 8., -1.);
+    controlPoints(5) = gp_Pnt(0., 10., 2.);
+    controlPoints(6) = gp_Pnt(-1., 12., 4.);
+    controlPoints(7) = gp_Pnt(-2., 16., 5.);
+    controlPoints(8) = gp_Pnt(0., 17., 0.);
+
+    TColStd_Array1OfReal knots(1, 5);
+    knots(1) = 0.;
+    knots(2) = 0.1;
+    knots(3) = 0.3;
+    knots(4) = 0.8;
+    knots(5) = 1.;
+
+    TColStd_Array1OfInteger mults(1, 5);
+    mults(1) = 4;
+    mults(2) = 1;
+    mults(3) = 2;
+    mults(4) = 1;
+    mults(5) = 4;
+
+    Handle(Geom_BSplineCurve) spline = new Geom_BSplineCurve(controlPoints, knots, mults, degree);
+
+    std::vector<double> old_parameters = {0., 0.2, 0.4, 0.5, 0.6, 0.8, 1.};
+    std::vector<double> new_parameters = {0., 0.1, 0.2, 0.3, 0.7, 0.95, 1.};
+
+    ApproxResult result = BSplineAlgorithms::reparametrizeBSplineExact(spline, old_parameters, new_parameters);
+    Handle(Geom_BSplineCurve) reparam_spline = result.curve;
+    EXPECT_EQ(0., result.error);
+    EXPECT_EQ(spline->Degree(), reparam_spline->Degree());
+
+    // the composition with the piecewise linear function is exact
+    for (size_t iseg = 0; iseg + 1 < old_parameters.size(); ++iseg) {
+        for (int i = 0; i <= 10; ++i) {
+            double s = i / 10.;
+            double old_param = old_parameters[iseg] + s * (old_parameters[iseg + 1] - old_parameters[iseg]);
+            double new_param = new_parameters[iseg] + s * (new_parameters[iseg + 1] - new_parameters[iseg]);
+            EXPECT_NEAR(0., spline->Value(old_param).Distance(reparam_spline->Value(new_param)), 1e-10);
+        }
+    }
+
+    // an identical reparametrization allows to remove all knots at the joints
+    ApproxResult identity = BSplineAlgorithms::reparametrizeBSplineExact(spline, old_parameters, old_parameters, 1e-10);
+    EXPECT_EQ(spline->NbPoles(), identity.curve->NbPoles());
+    EXPECT_EQ(spline->NbKnots(), identity.curve->NbKnots());
+
+    // nearly linear reparametrization: the joints are reduced to at least C1 within the tolerance
+    std::vector<double> perturbed = {0., 0.2, 0.40002, 0.5, 0.6, 0.8, 1.};
+    const double tol = 1e-4 * BSplineAlgorithms::scale(spline);
+    ApproxResult smooth = BSplineAlgorithms::reparametrizeBSplineExact(spline, old_parameters, perturbed, tol);
+    EXPECT_LE(smooth.error, tol);
+    for (size_t ipar = 1; ipar + 1 < perturbed.size(); ++ipar) {
+        for (int iknot = 2; iknot < smooth.curve->NbKnots(); ++iknot) {
+            if (std::abs(smooth.curve->Knot(iknot) - perturbed[ipar]) < 1e-14) {
+                EXPECT_LT(smooth.curve->Multiplicity(iknot), smooth.curve->Degree());
+            }
+        }
+    }
+    for (size_t iseg = 0; iseg + 1 < old_parameters.size(); ++iseg) {
+        for (int i = 0; i <= 10; ++i) {
+            double s = i / 10.;
+            double old_param = old_parameters[iseg] + s * (old_parameters[iseg + 1] - old_parameters[iseg]);
+            double new_param = perturbed[iseg] + s * (perturbed[iseg + 1] - perturbed[iseg]);
+            EXPECT_NEAR(0., spline->Value(old_param).Distance(smooth.curve->Value(new_param)), tol);
+        }
+    }
+
+    // parameters must be ascending
+    std::vector<double> unsorted = {0., 0.4, 0.2, 0.5, 0.6, 0.8, 1.};
+    EXPECT_THROW(BSplineAlgorithms::reparametrizeBSplineExact(spline, unsorted, new_parameters), occ_gordon_internal::error);
+}
+
+TEST(BSplineAlgorithms, testRemoveSurfaceKnots)
+{
+    TColgp_Array2OfPnt controlPoints(1, 4, 1, 3);
+    controlPoints(1, 1) = gp_Pnt(0., 0., 0.);
+    controlPoints(2, 1) = gp_Pnt(1., 1., 0.);
+    controlPoints(3, 1) = gp_Pnt(3., -1., 0.);
+    controlPoints(4, 1) = gp_Pnt(4., 0., 0.);
+    controlPoints(1, 2) = gp_Pnt(0., 1., 0.);
+    controlPoints(2, 2) = gp_Pnt(1., 0., 0.);
+    controlPoints(3, 2) = gp_Pnt(4., -1., 0.);
+    controlPoints(4, 2) = gp_Pnt(5., 0., 0.);
+    controlPoints(1, 3) = gp_Pnt(0., 0., -1.);
+    controlPoints(2, 3) = gp_Pnt(2., 1., 0.);
+    controlPoints(3, 3) = gp_Pnt(3., -2., 0.);
+    controlPoints(4, 3) = gp_Pnt(8., 0., 0.);
+
+    TColStd_Array1OfReal knots_u(1, 2);
+    knots_u(1) = 0.;
+    knots_u(2) = 1.;
+
+    TColStd_Array1OfInteger mults_u(1, 2);
+    mults_u(1) = 4;
+    mults_u(2) = 4;
+
+    TColStd_Array1OfReal knots_v(1, 2);
+    knots_v(1) = 0.;
+    knots_v(2) = 1.;
+
+    TColStd_Array1OfInteger mults_v(1, 2);
+    mults_v(1) = 3;
+    mults_v(2) = 3;
+
+    Handle(Geom_BSplineSurface) surface = new Geom_BSplineSurface(controlPoints, knots_u, knots_v, mults_u, mults_v, 3, 2);
+
+    // refine the surface without changing its geometry
+    Handle(Geom_BSplineSurface) refined = Handle(Geom_BSplineSurface)::DownCast(surface->Copy());
+    refined->InsertUKnot(0.3, 2, 1e-15);
+    refined->InsertUKnot(0.6, 1, 1e-15);
+    refined->InsertVKnot(0.5, 1, 1e-15);
+    ASSERT_EQ(7 * 4, refined->NbUPoles() * refined->NbVPoles());
+
+    // no reduction without tolerance
+    BSplineAlgorithms::SurfaceKnotRemovalResult unchanged = BSplineAlgorithms::removeSurfaceKnots(refined, 0.);
+    EXPECT_EQ(28, unchanged.nPolesBefore);
+    EXPECT_EQ(28, unchanged.nPolesAfter);
+    EXPECT_EQ(0., unchanged.maxDeviation);
+    EXPECT_TRUE(unchanged.surface == refined);
+
+    // all inserted knots can be removed again
+    BSplineAlgorithms::SurfaceKnotRemovalResult result = BSplineAlgorithms::removeSurfaceKnots(refined, 1e-6);
+    EXPECT_EQ(28, result.nPolesBefore);
+    EXPECT_EQ(12, result.nPolesAfter);
+    EXPECT_EQ(12, result.surface->NbUPoles() * result.surface->NbVPoles());
+    EXPECT_LT(result.maxDeviation, 1e-6);
+
+    // the input surface is not modified
+    EXPECT_EQ(28, refined->NbUPoles() * refined->NbVPoles());
+
+    for (int i = 0; i <= 10; ++i) {
+        for (int j = 0; j <= 10; ++j) {
+            double u = i / 10., v = j / 10.;
+            EXPECT_NEAR(0., surface->Value(u, v).Distance(result.surface->Value(u, v)), 1e-6);
+        }
+    }
+}
 
 TEST(BSplineAlgorithms, reparametrizeBSpline)
 {
@@ -1353,6 +1542,80 @@ TEST(BSplineAlgorithms, findKinks)
     EXPECT_NEAR(0.7, kinks[0], 1e-10);
 }
 
+TEST(BSplineAlgorithms, evaluateCurveSorted)
+{
+    std::vector<gp_Pnt> poles = {gp_Pnt(0, 0, 0), gp_Pnt(1, 3, 0), gp_Pnt(2, 2, 1), gp_Pnt(3, 5, 0),
+                                 gp_Pnt(4, -1, 2), gp_Pnt(5, 3, 0), gp_Pnt(6, -3, 1)};
+    std::vector<double> knots = {0., 0., 0., 0., 0.25, 0.5, 0.5, 1., 1., 1., 1.};
+    Handle(Geom_BSplineCurve) curve = createBSpline(poles, knots, 3);
+
+    // sorted parameters followed by an unsorted tail
+    std::vector<double> params;
+    for (int i = 0; i <= 100; ++i) {
+        params.push_back(i / 100.);
+    }
+    params.push_back(0.3);
+    params.push_back(0.1);
+
+    std::vector<gp_XYZ> points = BSplineAlgorithms::evaluateCurveSorted(curve, params);
+    std::vector<gp_XYZ> derivs = BSplineAlgorithms::evaluateCurveSorted(curve, params, 1);
+    ASSERT_EQ(params.size(), points.size());
+    ASSERT_EQ(params.size(), derivs.size());
+
+    for (size_t i = 0; i < params.size(); ++i) {
+        EXPECT_NEAR(0., (curve->Value(params[i]).XYZ() - points[i]).Modulus(), 1e-12);
+        if (std::abs(params[i] - 0.5) > 1e-12) {
+            EXPECT_NEAR(0., (curve->DN(params[i], 1).XYZ() - derivs[i]).Modulus(), 1e-10);
+        }
+    }
+}
+
+TEST(BSplineAlgorithms, evaluateCurvesSorted)
+{
+    std::vector<double> knots = {0., 0., 0., 0., 0.25, 0.5, 0.5, 1., 1., 1., 1.};
+
+    std::vector<Handle(Geom_BSplineCurve)> curves;
+    for (int icurve = 0; icurve < 4; ++icurve) {
+        std::vector<gp_Pnt> poles;
+        for (int ipole = 0; ipole < 7; ++ipole) {
+            poles.push_back(gp_Pnt(ipole, std::sin(ipole + icurve), icurve));
+        }
+        curves.push_back(createBSpline(poles, knots, 3));
+    }
+
+    // make one curve rational, the knots are still shared
+    curves[2] = Handle(Geom_BSplineCurve)::DownCast(curves[2]->Copy());
+    curves[2]->SetWeight(3, 2.);
+    EXPECT_TRUE(occ_gordon_internal::MultiCurveEvaluator::HaveCommonKnots(curves));
+
+    std::vector<double> params;
+    for (int i = 0; i <= 50; ++i) {
+        params.push_back(i / 50.);
+    }
+
+    std::vector<gp_XYZ> points = BSplineAlgorithms::evaluateCurvesSorted(curves, params);
+    ASSERT_EQ(params.size() * curves.size(), points.size());
+    for (size_t iparam = 0; iparam < params.size(); ++iparam) {
+        for (size_t icurve = 0; icurve < curves.size(); ++icurve) {
+            gp_XYZ expected = curves[icurve]->Value(params[iparam]).XYZ();
+            EXPECT_NEAR(0., (expected - points[iparam * curves.size() + icurve]).Modulus(), 1e-12);
+        }
+    }
+
+    // curves with different knots are evaluated separately
+    curves[1] = Handle(Geom_BSplineCurve)::DownCast(curves[1]->Copy());
+    curves[1]->InsertKnot(0.75);
+    EXPECT_FALSE(occ_gordon_internal::MultiCurveEvaluator::HaveCommonKnots(curves));
+    EXPECT_THROW(occ_gordon_internal::MultiCurveEvaluator evaluator(curves), occ_gordon_internal::error);
+
+    points = BSplineAlgorithms::evaluateCurvesSorted(curves, params);
+    ASSERT_EQ(params.size() * curves.size(), points.size());
+    for (size_t iparam = 0; iparam < params.size(); ++iparam) {
+        gp_XYZ expected = curves[1]->Value(params[iparam]).XYZ();
+        EXPECT_NEAR(0., (expected - points[iparam * curves.size() + 1]).Modulus(), 1e-12);
+    }
+}
+
 
 TEST(BSplineAlgorithms, knotsFromParams)
 {
@@ -1522,6 +1785,113 @@ TEST_P(GordonSurface, testFromBRep)
     BRepTools::Write(BRepBuilderAPI_MakeFace(gordonSurface, Precision::Confusion()), path_output.c_str());
 }
 
+TEST_P(GordonSurface, testAdaptiveReparametrization)
+{
+    // reference with the fixed number of control points
+    InterpolateCurveNetwork reference(splines_u_vector, splines_v_vector, 3e-4);
+    double referenceError = 0.;
+    for (double err : reference.ReparametrizationErrorsProfiles()) {
+        referenceError = std::max(referenceError, err);
+    }
+    for (double err : reference.ReparametrizationErrorsGuides()) {
+        referenceError = std::max(referenceError, err);
+    }
+
+    // a looser tolerance than the fixed rule achieves must be met with fewer poles
+    const double tolerance = std::max(10. * referenceError, 1e-6);
+    InterpolateCurveNetwork interpolator(splines_u_vector, splines_v_vector, 3e-4);
+    interpolator.SetReparametrizationTolerance(tolerance);
+
+    Handle(Geom_BSplineSurface) gordonSurface = interpolator.Surface();
+    ASSERT_FALSE(gordonSurface.IsNull());
+
+    std::vector<double> profileErrors = interpolator.ReparametrizationErrorsProfiles();
+    std::vector<double> guideErrors = interpolator.ReparametrizationErrorsGuides();
+    EXPECT_EQ(interpolator.ParametersProfiles().size(), profileErrors.size());
+    EXPECT_EQ(interpolator.ParametersGuides().size(), guideErrors.size());
+
+    for (double err : profileErrors) {
+        EXPECT_GE(err, 0.);
+        EXPECT_LE(err, tolerance);
+    }
+    for (double err : guideErrors) {
+        EXPECT_GE(err, 0.);
+        EXPECT_LE(err, tolerance);
+    }
+
+    // fewer control points result in fewer poles of the gordon surface
+    Handle(Geom_BSplineSurface) referenceSurface = reference.Surface();
+    EXPECT_LT(gordonSurface->NbUPoles() * gordonSurface->NbVPoles(),
+              referenceSurface->NbUPoles() * referenceSurface->NbVPoles());
+
+    // the search is bounded by the control point limits. If the tolerance cannot be
+    // reached, the result equals the fixed rule with the maximum number of control points
+    InterpolateCurveNetwork limited(splines_u_vector, splines_v_vector, 3e-4);
+    limited.SetControlPointLimits(10, 20);
+    limited.SetReparametrizationTolerance(1e-300);
+    InterpolateCurveNetwork fixed(splines_u_vector, splines_v_vector, 3e-4);
+    fixed.SetControlPointLimits(20, 20);
+
+    std::vector<double> limitedErrors = limited.ReparametrizationErrorsProfiles();
+    std::vector<double> fixedErrors = fixed.ReparametrizationErrorsProfiles();
+    ASSERT_EQ(fixedErrors.size(), limitedErrors.size());
+    for (size_t i = 0; i < fixedErrors.size(); ++i) {
+        EXPECT_NEAR(fixedErrors[i], limitedErrors[i], 1e-10);
+    }
+    limitedErrors = limited.ReparametrizationErrorsGuides();
+    fixedErrors = fixed.ReparametrizationErrorsGuides();
+    ASSERT_EQ(fixedErrors.size(), limitedErrors.size());
+    for (size_t i = 0; i < fixedErrors.size(); ++i) {
+        EXPECT_NEAR(fixedErrors[i], limitedErrors[i], 1e-10);
+    }
+}
+
+TEST_P(GordonSurface, testKnotRemoval)
+{
+    InterpolateCurveNetwork interpolator(splines_u_vector, splines_v_vector, 3e-4);
+    interpolator.SetKnotRemovalTolerance(1e-4);
+
+    Handle(Geom_BSplineSurface) gordonSurface = interpolator.Surface();
+    ASSERT_FALSE(gordonSurface.IsNull());
+
+    BSplineAlgorithms::SurfaceKnotRemovalResult stats = interpolator.KnotRemovalStatistics();
+    EXPECT_LE(stats.nPolesAfter, stats.nPolesBefore);
+    EXPECT_EQ(gordonSurface->NbUPoles() * gordonSurface->NbVPoles(), stats.nPolesAfter);
+    EXPECT_LE(stats.maxDeviation, 1e-4);
+}
+
+TEST_P(GordonSurface, testDeviations)
+{
+    InterpolateCurveNetwork interpolator(splines_u_vector, splines_v_vector, 3e-4);
+
+    std::vector<CurveDeviation> profileDeviations = interpolator.DeviationsProfiles();
+    std::vector<CurveDeviation> guideDeviations = interpolator.DeviationsGuides();
+    std::vector<double> profileParams = interpolator.ParametersProfiles();
+    std::vector<double> guideParams = interpolator.ParametersGuides();
+    std::vector<double> profileErrors = interpolator.ReparametrizationErrorsProfiles();
+    std::vector<double> guideErrors = interpolator.ReparametrizationErrorsGuides();
+
+    ASSERT_EQ(profileParams.size(), profileDeviations.size());
+    ASSERT_EQ(guideParams.size(), guideDeviations.size());
+
+    // the surface interpolates the reparametrized curves, the knot reduction
+    // of EnsureC2 may add a deviation up to the spatial tolerance
+    for (size_t i = 0; i < profileDeviations.size(); ++i) {
+        EXPECT_LT(profileDeviations[i].inputIndex, splines_u_vector.size());
+        EXPECT_EQ(profileParams[i], profileDeviations[i].parameter);
+        EXPECT_LE(profileDeviations[i].rmsDeviation, profileDeviations[i].maxDeviation);
+        EXPECT_LE(profileDeviations[i].maxDeviation, 2. * profileErrors[i] + 3e-4);
+    }
+    for (size_t i = 0; i < guideDeviations.size(); ++i) {
+        EXPECT_LT(guideDeviations[i].inputIndex, splines_v_vector.size());
+        EXPECT_EQ(guideParams[i], guideDeviations[i].parameter);
+        EXPECT_LE(guideDeviations[i].rmsDeviation, guideDeviations[i].maxDeviation);
+        EXPECT_LE(guideDeviations[i].maxDeviation, 2. * guideErrors[i] + 3e-4);
+    }
+
+    EXPECT_THROW(interpolator.DeviationsProfiles(1), occ_gordon_internal::error);
+}
+
 TEST_P(GordonSurface, testIntersectionRegressions)
 {
     math_Matrix intersection_params_u(0, splines_u_vector.size() - 1,
@@ -1604,6 +1974,206 @@ TEST_P(GordonSurface, testIntersectionRegressions)
 }
 
 
+namespace
+{
+
+// Iso-curves of a wavy B-spline surface, which form an open curve network
+void isoCurveNetwork(size_t nProfiles, size_t nGuides,
+                     std::vector<Handle(Geom_BSplineCurve)>& profiles, std::vector<Handle(Geom_BSplineCurve)>& guides)
+{
+    const int nPoles = 8;
+    TColgp_Array2OfPnt poles(1, nPoles, 1, nPoles);
+    for (int i = 1; i <= nPoles; ++i) {
+        for (int j = 1; j <= nPoles; ++j) {
+            poles(i, j) = gp_Pnt(i, j, 0.5 * std::sin(1.3 * i) * std::cos(0.9 * j));
+        }
+    }
+
+    std::vector<double> knots = {0., 0.2, 0.4, 0.6, 0.8, 1.};
+    std::vector<int> mults = {4, 1, 1, 1, 1, 4};
+    Handle(Geom_BSplineSurface) surface = new Geom_BSplineSurface(poles, OccFArray(knots)->Array1(), OccFArray(knots)->Array1(),
+                                                                  OccIArray(mults)->Array1(), OccIArray(mults)->Array1(), 3, 3);
+
+    for (size_t iprofile = 0; iprofile < nProfiles; ++iprofile) {
+        double v = static_cast<double>(iprofile) / static_cast<double>(nProfiles - 1);
+        profiles.push_back(Handle(Geom_BSplineCurve)::DownCast(surface->VIso(v)));
+    }
+    for (size_t iguide = 0; iguide < nGuides; ++iguide) {
+        double u = static_cast<double>(iguide) / static_cast<double>(nGuides - 1);
+        guides.push_back(Handle(Geom_BSplineCurve)::DownCast(surface->UIso(u)));
+    }
+}
+
+} // namespace
+
+TEST(BSplineAlgorithms, testGordonSurfaceTargetDegree)
+{
+    // enough curves: all component surfaces are interpolated at the curve degree directly
+    std::vector<Handle(Geom_BSplineCurve)> profiles, guides;
+    isoCurveNetwork(5, 6, profiles, guides);
+
+    std::vector<double> paramsOnProfiles, paramsOnGuides;
+    for (size_t iguide = 0; iguide < guides.size(); ++iguide) {
+        paramsOnProfiles.push_back(static_cast<double>(iguide) / static_cast<double>(guides.size() - 1));
+    }
+    for (size_t iprofile = 0; iprofile < profiles.size(); ++iprofile) {
+        paramsOnGuides.push_back(static_cast<double>(iprofile) / static_cast<double>(profiles.size() - 1));
+    }
+
+    GordonSurfaceBuilder builder(profiles, guides, paramsOnProfiles, paramsOnGuides, 1e-4);
+    Handle(Geom_BSplineSurface) gordon = builder.SurfaceGordon();
+    EXPECT_FALSE(builder.DegreeElevated());
+    for (const Handle(Geom_BSplineSurface)& surface : {gordon, builder.SurfaceProfiles(), builder.SurfaceGuides(), builder.SurfaceIntersections()}) {
+        EXPECT_EQ(3, surface->UDegree());
+        EXPECT_EQ(3, surface->VDegree());
+    }
+
+    // without elevation of the full surfaces, the gordon surface stays C2 at the knots of the skinning
+    for (int iknot = 2; iknot < gordon->NbUKnots(); ++iknot) {
+        EXPECT_EQ(1, gordon->UMultiplicity(iknot));
+    }
+    for (int iknot = 2; iknot < gordon->NbVKnots(); ++iknot) {
+        EXPECT_EQ(1, gordon->VMultiplicity(iknot));
+    }
+
+    for (size_t iprofile = 0; iprofile < profiles.size(); ++iprofile) {
+        for (int i = 0; i <= 10; ++i) {
+            const double u = i / 10.;
+            EXPECT_NEAR(0., profiles[iprofile]->Value(u).Distance(gordon->Value(u, paramsOnGuides[iprofile])), 1e-8);
+        }
+    }
+
+    // three guides can only be skinned quadratically, hence the surfaces must be elevated
+    profiles.clear();
+    guides.clear();
+    isoCurveNetwork(5, 3, profiles, guides);
+    paramsOnProfiles = {0., 0.5, 1.};
+
+    GordonSurfaceBuilder fallback(profiles, guides, paramsOnProfiles, paramsOnGuides, 1e-4);
+    Handle(Geom_BSplineSurface) elevated = fallback.SurfaceGordon();
+    EXPECT_TRUE(fallback.DegreeElevated());
+    EXPECT_EQ(3, elevated->UDegree());
+    EXPECT_EQ(3, elevated->VDegree());
+}
+
+TEST(BSplineAlgorithms, testBlockDecomposition)
+{
+    std::vector<Handle(Geom_BSplineCurve)> profiles, guides;
+    isoCurveNetwork(12, 10, profiles, guides);
+
+    InterpolateCurveNetwork interpolator(profiles, guides, 1e-4);
+    EXPECT_THROW(interpolator.SetBlockDecomposition(1, 2), occ_gordon_internal::error);
+    EXPECT_THROW(interpolator.SetBlockDecomposition(5, 0), occ_gordon_internal::error);
+    interpolator.SetBlockDecomposition(5, 2);
+
+    // the exact reparametrization is rejected in any order of the settings
+    EXPECT_THROW(interpolator.SetReparametrizationMode(ReparametrizationMode::ExactComposition), occ_gordon_internal::error);
+    InterpolateCurveNetwork exact(profiles, guides, 1e-4);
+    exact.SetReparametrizationMode(ReparametrizationMode::ExactComposition);
+    EXPECT_THROW(exact.SetBlockDecomposition(5, 2), occ_gordon_internal::error);
+
+    Handle(Geom_BSplineSurface) surface = interpolator.Surface();
+    ASSERT_FALSE(surface.IsNull());
+    EXPECT_TRUE(interpolator.SurfaceProfiles().IsNull());
+
+    // 9 intervals between the guides and 11 between the profiles, at most 4 per block
+    const size_t nU = interpolator.NumberOfPatchesU();
+    const size_t nV = interpolator.NumberOfPatchesV();
+    EXPECT_EQ(3u, nU);
+    EXPECT_EQ(3u, nV);
+    std::vector<Handle(Geom_BSplineSurface)> patches = interpolator.Patches();
+    ASSERT_EQ(nU * nV, patches.size());
+
+    // the iso network is smooth, hence all seams are joined with C1 continuity
+    EXPECT_EQ(std::vector<int>(nU - 1, 1), interpolator.SeamContinuityU());
+    EXPECT_EQ(std::vector<int>(nV - 1, 1), interpolator.SeamContinuityV());
+
+    // the merged surface still interpolates the network. The deviations are measured with the
+    // reparametrization of each block, hence they don't exceed the reparametrization errors
+    // by more than the joins of the patches and the knot reduction of the seams, both within the scaled tolerance.
+    const double tolerance = 1e-4 * std::max(BSplineAlgorithms::scale(profiles), BSplineAlgorithms::scale(guides));
+    const std::vector<CurveDeviation> profileDeviations = interpolator.DeviationsProfiles();
+    const std::vector<double> profileErrors = interpolator.ReparametrizationErrorsProfiles();
+    ASSERT_EQ(profileErrors.size(), profileDeviations.size());
+    for (size_t iprofile = 0; iprofile < profileDeviations.size(); ++iprofile) {
+        EXPECT_LT(profileDeviations[iprofile].maxDeviation, 1e-3);
+        EXPECT_LE(profileDeviations[iprofile].maxDeviation, profileErrors[iprofile] + 2. * tolerance);
+    }
+    const std::vector<CurveDeviation> guideDeviations = interpolator.DeviationsGuides();
+    const std::vector<double> guideErrors = interpolator.ReparametrizationErrorsGuides();
+    ASSERT_EQ(guideErrors.size(), guideDeviations.size());
+    for (size_t iguide = 0; iguide < guideDeviations.size(); ++iguide) {
+        EXPECT_LT(guideDeviations[iguide].maxDeviation, 1e-3);
+        EXPECT_LE(guideDeviations[iguide].maxDeviation, guideErrors[iguide] + 2. * tolerance);
+    }
+
+    // the patches join with C1 continuity and coincide with the merged surface
+    for (size_t i = 0; i < nU; ++i) {
+        for (size_t j = 0; j < nV; ++j) {
+            const Handle(Geom_BSplineSurface)& patch = patches[i * nV + j];
+            double u1 = 0., u2 = 0., v1 = 0., v2 = 0.;
+            patch->Bounds(u1, u2, v1, v2);
+            EXPECT_NEAR(0., patch->Value(0.5 * (u1 + u2), 0.5 * (v1 + v2)).Distance(surface->Value(0.5 * (u1 + u2), 0.5 * (v1 + v2))), 1e-4);
+
+            for (int k = 0; k <= 4; ++k) {
+                gp_Pnt p1, p2;
+                gp_Vec du1, dv1, du2, dv2;
+                if (i + 1 < nU) {
+                    const double v = v1 + 0.25 * k * (v2 - v1);
+                    patch->D1(u2, v, p1, du1, dv1);
+                    patches[(i + 1) * nV + j]->D1(u2, v, p2, du2, dv2);
+                    EXPECT_NEAR(0., p1.Distance(p2), 1e-10);
+                    EXPECT_NEAR(0., (du1 - du2).Magnitude(), 1e-8 * (1. + du1.Magnitude()));
+                }
+                if (j + 1 < nV) {
+                    const double u = u1 + 0.25 * k * (u2 - u1);
+                    patch->D1(u, v2, p1, du1, dv1);
+                    patches[i * nV + j + 1]->D1(u, v2, p2, du2, dv2);
+                    EXPECT_NEAR(0., p1.Distance(p2), 1e-10);
+                    EXPECT_NEAR(0., (dv1 - dv2).Magnitude(), 1e-8 * (1. + dv1.Magnitude()));
+                }
+            }
+        }
+    }
+}
+
+
+TEST(BSplineAlgorithms, testBlockDecompositionCancel)
+{
+    std::vector<Handle(Geom_BSplineCurve)> profiles, guides;
+    isoCurveNetwork(12, 10, profiles, guides);
+
+    // cancels as soon as the patches are interpolated and counts the checks of the workers
+    std::atomic<bool> inPatches(false);
+    std::atomic<int> nChecks(0);
+    TaskMonitor monitor([&inPatches](double, const std::string& stage) {
+                            if (stage == "patches") {
+                                inPatches = true;
+                            }
+                        },
+                        [&inPatches, &nChecks]() {
+                            if (inPatches) {
+                                ++nChecks;
+                            }
+                            return inPatches.load();
+                        });
+
+    InterpolateCurveNetwork interpolator(profiles, guides, 1e-4);
+    interpolator.SetBlockDecomposition(5, 2);
+    interpolator.SetTaskMonitor(&monitor);
+
+    try {
+        interpolator.Surface();
+        FAIL() << "The interpolation has not been cancelled";
+    }
+    catch (const occ_gordon_internal::error& err) {
+        EXPECT_EQ(CANCELLED, err.get_code());
+    }
+
+    // each of the 3 x 3 blocks checks once, the merge of the patches is not reached
+    EXPECT_EQ(9, nChecks.load());
+}
+
 INSTANTIATE_TEST_SUITE_P(BSplineAlgorithms, GordonSurface, ::testing::Values(
                             "nacelle",
                             "full_nacelle",
@@ -1619,5 +2189,43 @@ INSTANTIATE_TEST_SUITE_P(BSplineAlgorithms, GordonSurface, ::testing::Values(
                             "ffd"
                             ));
 
+// Real networks, whose blocks don't join tangentially by construction
+class GordonSurfaceBlocks : public GordonSurface
+{
+};
+
+TEST_P(GordonSurfaceBlocks, testSeamDeviation)
+{
+    InterpolateCurveNetwork interpolator(splines_u_vector, splines_v_vector, 3e-4);
+    interpolator.SetBlockDecomposition(3, 1);
+
+    Handle(Geom_BSplineSurface) surface = interpolator.Surface();
+    ASSERT_FALSE(surface.IsNull());
+    ASSERT_GT(interpolator.NumberOfPatchesU() * interpolator.NumberOfPatchesV(), 1u);
+
+    // The joins move the patches by at most the scaled tolerance, the knot reductions
+    // of the blocks and the seams by at most the unscaled tolerance each
+    const double tolerance = 3e-4 * std::max(BSplineAlgorithms::scale(BSplineAlgorithms::toBSplines(splines_u_vector)),
+                                             BSplineAlgorithms::scale(BSplineAlgorithms::toBSplines(splines_v_vector)));
+
+    const std::vector<CurveDeviation> profileDeviations = interpolator.DeviationsProfiles();
+    const std::vector<double> profileErrors = interpolator.ReparametrizationErrorsProfiles();
+    ASSERT_EQ(profileErrors.size(), profileDeviations.size());
+    for (size_t iprofile = 0; iprofile < profileDeviations.size(); ++iprofile) {
+        EXPECT_LE(profileDeviations[iprofile].maxDeviation, profileErrors[iprofile] + tolerance + 2 * 3e-4);
+    }
+
+    const std::vector<CurveDeviation> guideDeviations = interpolator.DeviationsGuides();
+    const std::vector<double> guideErrors = interpolator.ReparametrizationErrorsGuides();
+    ASSERT_EQ(guideErrors.size(), guideDeviations.size());
+    for (size_t iguide = 0; iguide < guideDeviations.size(); ++iguide) {
+        EXPECT_LE(guideDeviations[iguide].maxDeviation, guideErrors[iguide] + tolerance + 2 * 3e-4);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(BSplineAlgorithms, GordonSurfaceBlocks, ::testing::Values(
+                            "wing2"
+                            ));
+
 
 } // namespace occ_gordon_internal
@@ -0,0 +1,439 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+*/
+
+/*
+ * Interpolates the curve networks of a manifest and reports timings as JSON.
+ *
+ *     occ_gordon [options] <manifest>
+ *
+ * Each line of the manifest describes one network by a name and either the
+ * profile and guide files (BRep) or a single binary network file (.ogb):
+ *
+ *     # name    files
+ *     wing      wing/profiles.brep wing/guides.brep
+ *     nacelle   nacelle/network.ogb
+ *
+ * Relative paths are relative to the manifest. Empty lines and lines starting
+ * with # are ignored.
+ */
+
+#include <occ_gordon/io.h>
+#include <occ_gordon/occ_gordon.h>
+
+#include <BRepBuilderAPI_MakeFace.hxx>
+#include <BRepTools.hxx>
+#include <Precision.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::time_point begin, Clock::time_point end)
+{
+    return std::chrono::duration<double>(end - begin).count();
+}
+
+struct Settings
+{
+    std::string manifest;
+    std::filesystem::path outputDir = ".";
+    std::string outputFormat = "ogb";
+    std::string statsFile;
+    double tolerance = 1e-4;
+    int threads = 0;
+    occ_gordon::InterpolateCurveNetworkOptions options;
+};
+
+struct NetworkJob
+{
+    std::string name;
+    std::vector<std::filesystem::path> files;
+};
+
+struct StageTiming
+{
+    std::string name;
+    double seconds;
+};
+
+struct NetworkResult
+{
+    bool ok = false;
+    std::string error;
+    std::string output;
+    size_t nProfiles = 0;
+    size_t nGuides = 0;
+    int uDegree = 0;
+    int vDegree = 0;
+    int nUPoles = 0;
+    int nVPoles = 0;
+    double readSeconds = 0.;
+    double interpolationSeconds = 0.;
+    double writeSeconds = 0.;
+    std::vector<StageTiming> stages;
+};
+
+std::vector<NetworkJob> readManifest(const std::string& manifest)
+{
+    std::ifstream in(manifest);
+    if (!in) {
+        throw std::runtime_error("Cannot read manifest " + manifest);
+    }
+
+    const std::filesystem::path baseDir = std::filesystem::path(manifest).parent_path();
+
+    std::vector<NetworkJob> jobs;
+    std::string line;
+    for (int lineNumber = 1; std::getline(in, line); ++lineNumber) {
+        std::istringstream stream(line);
+        NetworkJob job;
+        if (!(stream >> job.name) || job.name[0] == '#') {
+            continue;
+        }
+
+        std::string file;
+        while (stream >> file) {
+            std::filesystem::path path(file);
+            job.files.push_back(path.is_absolute() ? path : baseDir / path);
+        }
+
+        if (job.files.empty() || job.files.size() > 2) {
+            throw std::runtime_error(manifest + ":" + std::to_string(lineNumber) +
+                                     ": expected a name and either profiles and guides or one binary network file");
+        }
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+occ_gordon::CurveNetwork readNetwork(const NetworkJob& job)
+{
+    if (job.files.size() == 1) {
+        return occ_gordon::read_binary_curve_network(job.files[0].string());
+    }
+
+    return occ_gordon::read_curve_network(job.files[0].string(), job.files[1].string());
+}
+
+void writeSurface(const Handle(Geom_BSplineSurface)& surface, const std::string& path, const std::string& format)
+{
+    if (format == "brep") {
+        if (!BRepTools::Write(BRepBuilderAPI_MakeFace(surface, Precision::Confusion()), path.c_str())) {
+            throw std::runtime_error("Cannot write " + path);
+        }
+    }
+    else {
+        occ_gordon::write_binary_surface(path, surface);
+    }
+}
+
+NetworkResult processNetwork(const NetworkJob& job, const Settings& settings, int nThreadsPerNetwork)
+{
+    NetworkResult result;
+    try {
+        Clock::time_point begin = Clock::now();
+        occ_gordon::CurveNetwork network = readNetwork(job);
+        result.nProfiles = network.profiles.size();
+        result.nGuides = network.guides.size();
+        result.readSeconds = seconds(begin, Clock::now());
+
+        // the stage timings are derived from the progress reports
+        Clock::time_point stageBegin = Clock::now();
+        auto progress = [&result, &stageBegin](double, const std::string& stage) {
+            if (!result.stages.empty() && result.stages.back().name == stage) {
+                return;
+            }
+            Clock::time_point now = Clock::now();
+            if (!result.stages.empty()) {
+                result.stages.back().seconds = seconds(stageBegin, now);
+            }
+            result.stages.push_back({stage, 0.});
+            stageBegin = now;
+        };
+
+        occ_gordon::InterpolateCurveNetworkOptions options = settings.options;
+        options.threads = nThreadsPerNetwork;
+
+        begin = Clock::now();
+        Handle(Geom_BSplineSurface) surface = occ_gordon::interpolate_curve_network(
+            network.profiles, network.guides, settings.tolerance, options, progress, occ_gordon::CancellationToken());
+        Clock::time_point end = Clock::now();
+        result.interpolationSeconds = seconds(begin, end);
+        if (!result.stages.empty()) {
+            result.stages.back().seconds = seconds(stageBegin, end);
+        }
+
+        result.uDegree = surface->UDegree();
+        result.vDegree = surface->VDegree();
+        result.nUPoles = surface->NbUPoles();
+        result.nVPoles = surface->NbVPoles();
+
+        begin = Clock::now();
+        result.output = (settings.outputDir / (job.name + "." + settings.outputFormat)).string();
+        writeSurface(surface, result.output, settings.outputFormat);
+        result.writeSeconds = seconds(begin, Clock::now());
+
+        result.ok = true;
+    }
+    catch (const std::exception& err) {
+        result.error = err.what();
+    }
+    return result;
+}
+
+std::string jsonString(const std::string& value)
+{
+    std::string result = "\"";
+    for (char c : value) {
+        switch (c) {
+        case '"':
+            result += "\\\"";
+            break;
+        case '\\':
+            result += "\\\\";
+            break;
+        case '\n':
+            result += "\\n";
+            break;
+        case '\t':
+            result += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buffer[8];
+                std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                result += buffer;
+            }
+            else {
+                result += c;
+            }
+        }
+    }
+    return result + "\"";
+}
+
+void writeJson(std::ostream& out, const std::vector<NetworkJob>& jobs, const std::vector<NetworkResult>& results,
+               int nWorkers, double totalSeconds)
+{
+    out.precision(6);
+    out << "{\n"
+        << "  \"workers\": " << nWorkers << ",\n"
+        << "  \"total_seconds\": " << totalSeconds << ",\n"
+        << "  \"networks\": [";
+
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        const NetworkResult& result = results[i];
+        out << (i == 0 ? "\n" : ",\n")
+            << "    {\n"
+            << "      \"name\": " << jsonString(jobs[i].name) << ",\n"
+            << "      \"status\": " << (result.ok ? "\"ok\"" : "\"error\"") << ",\n";
+        if (!result.ok) {
+            out << "      \"error\": " << jsonString(result.error) << ",\n";
+        }
+        else {
+            out << "      \"output\": " << jsonString(result.output) << ",\n"
+                << "      \"u_degree\": " << result.uDegree << ",\n"
+                << "      \"v_degree\": " << result.vDegree << ",\n"
+                << "      \"u_poles\": " << result.nUPoles << ",\n"
+                << "      \"v_poles\": " << result.nVPoles << ",\n";
+        }
+        out << "      \"profiles\": " << result.nProfiles << ",\n"
+            << "      \"guides\": " << result.nGuides << ",\n"
+            << "      \"read_seconds\": " << result.readSeconds << ",\n"
+            << "      \"interpolation_seconds\": " << result.interpolationSeconds << ",\n"
+            << "      \"write_seconds\": " << result.writeSeconds << ",\n"
+            << "      \"stages\": [";
+        for (size_t j = 0; j < result.stages.size(); ++j) {
+            out << (j == 0 ? "" : ", ") << "{\"name\": " << jsonString(result.stages[j].name)
+                << ", \"seconds\": " << result.stages[j].seconds << "}";
+        }
+        out << "]\n"
+            << "    }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+void printUsage()
+{
+    std::cerr << "Usage: occ_gordon [options] <manifest>\n"
+              << "\n"
+              << "Options:\n"
+              << "  --threads <n>             Number of threads, 0 uses all cores (default)\n"
+              << "  --tolerance <tol>         Intersection tolerance of the curves (default 1e-4)\n"
+              << "  --output <dir>            Directory of the result surfaces (default .)\n"
+              << "  --format <ogb|brep>       File format of the result surfaces (default ogb)\n"
+              << "  --stats <file>            Writes the JSON statistics to the file instead of stdout\n"
+              << "  --cache <dir>             Directory of the persistent surface cache\n"
+              << "  --max-control-points <n>  Maximum number of control points of the reparametrized curves\n"
+              << "  --knot-removal <tol>      Removes knots of the surfaces within the tolerance\n"
+              << "  --block-size <n>          Interpolates large networks in blocks of at most n curves per direction\n";
+}
+
+// The numeric values must be complete numbers. Otherwise, e.g. a negative
+// block size would silently become a huge unsigned number.
+double parseDouble(const std::string& option, const std::string& value)
+{
+    try {
+        size_t pos = 0;
+        const double result = std::stod(value, &pos);
+        if (pos == value.size()) {
+            return result;
+        }
+    }
+    catch (const std::exception&) {
+    }
+    throw std::invalid_argument("Invalid number for " + option + ": " + value);
+}
+
+size_t parseSize(const std::string& option, const std::string& value)
+{
+    try {
+        size_t pos = 0;
+        const unsigned long result = std::stoul(value, &pos);
+        if (pos == value.size() && value.find('-') == std::string::npos) {
+            return static_cast<size_t>(result);
+        }
+    }
+    catch (const std::exception&) {
+    }
+    throw std::invalid_argument("Invalid non-negative integer for " + option + ": " + value);
+}
+
+/// @throws std::invalid_argument, if an option has an invalid value
+bool parseArguments(int argc, char** argv, Settings& settings)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--threads" && hasValue) {
+            settings.threads = static_cast<int>(parseSize(arg, argv[++i]));
+        }
+        else if (arg == "--tolerance" && hasValue) {
+            settings.tolerance = parseDouble(arg, argv[++i]);
+            if (settings.tolerance <= 0.) {
+                throw std::invalid_argument("The tolerance must be positive");
+            }
+        }
+        else if (arg == "--output" && hasValue) {
+            settings.outputDir = argv[++i];
+        }
+        else if (arg == "--format" && hasValue) {
+            settings.outputFormat = argv[++i];
+            if (settings.outputFormat != "ogb" && settings.outputFormat != "brep") {
+                throw std::invalid_argument("Unknown output format: " + settings.outputFormat);
+            }
+        }
+        else if (arg == "--stats" && hasValue) {
+            settings.statsFile = argv[++i];
+        }
+        else if (arg == "--cache" && hasValue) {
+            settings.options.cache_directory = argv[++i];
+        }
+        else if (arg == "--max-control-points" && hasValue) {
+            settings.options.max_control_points = parseSize(arg, argv[++i]);
+        }
+        else if (arg == "--knot-removal" && hasValue) {
+            settings.options.knot_removal_tolerance = parseDouble(arg, argv[++i]);
+        }
+        else if (arg == "--block-size" && hasValue) {
+            settings.options.block_size = parseSize(arg, argv[++i]);
+        }
+        else if (settings.manifest.empty() && !arg.empty() && arg[0] != '-') {
+            settings.manifest = arg;
+        }
+        else {
+            return false;
+        }
+    }
+    return !settings.manifest.empty();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Settings settings;
+    try {
+        if (!parseArguments(argc, argv, settings)) {
+            printUsage();
+            return 2;
+        }
+    }
+    catch (const std::invalid_argument& err) {
+        std::cerr << err.what() << "\n\n";
+        printUsage();
+        return 2;
+    }
+
+    std::vector<NetworkJob> jobs;
+    try {
+        jobs = readManifest(settings.manifest);
+        std::filesystem::create_directories(settings.outputDir);
+    }
+    catch (const std::exception& err) {
+        std::cerr << err.what() << std::endl;
+        return 2;
+    }
+
+    // networks are processed concurrently, the remaining threads parallelize each network
+    const int nThreads = settings.threads > 0 ? settings.threads
+                                              : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    const int nWorkers = std::max(1, std::min(nThreads, static_cast<int>(jobs.size())));
+    const int nThreadsPerNetwork = std::max(1, nThreads / nWorkers);
+
+    std::vector<NetworkResult> results(jobs.size());
+    std::atomic<size_t> nextJob(0);
+
+    const Clock::time_point begin = Clock::now();
+    std::vector<std::thread> workers;
+    for (int i = 0; i < nWorkers; ++i) {
+        workers.emplace_back([&]() {
+            for (size_t job = nextJob++; job < jobs.size(); job = nextJob++) {
+                results[job] = processNetwork(jobs[job], settings, nThreadsPerNetwork);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    const double totalSeconds = seconds(begin, Clock::now());
+
+    if (settings.statsFile.empty()) {
+        writeJson(std::cout, jobs, results, nWorkers, totalSeconds);
+    }
+    else {
+        std::ofstream out(settings.statsFile);
+        writeJson(out, jobs, results, nWorkers, totalSeconds);
+        if (!out) {
+            std::cerr << "Cannot write " << settings.statsFile << std::endl;
+            return 1;
+        }
+    }
+
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        if (!results[i].ok) {
+            std::cerr << jobs[i].name << ": " << results[i].error << std::endl;
+        }
+    }
+
+    const bool allOk = std::all_of(results.begin(), results.end(), [](const NetworkResult& result) {
+        return result.ok;
+    });
+    return allOk ? 0 : 1;
+}
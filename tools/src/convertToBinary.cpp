@@ -0,0 +1,79 @@
+/*
+* SPDX-License-Identifier: Apache-2.0
+* SPDX-FileCopyrightText: 2024 German Aerospace Center (DLR)
+*/
+
+/*
+ * Converts curve networks from BRep files into the binary geometry format.
+ *
+ *     occ_gordon-convert <profiles.brep> <guides.brep> <network.ogb>
+ *     occ_gordon-convert --corpus <path/to/CurveNetworks>
+ *
+ * The second form converts every subdirectory containing a profiles.brep
+ * and a guides.brep into a network.ogb in the same directory.
+ */
+
+#include <occ_gordon/io.h>
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace
+{
+
+void convert(const std::string& profilesFile, const std::string& guidesFile, const std::string& outputFile)
+{
+    const occ_gordon::CurveNetwork network = occ_gordon::read_curve_network(profilesFile, guidesFile);
+    occ_gordon::write_binary_curve_network(outputFile, network.profiles, network.guides);
+    std::cout << outputFile << std::endl;
+}
+
+int convertCorpus(const std::filesystem::path& corpus)
+{
+    int nFailed = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(corpus)) {
+        const std::filesystem::path profiles = entry.path() / "profiles.brep";
+        const std::filesystem::path guides = entry.path() / "guides.brep";
+        if (!entry.is_directory() || !std::filesystem::exists(profiles) || !std::filesystem::exists(guides)) {
+            continue;
+        }
+
+        try {
+            convert(profiles.string(), guides.string(), (entry.path() / "network.ogb").string());
+        }
+        catch (const std::exception& err) {
+            std::cerr << entry.path().string() << ": " << err.what() << std::endl;
+            nFailed++;
+        }
+    }
+    return nFailed == 0 ? 0 : 1;
+}
+
+void printUsage()
+{
+    std::cerr << "Usage: occ_gordon-convert <profiles.brep> <guides.brep> <network.ogb>" << std::endl
+              << "       occ_gordon-convert --corpus <path/to/CurveNetworks>" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    try {
+        if (argc == 3 && std::string(argv[1]) == "--corpus") {
+            return convertCorpus(argv[2]);
+        }
+        if (argc == 4) {
+            convert(argv[1], argv[2], argv[3]);
+            return 0;
+        }
+    }
+    catch (const std::exception& err) {
+        std::cerr << err.what() << std::endl;
+        return 1;
+    }
+
+    printUsage();
+    return 2;
+}